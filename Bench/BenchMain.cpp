@@ -0,0 +1,63 @@
+/*
+ * BenchMain.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// Host benchmark program, runs the workload matrix on the simulator and writes
+// the CSV results to stdout:
+//
+//   gcc -std=c99 -O2 -DTIVA_SIM -I. -c Util/Format.c
+//   g++ -std=c++14 -O2 -DTIVA_SIM -DPRINT_STATS -I. -ISim -ISim/driverlib -o bench
+//       Bench/*.cpp Sim/*.cpp Peripherals/*.cpp Util/*.cpp Format.o
+//   ./bench > bench.csv
+//
+// On the target, construct a Benchmark in main and call run() (see main.cpp, BENCHMARK)
+
+#ifdef TIVA_SIM
+
+#include <stdio.h>
+#include <Bench/Benchmark.hpp>
+
+/**
+ * Print to the host standard output
+ */
+class StdoutPrint:public Print{
+    protected:
+        PrintStatus write(const char* txt, int n, uint8_t flags) override{
+            (void)flags;
+            if(n < 0){
+                fputs(txt, stdout);
+            }else{
+                fwrite(txt, 1, n, stdout);
+            }
+            return _PRINT_STATUS_OK;
+        }
+        PrintStatus write(uint8_t c, uint8_t flags) override{
+            (void)flags;
+            putchar(c);
+            return _PRINT_STATUS_OK;
+        }
+};
+
+int main(){
+    Sim::reset();
+    initSystemClock();
+    static SimI2CMemory memory;
+    Sim::i2cAttach(I2C_I2C0, BENCH_I2C_ADDRESS, &memory);
+    static SimSPIFlash flash;
+    Sim::spiAttach(SPI_SSI3, &flash);
+
+    StdoutPrint out;
+    SerialPort serial(115200, SERIALPORT_UART0);
+    serial.setFifo(true, SERIAL_FIFO_1_8, SERIAL_FIFO_1_2);
+
+    Benchmark bench(out, serial, 115200, I2C_I2C0);
+    bench.setFlash(SPI_SSI3);
+    bench.run();
+    return Sim::faults() == 0 ? 0 : 1;
+}
+
+#endif
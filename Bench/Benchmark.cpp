@@ -0,0 +1,632 @@
+/*
+ * Benchmark.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Bench/Benchmark.hpp>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/I2CDeviceMaps.hpp>
+#include <Peripherals/SerialPortT.hpp>
+#include <Peripherals/I2CMasterT.hpp>
+#include <Util/PrintT.hpp>
+
+#ifdef TIVA_SIM
+#include <chrono>
+#define BENCH_PLATFORM  "sim"
+#define BENCH_FORMAT_REPEAT 10000   //Calls per format run, host clock resolution
+#define BENCH_FR_COUNTED        true
+#define BENCH_FR_READS(uart)    Sim::uartStatusReads(uart)
+#else
+#define BENCH_PLATFORM  "target"
+#define BENCH_FORMAT_REPEAT 1
+#define BENCH_FR_COUNTED        false   //UARTFR reads aren't counted on the target
+#define BENCH_FR_READS(uart)    0
+#endif
+
+#ifdef PRINT_STATS
+#define BENCH_CALLS()   (Print::writeCalls)
+#else
+#define BENCH_CALLS()   0
+#endif
+
+static const uint32_t I2C_SPEEDS[] = {100000, 400000, 1000000, 3330000};
+static const uint8_t I2C_LENGTHS[] = {1, 2, 8, 16, 32, BENCH_I2C_MAX_LEN};
+static const uint8_t LINE_LENGTHS[] = {8, 32, BENCH_I2C_MAX_LEN};
+static const uint32_t FLASH_RATES[] = {15000000, 30000000, 60000000};
+static const uint8_t FLASH_LANES[] = {SPI_LANES_1, SPI_LANES_2, SPI_LANES_4};
+static const char* const FLASH_READ_CASES[] = {"read_1lane", "read_2lane", "read_4lane"};
+static const uint8_t FLASH_PROGRAM_LANES[] = {SPI_LANES_1, SPI_LANES_4};
+static const char* const FLASH_PROGRAM_CASES[] = {"program_1lane", "program_4lane"};
+static const uint8_t FIFO_LENGTHS[] = {16, BENCH_I2C_MAX_LEN};
+static const char* const FIFO_CASES[] = {"write_16", "write_64", "printf_mixed"};
+
+static const char* const PRINT_CASES[] = {"printf_int", "printf_hex", "printf_bin", "printf_float",
+                                          "printf_str", "printf_mixed", "print_fmt_mixed", "println"};
+#define PRINT_CASES_N   (sizeof(PRINT_CASES) / sizeof(PRINT_CASES[0]))
+
+#define BENCH_FORMAT_VIRTUAL    0   //format group param: Print, virtual writes
+#define BENCH_FORMAT_STATIC     1   //PrintT, static dispatch
+#define BENCH_FORMAT_ADAPTER    2   //PrintAdapter over the PrintT writer
+
+/**
+ * Length of a write
+ * @param txt is the text written
+ * @param n is the write length, if n < 0 until '\0'
+ * @return quantity of bytes
+ */
+static inline uint32_t writeLength(const char* txt, int n){
+    if(n < 0){
+        n = 0;
+        while(txt[n]) n++;
+    }
+    return n;
+}
+
+/**
+ * Print that only counts the bytes written, gives the output size of a case
+ */
+class ByteCounter:public Print{
+    public:
+        ByteCounter(): bytes(0){}
+        uint32_t bytes;
+
+    protected:
+        PrintStatus write(const char* txt, int n, uint8_t flags) override{
+            (void)flags;
+            bytes += writeLength(txt, n);
+            return _PRINT_STATUS_OK;
+        }
+        PrintStatus write(uint8_t c, uint8_t flags) override{
+            (void)c; (void)flags;
+            bytes++;
+            return _PRINT_STATUS_OK;
+        }
+};
+
+/**
+ * ByteCounter with static dispatch (PrintT), for the format group
+ */
+class ByteCounterT:public PrintT<ByteCounterT>{
+    friend class PrintT<ByteCounterT>;
+    public:
+        ByteCounterT(): bytes(0){}
+        uint32_t bytes;
+
+    private:
+        inline PrintStatus write(const char* txt, int n, uint8_t flags){
+            (void)flags;
+            bytes += writeLength(txt, n);
+            return _PRINT_STATUS_OK;
+        }
+        inline PrintStatus write(uint8_t c, uint8_t flags){
+            (void)c; (void)flags;
+            bytes++;
+            return _PRINT_STATUS_OK;
+        }
+};
+
+#ifdef TIVA_SIM
+/**
+ * Host clock for CPU only work, which the simulator clock doesn't count
+ * @return host time in system clock periods (wraps like CYCCNT)
+ */
+static uint32_t hostCycles(){
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (uint32_t)(ns * (systemClock() / 1000000) / 1000);
+}
+#endif
+
+/**
+ * Print workload, same output on Print and PrintT writers
+ * @param p is the output
+ * @param i is the case number (PRINT_CASES index)
+ * @return print result
+ */
+template<typename P>
+static PrintStatus printCase(P& p, uint8_t i){
+    switch(i){
+        case 0: return p.printf("%d\r\n", -1234567);
+        case 1: return p.printf("%x\r\n", 0x1A2B3C);
+        case 2: return p.printf("%b\r\n", 0xA5);
+        case 3: return p.printf("%3f\r\n", 3.14159f);
+        case 4: return p.printf("%s\r\n", "benchmark string");
+        case 5: return p.printf("T=%2f id=%ux n=%d %s\r\n", 21.5f, 0xBEEFu, -42, "ok");
+        case 6: return p.print(PRINT_FMT("T=%2f id=%ux n=%d %s\r\n"), 21.5f, 0xBEEFu, -42, "ok");
+        default: return p.println("benchmark line");
+    }
+}
+
+/**
+ * Template group printf workload, same output on Print and PrintT writers
+ * @param p is the output
+ * @return print result
+ */
+template<typename P>
+static PrintStatus templateCase(P& p){
+    return p.printf("T=%2f id=%ux n=%d %s\r\n", 21.5f, 0xBEEFu, -42, "ok");
+}
+
+/**
+ * Template group I2C workload: register pointer and BENCH_TEMPLATE_LEN bytes
+ * written, then read back after a repeated START
+ * @param bus is an I2CMaster or I2CMasterT, BENCH_I2C_ADDRESS selected
+ * @param write selects the write (true) or the readFrom (false)
+ * @return transfer result
+ */
+template<typename Bus>
+static PrintStatus templateI2CCase(Bus& bus, bool write){
+    uint8_t buf[BENCH_TEMPLATE_LEN + 1];
+    if(!write) return bus.readFrom(0x00, buf, BENCH_TEMPLATE_LEN);
+    buf[0] = 0x00;
+    for(uint8_t i = 0; i < BENCH_TEMPLATE_LEN; i++) buf[i + 1] = i;
+    return bus.print((const char*)buf, BENCH_TEMPLATE_LEN + 1);
+}
+
+/**
+ * Benchmark constructor
+ * @param out receives the CSV results (may be the measured serial port)
+ * @param port is the measured serial port, already opened
+ * @param bauds is the serial port baud rate
+ * @param i2c is the I2C module for the I2C cases, BENCH_I2C_ADDRESS must answer on it
+ */
+Benchmark::Benchmark(Print& out, SerialPort& port, uint32_t bauds, uint8_t i2c):report(out), serial(port){
+    baud = bauds;
+    i2cx = i2c;
+    ssix = BENCH_FLASH_NONE;
+    hostClock = false;
+    enableCycleCounter();
+    clear();
+}
+
+/**
+ * Run the whole workload matrix, header line first
+ * With PROBE_STATS defined, the probe table of the whole run is printed last
+ * The serial port is left in buffered TX and RX modes
+ */
+void Benchmark::run(){
+#ifdef PROBE_STATS
+    Probe::reset();
+#endif
+    header();
+    runPrint(SERIAL_TX_BLOCKING);
+    runPrint(SERIAL_TX_BUFFERED);
+    runFifo();
+    for(uint8_t i = 0; i < sizeof(LINE_LENGTHS); i++){
+        runReadline(LINE_LENGTHS[i]);
+    }
+    for(uint8_t i = 0; i < sizeof(I2C_SPEEDS) / sizeof(I2C_SPEEDS[0]); i++){
+        runI2C(I2C_SPEEDS[i]);
+    }
+    for(uint8_t i = 0; i < sizeof(FLASH_RATES) / sizeof(FLASH_RATES[0]) && ssix != BENCH_FLASH_NONE; i++){
+        runFlash(FLASH_RATES[i]);
+    }
+    runTemplate();
+    runFormat();
+#ifdef PROBE_STATS
+    Probe::dump(report);
+#endif
+}
+
+/**
+ * printf, print(PRINT_FMT) and println cases on the serial port
+ * @param txMode is the serial port TX mode to measure (SERIAL_TX_BLOCKING or SERIAL_TX_BUFFERED)
+ */
+void Benchmark::runPrint(uint8_t txMode){
+    serial.setTxMode(txMode);
+    uint32_t frame = 10 * (systemClock() / baud);  //Start, 8 data and stop bits
+
+    for(uint8_t i = 0; i < PRINT_CASES_N; i++){
+        ByteCounter counter;
+        printCase(counter, i);
+
+        PrintStatus status = _PRINT_STATUS_OK;
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = printCase(serial, i);
+            end();
+        }
+        result("print", PRINT_CASES[i], txMode, counter.bytes * BENCH_RUNS, counter.bytes * frame * BENCH_RUNS, status);
+    }
+}
+
+/**
+ * Blocking writes on BENCH_FIFO_UART with the UART FIFOs disabled (1 byte
+ * holding register) and enabled: the cycles and UARTFR polls per byte of each
+ * mode. Fixed strings that fit the TX FIFO or not, and the mixed printf
+ */
+void Benchmark::runFifo(){
+    char text[BENCH_I2C_MAX_LEN];
+    for(uint8_t i = 0; i < sizeof(text); i++) text[i] = 'a' + i % 26;
+    ByteCounter counter;
+    printCase(counter, 5);
+    uint32_t frame = 10 * (systemClock() / baud);
+
+    SerialPort port(baud, BENCH_FIFO_UART);
+    for(uint8_t fifo = 0; fifo < 2; fifo++){
+        port.setFifo(fifo != 0, SERIAL_FIFO_1_8, SERIAL_FIFO_1_2);
+        for(uint8_t c = 0; c < 3; c++){
+            uint32_t len = c < sizeof(FIFO_LENGTHS) ? FIFO_LENGTHS[c] : counter.bytes;
+            PrintStatus status = _PRINT_STATUS_OK;
+            clear();
+            pollsCounted = BENCH_FR_COUNTED;
+            for(uint8_t r = 0; r < BENCH_RUNS; r++){
+                port.flush();
+                uint32_t reads = BENCH_FR_READS(BENCH_FIFO_UART);
+                begin();
+                status = c < sizeof(FIFO_LENGTHS) ? port.print(text, len) : printCase(port, 5);
+                end();
+                polls += BENCH_FR_READS(BENCH_FIFO_UART) - reads;
+            }
+            result("fifo", FIFO_CASES[c], fifo, len * BENCH_RUNS, len * frame * BENCH_RUNS, status);
+        }
+    }
+    port.flush();
+    port.close();
+}
+
+/**
+ * readline of a scripted line sent through the UART loopback (buffered TX and
+ * RX modes), timed from the first byte queued until readline returns the line
+ * @param len is the line length without "\r\n" (up to BENCH_I2C_MAX_LEN)
+ */
+void Benchmark::runReadline(uint8_t len){
+    char script[BENCH_I2C_MAX_LEN + 2];
+    char line[BENCH_I2C_MAX_LEN + 3];
+    if(len > BENCH_I2C_MAX_LEN) len = BENCH_I2C_MAX_LEN;
+    for(uint8_t i = 0; i < len; i++) script[i] = 'a' + i % 26;
+    script[len] = '\r';
+    script[len + 1] = '\n';
+    uint32_t frame = 10 * (systemClock() / baud);
+
+    serial.setTxMode(SERIAL_TX_BUFFERED);
+    serial.setRxMode(SERIAL_RX_BUFFERED);
+    serial.setLoopback(true);
+    serial.flush();
+    char c;
+    while(serial.tryRead(c));   //Drop stale bytes
+
+    PrintStatus status = _PRINT_STATUS_OK;
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS && status == _PRINT_STATUS_OK; r++){
+        begin();
+        serial.print(script, len + 2);
+        char* got = serial.readline(line, sizeof(line), false, Timebase::deadline(BENCH_WAIT_US));
+        end();
+        if(got == 0){
+            status = _PRINT_STATUS_ERROR;   //Loopback bytes lost
+            break;
+        }
+        for(uint8_t i = 0; i <= len; i++){
+            if(line[i] != (i < len ? script[i] : '\0')) status = _PRINT_STATUS_ERROR;
+        }
+    }
+    serial.setLoopback(false);
+    result("serial", "readline", len, (len + 2) * BENCH_RUNS, (len + 2) * frame * BENCH_RUNS, status);
+}
+
+/**
+ * write, read and readFrom cases on the I2C memory device at BENCH_I2C_ADDRESS,
+ * and a register map sample (I2CDevice readAll burst against a read per register)
+ * @param speed is the bus frequency (I2CMaster supported speed)
+ */
+void Benchmark::runI2C(uint32_t speed){
+    I2CMaster bus(speed, i2cx);
+    bus.setAddress(BENCH_I2C_ADDRESS);
+    uint8_t buf[BENCH_I2C_MAX_LEN + 1];
+    uint32_t scl = systemClock() / speed;   //Nominal SCL period
+
+    for(uint8_t i = 0; i < sizeof(I2C_LENGTHS); i++){
+        uint8_t len = I2C_LENGTHS[i];
+        PrintStatus status = _PRINT_STATUS_OK;
+
+        //Register pointer, then len bytes: START, 2 + len bytes, STOP
+        buf[0] = 0x00;
+        for(uint8_t j = 0; j < len; j++) buf[j + 1] = j;
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = bus.print((const char*)buf, len + 1);
+            end();
+        }
+        result("i2c", "write", speed, len * BENCH_RUNS, (9 * (len + 2) + 2) * scl * BENCH_RUNS, status);
+
+        //START, 1 + len bytes, STOP
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = bus.read(buf, len);
+            end();
+        }
+        result("i2c", "read", speed, len * BENCH_RUNS, (9 * (len + 1) + 2) * scl * BENCH_RUNS, status);
+
+        //START, address and register, repeated START, 1 + len bytes, STOP
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = bus.readFrom(0x00, buf, len);
+            end();
+        }
+        result("i2c", "readFrom", speed, len * BENCH_RUNS, (9 * (len + 3) + 3) * scl * BENCH_RUNS, status);
+    }
+
+    //MPU-6050 sample, 7 words: one readFrom of 14 bytes, or 7 of 2 bytes
+    using namespace Mpu6050;
+    I2CDevice<> device(bus, BENCH_I2C_ADDRESS);
+    uint32_t sample[7];
+    PrintStatus status = _PRINT_STATUS_OK;
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS; r++){
+        begin();
+        status = device.readAll<AccelX, AccelY, AccelZ, Temp, GyroX, GyroY, GyroZ>(sample);
+        end();
+    }
+    result("i2c", "regmap_burst", speed, 14 * BENCH_RUNS, (9 * (14 + 3) + 3) * scl * BENCH_RUNS, status);
+
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS; r++){
+        begin();
+        status = device.read<AccelX>(sample[0]);
+        if(status == I2C_READ_OK) status = device.read<AccelY>(sample[1]);
+        if(status == I2C_READ_OK) status = device.read<AccelZ>(sample[2]);
+        if(status == I2C_READ_OK) status = device.read<Temp>(sample[3]);
+        if(status == I2C_READ_OK) status = device.read<GyroX>(sample[4]);
+        if(status == I2C_READ_OK) status = device.read<GyroY>(sample[5]);
+        if(status == I2C_READ_OK) status = device.read<GyroZ>(sample[6]);
+        end();
+    }
+    result("i2c", "regmap_single", speed, 14 * BENCH_RUNS, 7 * (9 * (2 + 3) + 3) * scl * BENCH_RUNS, status);
+}
+
+/**
+ * Enable the flash group
+ * @param ssi is the SSI module of the SPI-NOR flash (chip select on its FSS
+ *      pin, quad enabled), BENCH_FLASH_NONE to disable the group
+ */
+void Benchmark::setFlash(uint8_t ssi){
+    ssix = ssi;
+}
+
+/**
+ * Flash read on 1, 2 and 4 data lanes (fast read commands, BENCH_FLASH_LEN
+ * bytes), and page program on 1 and 4 lanes (erased sector first)
+ * On the target, the 4 lane read is also streamed by the uDMA (read_dma_4lane)
+ * @param bitRate is the SSInClk frequency
+ */
+void Benchmark::runFlash(uint32_t bitRate){
+    static uint8_t buf[BENCH_FLASH_LEN];
+    SPIMaster spi(bitRate, ssix);
+    SPIFlash flash(spi);
+    uint32_t bit = systemClock() / spi.getBitRate();    //Cycles per SSInClk
+
+    for(uint8_t i = 0; i < sizeof(FLASH_LANES); i++){
+        uint8_t lanes = FLASH_LANES[i];
+        flash.setLanes(lanes);
+        PrintStatus status = _PRINT_STATUS_OK;
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = flash.read(BENCH_FLASH_ADDRESS, buf, BENCH_FLASH_LEN);
+            end();
+        }
+        //Command, address and dummy bytes on 1 lane, data on lanes
+        uint32_t bus = (8 * (4 + SPI_FLASH_DUMMY_BYTES) + 8 * BENCH_FLASH_LEN / lanes) * bit;
+        result("flash", FLASH_READ_CASES[i], bitRate, BENCH_FLASH_LEN * BENCH_RUNS, bus * BENCH_RUNS, status);
+    }
+
+#ifndef TIVA_SIM    //The simulator makes no uDMA transfers
+    flash.setLanes(SPI_LANES_4);
+    PrintStatus dmaStatus = _PRINT_STATUS_OK;
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS; r++){
+        begin();
+        dmaStatus = flash.readAsync(BENCH_FLASH_ADDRESS, buf, BENCH_FLASH_LEN);
+        while(spi.busy()) BOARD_WAIT();
+        end();
+    }
+    result("flash", "read_dma_4lane", bitRate, BENCH_FLASH_LEN * BENCH_RUNS,
+           (8 * (4 + SPI_FLASH_DUMMY_BYTES) + 2 * BENCH_FLASH_LEN) * bit * BENCH_RUNS, dmaStatus);
+#endif
+
+    //Write enable, command and address, 1 page, status poll (program time not counted)
+    for(uint16_t i = 0; i < SPI_FLASH_PAGE; i++) buf[i] = (uint8_t)i;
+    for(uint8_t i = 0; i < sizeof(FLASH_PROGRAM_LANES); i++){
+        uint8_t lanes = FLASH_PROGRAM_LANES[i];
+        flash.setLanes(lanes);
+        PrintStatus status = flash.erase(BENCH_FLASH_ADDRESS);
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS && status == _PRINT_STATUS_OK; r++){
+            begin();
+            status = flash.program(BENCH_FLASH_ADDRESS + r * SPI_FLASH_PAGE, buf, SPI_FLASH_PAGE);
+            end();
+        }
+        uint32_t bus = (8 * (1 + 4 + 2) + 8 * SPI_FLASH_PAGE / lanes) * bit;
+        result("flash", FLASH_PROGRAM_CASES[i], bitRate, SPI_FLASH_PAGE * BENCH_RUNS, bus * BENCH_RUNS, status);
+    }
+}
+
+/**
+ * Runtime drivers against their compile-time variants: printf on
+ * BENCH_TEMPLATE_UART (blocking TX, FIFO enabled), and I2C write and readFrom
+ * at 400 kHz on BENCH_TEMPLATE_I2C if it is the I2C cases module
+ */
+void Benchmark::runTemplate(){
+    uint32_t frame = 10 * (systemClock() / baud);
+    ByteCounter counter;
+    templateCase(counter);
+    uint32_t bytes = counter.bytes * BENCH_RUNS;
+    PrintStatus status = _PRINT_STATUS_OK;
+
+    SerialPort port(baud, BENCH_TEMPLATE_UART);
+    port.setFifo(true);
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS; r++){
+        port.flush();
+        begin();
+        status = templateCase(port);
+        end();
+    }
+    port.flush();
+    port.close();
+    result("template", "printf_runtime", baud, bytes, counter.bytes * frame * BENCH_RUNS, status);
+
+    SerialPortT<BENCH_TEMPLATE_UART> portT(baud);
+    portT.setFifo(true);
+    clear();
+    for(uint8_t r = 0; r < BENCH_RUNS; r++){
+        portT.flush();
+        begin();
+        status = templateCase(portT);
+        end();
+    }
+    portT.close();
+    result("template", "printf_template", baud, bytes, counter.bytes * frame * BENCH_RUNS, status);
+
+    if(i2cx != BENCH_TEMPLATE_I2C) return;
+    const uint32_t speed = 400000;
+    uint32_t scl = systemClock() / speed;
+    uint32_t writeBus = (9 * (BENCH_TEMPLATE_LEN + 2) + 2) * scl * BENCH_RUNS;
+    uint32_t readBus = (9 * (BENCH_TEMPLATE_LEN + 3) + 3) * scl * BENCH_RUNS;
+    const char* const names[] = {"write_runtime", "readFrom_runtime", "write_template", "readFrom_template"};
+
+    for(uint8_t c = 0; c < 2; c++){
+        I2CMaster bus(speed, BENCH_TEMPLATE_I2C);
+        bus.setAddress(BENCH_I2C_ADDRESS);
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = templateI2CCase(bus, c == 0);
+            end();
+        }
+        bus.close();
+        result("template", names[c], speed, BENCH_TEMPLATE_LEN * BENCH_RUNS, c == 0 ? writeBus : readBus, status);
+    }
+    for(uint8_t c = 0; c < 2; c++){
+        I2CMasterT<BENCH_TEMPLATE_I2C> bus(speed);
+        bus.setAddress(BENCH_I2C_ADDRESS);
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            status = templateI2CCase(bus, c == 0);
+            end();
+        }
+        bus.close();
+        result("template", names[c + 2], speed, BENCH_TEMPLATE_LEN * BENCH_RUNS, c == 0 ? writeBus : readBus, status);
+    }
+}
+
+/**
+ * Print cases without output device: a Print writer (virtual writes), a PrintT
+ * writer (static dispatch) and a PrintAdapter over the PrintT writer (Print
+ * formatting, one virtual call per write), the formatting cost per byte.
+ * On the simulator every run makes BENCH_FORMAT_REPEAT calls timed with the host clock
+ */
+void Benchmark::runFormat(){
+    hostClock = true;
+    for(uint8_t i = 0; i < PRINT_CASES_N; i++){
+        ByteCounter counter;
+        ByteCounterT counterT;
+        PrintAdapter<ByteCounterT> adapter(counterT);
+        PrintStatus status = _PRINT_STATUS_OK;
+
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            for(uint16_t k = 0; k < BENCH_FORMAT_REPEAT; k++) status = printCase(counter, i);
+            end();
+        }
+        result("format", PRINT_CASES[i], BENCH_FORMAT_VIRTUAL, counter.bytes, 0, status);
+
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            for(uint16_t k = 0; k < BENCH_FORMAT_REPEAT; k++) status = printCase(counterT, i);
+            end();
+        }
+        result("format", PRINT_CASES[i], BENCH_FORMAT_STATIC, counterT.bytes, 0, status);
+
+        counterT.bytes = 0;
+        clear();
+        for(uint8_t r = 0; r < BENCH_RUNS; r++){
+            begin();
+            for(uint16_t k = 0; k < BENCH_FORMAT_REPEAT; k++) status = printCase(adapter, i);
+            end();
+        }
+        result("format", PRINT_CASES[i], BENCH_FORMAT_ADAPTER, counterT.bytes, 0, status);
+    }
+    hostClock = false;
+}
+
+/**
+ * Private: print the CSV header line
+ */
+void Benchmark::header(){
+    report.println("group,case,param,runs,bytes,cycles,cycles_per_byte,mbytes_per_s,calls_per_byte,polls_per_byte,bus_cycles,idle_cycles,status,platform");
+}
+
+/**
+ * Private: start timing a run, the serial port is emptied first so
+ * report bytes aren't sent during the run
+ */
+void Benchmark::begin(){
+    serial.flush();
+    startCalls = BENCH_CALLS();
+    startCycles = clock();
+}
+
+/**
+ * Private: stop timing a run, accumulating it in the current case
+ */
+void Benchmark::end(){
+    uint32_t now = clock();
+    cycles += now - startCycles;
+    calls += BENCH_CALLS() - startCalls;
+}
+
+/**
+ * Private: cycle count of the runs, CYCLE_COUNT or the host clock (simulator format group)
+ */
+uint32_t Benchmark::clock(){
+#ifdef TIVA_SIM
+    if(hostClock) return hostCycles();
+#endif
+    return CYCLE_COUNT();
+}
+
+/**
+ * Private: reset the case accumulators
+ */
+void Benchmark::clear(){
+    cycles = 0;
+    calls = 0;
+    polls = 0;
+    pollsCounted = false;
+}
+
+/**
+ * Private: print the CSV line of the current case
+ *
+ * @param group is the workload group
+ * @param name is the case name
+ * @param param is the case parameter
+ * @param bytes is the quantity of bytes of all the runs
+ * @param busCycles is the minimum wire time of the bytes
+ * @param status is the last run result
+ */
+void Benchmark::result(const char* group, const char* name, uint32_t param, uint32_t bytes, uint32_t busCycles, PrintStatus status){
+    float perByte = bytes ? (float)cycles / bytes : 0.0f;
+    float mbps = cycles ? (float)bytes * (systemClock() / 1000000) / cycles : 0.0f;
+    uint32_t idle = cycles > busCycles ? cycles - busCycles : 0;
+
+    report.printf("%s,%s,%u,%d,%u,%u,%2f,%2f,", group, name, param, BENCH_RUNS, bytes, cycles, perByte, mbps);
+#ifdef PRINT_STATS
+    report.printf("%2f", bytes ? (float)calls / bytes : 0.0f);
+#endif
+    report.print(",");
+    if(pollsCounted) report.printf("%2f", bytes ? (float)polls / bytes : 0.0f);
+    report.printf(",%u,%u,%d,%s\r\n", busCycles, idle, status, BENCH_PLATFORM);
+}
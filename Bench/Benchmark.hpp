@@ -0,0 +1,111 @@
+/*
+ * Benchmark.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef BENCH_BENCHMARK_HPP_
+#define BENCH_BENCHMARK_HPP_
+
+#include <stdint.h>
+#include <Util/Print.hpp>
+#include <Peripherals/SerialPort.hpp>
+#include <Peripherals/I2CMaster.hpp>
+#include <Peripherals/SPIFlash.hpp>
+
+// Workload matrix for the Print, SerialPort, I2CMaster and SPI flash hot paths, timed with the
+// DWT cycle counter (CYCLE_COUNT). Runs on the target and on the host simulator
+// (TIVA_SIM, where CYCCNT is the virtual clock), see Bench/BenchMain.cpp.
+// Build with PRINT_STATS defined to count virtual write calls, and with PROBE_STATS
+// to append the probe table of the run (see Util/Probe.hpp).
+// The simulator clock counts register accesses, waits and bus time only, so
+// CPU only work (formatting, ring buffers) is close to 0 cycles there: compare
+// calls_per_byte, bus and idle times between builds, and cycles on the target.
+// The format group is the exception, see below.
+//
+// Results are CSV lines, one per case, preceded by a header line:
+//   group,case,param,runs,bytes,cycles,cycles_per_byte,mbytes_per_s,calls_per_byte,polls_per_byte,bus_cycles,idle_cycles,status,platform
+//  - param: tx mode (print), UART FIFOs (fifo: 0 disabled, 1 enabled), line length (readline),
+//    bus speed in Hz (i2c, template i2c cases), bit rate in Hz (flash), baud rate
+//    (template serial cases) or Print dispatch (format: 0 Print, 1 PrintT, 2 PrintAdapter over PrintT)
+//  - bytes, cycles, bus_cycles and idle_cycles: totals of all the runs
+//  - mbytes_per_s: throughput at the system clock (10^6 bytes per second)
+//  - bus_cycles: minimum wire time of the bytes (UART frames or I2C bits at the nominal speed)
+//  - readline: the line goes out and back through the UART loopback, timed from
+//    print until readline returns (wire time included)
+//  - idle_cycles: cycles - bus_cycles (0 if negative)
+//  - calls_per_byte: virtual write calls per byte (empty without PRINT_STATS),
+//    PrintT writes are direct calls and aren't counted
+//  - polls_per_byte: UARTFR reads per byte (fifo group on the simulator, else empty)
+//  - status: last run result (0 OK)
+// If the report goes to the measured serial port, the print workload output is
+// interleaved: keep the header and the lines starting with print, fifo, serial, i2c, flash, template or format.
+// The fifo group runs blocking writes on BENCH_FIFO_UART (not the report port)
+// with the UART FIFOs disabled (1 byte holding register) and enabled.
+// The flash group runs only after setFlash: SPI-NOR flash on the SSI FSS pin,
+// its sector at BENCH_FLASH_ADDRESS is erased and programmed. Its read cases are
+// polled: 2 register accesses per byte plus a status read per half FIFO, more
+// than the 4 system clocks per byte of 4 lanes at 60 MHz (idle_cycles there is
+// CPU time, read_dma_4lane runs at the bus rate, target only).
+// The template group runs the same printf and I2C transfers through the runtime
+// drivers and their compile-time variants (SerialPortT, I2CMasterT), blocking
+// modes, on BENCH_TEMPLATE_UART (not the report port) and BENCH_TEMPLATE_I2C.
+// The format group runs the print cases on byte counting writers, no device:
+// cycles_per_byte is the formatting cost of each Print dispatch. On the
+// simulator it is timed with the host clock (cycles are host time in system
+// clock periods, BENCH_FORMAT_REPEAT calls per run): compare its params with
+// each other, not with target rows.
+
+#define BENCH_RUNS          4       //Repetitions of every case
+#define BENCH_I2C_ADDRESS   0x50    //I2C memory device (register pointer + data, RAM/FRAM style)
+#define BENCH_I2C_MAX_LEN   64      //Max bytes per I2C case
+#define BENCH_WAIT_US       100000  //Max wait for a loopback line (100 ms)
+#define BENCH_FLASH_ADDRESS 0x000000    //SPI flash sector used by the flash cases
+#define BENCH_FLASH_LEN     4096        //Bytes per flash read case
+#define BENCH_FLASH_NONE    0xFF        //No flash group
+#define BENCH_TEMPLATE_UART SERIALPORT_UART2    //SerialPort against SerialPortT
+#define BENCH_TEMPLATE_I2C  I2C_I2C0            //I2CMaster against I2CMasterT, if it is the I2C cases module
+#define BENCH_TEMPLATE_LEN  16                  //Bytes per template I2C case
+#define BENCH_FIFO_UART     SERIALPORT_UART2    //Blocking writes with the FIFOs disabled and enabled
+
+class Benchmark{
+    public:
+        Benchmark(Print&, SerialPort&, uint32_t, uint8_t = I2C_I2C0);
+
+        void run();
+        void runPrint(uint8_t);
+        void runFifo();
+        void runReadline(uint8_t);
+        void runI2C(uint32_t);
+        void runFlash(uint32_t);
+        void setFlash(uint8_t);
+        void runTemplate();
+        void runFormat();
+
+    private:
+        Print& report;
+        SerialPort& serial;
+        uint8_t i2cx;
+        uint8_t ssix;           //SPI flash SSI module, BENCH_FLASH_NONE if none
+        uint32_t baud;
+
+        uint32_t startCycles;
+        uint32_t startCalls;
+        uint32_t cycles;        //Accumulated in the current case
+        uint32_t calls;
+        bool hostClock;         //Time the runs with the host clock (simulator format group)
+        uint32_t polls;         //UARTFR reads of the current case
+        bool pollsCounted;
+
+        void header();
+        void begin();
+        void end();
+        void clear();
+        uint32_t clock();
+        void result(const char*, const char*, uint32_t, uint32_t, uint32_t, PrintStatus);
+};
+
+
+#endif /* BENCH_BENCHMARK_HPP_ */
@@ -7,12 +7,126 @@
 
 
 
+#include <../inc/tm4c1294ncpdt.h>
 #include <Peripherals/Board.hpp>
 
-const uint32_t GPIO_PORT_BASE = 0x40058000;
-const uint32_t UART_BASE_REG = 0x4000C000;
+#define SYSCTL_MOSCCTL_NOXTAL   0x04
+#define SYSCTL_MOSCCTL_PWRDN    0x08
+#define SYSCTL_MOSCCTL_OSCRNG   0x10        //MOSC above 10 MHz
+#define SYSCTL_RIS_MOSCPUP      0x100       //MOSC power up done
+#define SYSCTL_RSCLKCFG_PLLMOSC 0x03000000  //PLLSRC = MOSC
+#define SYSCTL_RSCLKCFG_USEPLL  0x10000000
+#define SYSCTL_RSCLKCFG_NEWFREQ 0x40000000
+#define SYSCTL_RSCLKCFG_MEMTIMU 0x80000000
+#define SYSCTL_PLLFREQ0_PLLPWR  0x00800000
+#define SYSCTL_PLLSTAT_LOCK     0x01
+#define SYSCTL_MEMTIM0_M        0x03EF03EF  //EBCHT, EBCE, EWS, FBCHT, FBCE, FWS
 
-const uint32_t I2C_BASE_REG_0 = 0x40020000;
-const uint32_t I2C_BASE_REG_1 = 0x400C0000;
-const uint32_t I2C_BASE_REG_2 = 0x400B8000;
+#define BOARD_PLL_N             4           //PLL input = MOSC / (N + 1) = 5 MHz
+#define BOARD_PLL_MINT          (CPU_VCO_FREQUENCY / (CPU_MOSC_FREQUENCY / (BOARD_PLL_N + 1)))
+#define BOARD_PLL_TIMEOUT       100000      //Lock polls before giving up
 
+static uint32_t sysClock = CPU_PIOSC_FREQUENCY;
+
+const uint32_t GPIO_PORT_BASE = GPIO_AHB_BASE;
+const uint32_t UART_BASE_REG = UART_MODULE_BASE;
+const uint32_t SSI_BASE_REG = SSI_MODULE_BASE;
+
+const uint32_t I2C_BASE_REG_0 = I2C_MODULE_BLOCK_0;
+const uint32_t I2C_BASE_REG_1 = I2C_MODULE_BLOCK_1;
+const uint32_t I2C_BASE_REG_2 = I2C_MODULE_BLOCK_2;
+
+
+/**
+ * Start the DWT cycle counter read by CYCLE_COUNT()
+ * Can be called several times, the count isn't reset
+ */
+void enableCycleCounter(){
+    BOARD_DEMCR_R |= 0x01000000;    //TRCENA: enable DWT
+    BOARD_DWT_CTRL_R |= 0x01;       //CYCCNTENA: enable cycle counter
+}
+
+/**
+ * Flash and EEPROM access timing for a system clock (MEMTIM0 fields)
+ * @param freq is the system clock
+ * @return MEMTIM0 value, wait states and bank clock high time of both memories
+ */
+static uint32_t memoryTiming(uint32_t freq){
+    uint32_t ws = 0;    //1 wait state per 20 MHz over 16 MHz, 0 up to 16 MHz
+    while(ws < 5 && freq > (ws == 0 ? 16000000U : 20000000U * (ws + 1))) ws++;
+    uint32_t cfg = ws == 0 ? 0x20 : ((ws + 1) << 6) | ws;   //BCE (half cycle high time) or BCHT, WS
+    return (cfg << 16) | cfg;
+}
+
+/**
+ * @param freq is a system clock frequency, in Hz
+ * @return true if setSystemClock can run at freq: PIOSC, or CPU_VCO_FREQUENCY
+ *      divided by 4 to 1024 (120 MHz, 96 MHz, 80 MHz, 60 MHz, 48 MHz, ...)
+ */
+bool isSystemClock(uint32_t freq){
+    if(freq == CPU_PIOSC_FREQUENCY) return true;
+    return freq != 0 && freq <= 120000000U && CPU_VCO_FREQUENCY % freq == 0 && CPU_VCO_FREQUENCY / freq <= 1024;
+}
+
+/**
+ * Power the MOSC and lock the PLL at CPU_VCO_FREQUENCY, only the first time:
+ * the PLL keeps running while the system clock is PIOSC, going back is fast
+ * @return true if the PLL is locked
+ */
+static bool startPll(){
+    if((SYSCTL_PLLSTAT_R & SYSCTL_PLLSTAT_LOCK) != 0) return true;
+
+    SYSCTL_MOSCCTL_R = (SYSCTL_MOSCCTL_R & ~(SYSCTL_MOSCCTL_NOXTAL | SYSCTL_MOSCCTL_PWRDN)) | SYSCTL_MOSCCTL_OSCRNG;
+    while((SYSCTL_RIS_R & SYSCTL_RIS_MOSCPUP) == 0) BOARD_WAIT();  //Wait for crystal start up
+
+    SYSCTL_RSCLKCFG_R = SYSCTL_RSCLKCFG_PLLMOSC;                    //PLL input = MOSC, still running from PIOSC
+    SYSCTL_PLLFREQ1_R = BOARD_PLL_N;                                //Q = 0
+    SYSCTL_PLLFREQ0_R = SYSCTL_PLLFREQ0_PLLPWR | BOARD_PLL_MINT;    //Power PLL, MFRAC = 0
+    SYSCTL_RSCLKCFG_R |= SYSCTL_RSCLKCFG_NEWFREQ;                   //Apply PLL configuration
+
+    uint32_t polls = 0;
+    while((SYSCTL_PLLSTAT_R & SYSCTL_PLLSTAT_LOCK) == 0){
+        if(++polls == BOARD_PLL_TIMEOUT) return false;
+        BOARD_WAIT();
+    }
+    return true;
+}
+
+/**
+ * Switch the system clock, the flash wait states of the new frequency are
+ * loaded with the switch (MEMTIMU)
+ * Peripherals aren't reprogrammed: at runtime use Clock::set, that notifies the drivers
+ *
+ * @param freq is the new system clock (see isSystemClock)
+ * @return the running system clock, unchanged if freq isn't valid or the PLL didn't lock
+ */
+uint32_t setSystemClock(uint32_t freq){
+    if(!isSystemClock(freq)) return sysClock;
+
+    uint32_t cfg = SYSCTL_RSCLKCFG_PLLMOSC;                         //PIOSC: OSCSRC = PIOSC, OSYSDIV = 0
+    if(freq != CPU_PIOSC_FREQUENCY){
+        if(!startPll()) return sysClock;
+        cfg |= SYSCTL_RSCLKCFG_USEPLL | (CPU_VCO_FREQUENCY / freq - 1); //PSYSDIV
+    }
+    SYSCTL_MEMTIM0_R = (SYSCTL_MEMTIM0_R & ~SYSCTL_MEMTIM0_M) | memoryTiming(freq);
+    SYSCTL_RSCLKCFG_R = SYSCTL_RSCLKCFG_MEMTIMU | cfg;
+    sysClock = freq;
+    return sysClock;
+}
+
+/**
+ * Set the system clock to CPU_FREQUENCY (see USE_PLL)
+ * Call it before opening the peripherals, their timing uses systemClock()
+ *
+ * @return the system clock, PIOSC if the PLL didn't lock
+ */
+uint32_t initSystemClock(){
+    return setSystemClock(CPU_FREQUENCY);
+}
+
+/**
+ * @return the running system clock (CPU, I2C and UART module clock), in Hz
+ */
+uint32_t systemClock(){
+    return sysClock;
+}
@@ -10,18 +10,54 @@
 
 #include <stdint.h>
 
-#define USE_PLL         (0)
+// System clock set by initSystemClock()
+//      USE_PLL 0   - PIOSC, 16 MHz
+//      USE_PLL 1   - PLL from the MOSC (25 MHz crystal), VCO 480 MHz divided to CPU_FREQUENCY
+// CPU_FREQUENCY is the configured frequency, drivers use the running one (systemClock())
+#ifndef USE_PLL
+#define USE_PLL         (1)
+#endif
 
 #define CPU_PIOSC_FREQUENCY (16000000U)
+#define CPU_MOSC_FREQUENCY  (25000000U)     //EK-TM4C1294XL crystal
+#define CPU_VCO_FREQUENCY   (480000000U)
 
 #if USE_PLL == 0
 #define CPU_FREQUENCY   CPU_PIOSC_FREQUENCY
 #else
-#define CPU_FREQUENCY   (120000000U)
+#define CPU_FREQUENCY   (120000000U)        //VCO / 4, must divide CPU_VCO_FREQUENCY
 #endif
 
+extern uint32_t initSystemClock();
+extern uint32_t systemClock();
+extern bool isSystemClock(uint32_t);
+extern uint32_t setSystemClock(uint32_t);
+
 
+#ifdef TIVA_SIM
+// Host build: registers live in the simulator register file (see Sim/Sim.hpp)
+#include <Sim/Sim.hpp>
+typedef SimReg HwReg;
+#define TIVA_HWREG(x)   (*Sim::reg(x))
+#define BOARD_WAIT()    Sim::idle()         //Busy wait iteration, lets simulated time run
+#define BOARD_SLEEP()   Sim::sleep()        //WFI, runs simulated time up to the next event
+#else
+typedef volatile uint32_t HwReg;
 #define TIVA_HWREG(x)   (*((volatile uint32_t*)(x)))
+#define BOARD_WAIT()
+#define BOARD_SLEEP()   __asm("    wfi")    //Sleep until an interrupt is pending (wakes even if PRIMASK is set)
+#endif
+
+#define HWREG_PTR(x)    (&TIVA_HWREG(x))    //Register block pointer, HwReg*
+
+// DWT cycle counter, counts CPU clock cycles (wraps every 2^32 cycles)
+#define BOARD_DEMCR_R       TIVA_HWREG(0xE000EDFC)
+#define BOARD_DWT_CTRL_R    TIVA_HWREG(0xE0001000)
+#define BOARD_DWT_CYCCNT_R  TIVA_HWREG(0xE0001004)
+
+#define CYCLE_COUNT()       (BOARD_DWT_CYCCNT_R)
+
+extern void enableCycleCounter();
 
 #define GPIO_PORTA_OFF  0
 #define GPIO_PORTB_OFF  1
@@ -39,10 +75,21 @@
 #define GPIO_PORTP_OFF  13
 #define GPIO_PORTQ_OFF  14
 
+#define GPIO_AHB_BASE   0x40058000U     //Port A, ports 4 KB apart (AHB aperture)
+#define UART_MODULE_BASE    0x4000C000U     //UART0, modules 4 KB apart
+#define SSI_MODULE_BASE     0x40008000U     //SSI0, modules 4 KB apart
+#define I2C_MODULE_BLOCK_0  0x40020000U     //I2C0 to I2C3, 4 modules per block, 4 KB apart
+#define I2C_MODULE_BLOCK_1  0x400C0000U     //I2C4 to I2C7
+#define I2C_MODULE_BLOCK_2  0x400B8000U     //I2C8, I2C9
+
+// I2C module register base, constant expression for a constant module
+#define I2C_MODULE_BASE(x)  ((((x) <= 3) ? I2C_MODULE_BLOCK_0 : (((x) <= 7) ? I2C_MODULE_BLOCK_1 : I2C_MODULE_BLOCK_2)) \
+                             + ((uint32_t)((x) & 0x03) << 12))
 
 
 extern const uint32_t GPIO_PORT_BASE;
 extern const uint32_t UART_BASE_REG;
+extern const uint32_t SSI_BASE_REG;
 extern const uint32_t I2C_BASE_REG_0;
 extern const uint32_t I2C_BASE_REG_1;
 extern const uint32_t I2C_BASE_REG_2;
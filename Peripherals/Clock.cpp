@@ -0,0 +1,106 @@
+/*
+ * Clock.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Peripherals/Clock.hpp>
+
+ClockListener Clock::listeners[CLOCK_MAX_LISTENERS] = {0};
+ClockSwitchStats Clock::stats = {0, 0, 0, 0};
+
+/**
+ * Switch the system clock, notifying the subscribed drivers before and after
+ *
+ * @param freq is the new system clock, in Hz (see isSystemClock)
+ * @return the running system clock, unchanged if freq isn't valid or the PLL didn't lock
+ */
+uint32_t Clock::set(uint32_t freq){
+    uint32_t oldFreq = systemClock();
+    if(freq == oldFreq) return oldFreq;
+    if(!isSystemClock(freq)){
+        stats.failed++;
+        return oldFreq;
+    }
+
+    enableCycleCounter();
+    uint32_t start = CYCLE_COUNT();
+    notify(CLOCK_PRE_CHANGE, oldFreq, freq);
+    uint32_t newFreq = setSystemClock(freq);
+    uint32_t switched = CYCLE_COUNT();
+    notify(CLOCK_POST_CHANGE, oldFreq, newFreq);
+    uint32_t end = CYCLE_COUNT();
+
+    //Cycles before the switch count at the old frequency, after it at the new one
+    uint64_t ns = (uint64_t)(switched - start) * 1000000000U / oldFreq +
+                  (uint64_t)(end - switched) * 1000000000U / newFreq;
+    stats.lastNs = ns > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)ns;
+    if(stats.lastNs > stats.maxNs) stats.maxNs = stats.lastNs;
+    if(newFreq == freq){
+        stats.count++;
+    }else{
+        stats.failed++;
+    }
+    return newFreq;
+}
+
+/**
+ * @return the running system clock, in Hz
+ */
+uint32_t Clock::frequency(){
+    return systemClock();
+}
+
+/**
+ * Add a listener of the system clock switches, nothing is done if it was already added
+ * @param listener is the notification function
+ * @return false if there is no room (CLOCK_MAX_LISTENERS)
+ */
+bool Clock::subscribe(ClockListener listener){
+    uint8_t free = CLOCK_MAX_LISTENERS;
+    for(uint8_t i = 0; i < CLOCK_MAX_LISTENERS; i++){
+        if(listeners[i] == listener) return true;
+        if(listeners[i] == 0 && free == CLOCK_MAX_LISTENERS) free = i;
+    }
+    if(free == CLOCK_MAX_LISTENERS) return false;
+    listeners[free] = listener;
+    return true;
+}
+
+/**
+ * Remove a listener of the system clock switches
+ * @param listener is the notification function
+ */
+void Clock::unsubscribe(ClockListener listener){
+    for(uint8_t i = 0; i < CLOCK_MAX_LISTENERS; i++){
+        if(listeners[i] == listener) listeners[i] = 0;
+    }
+}
+
+/**
+ * @return switch counters and latency (nanoseconds, listeners included)
+ */
+const ClockSwitchStats& Clock::switchStats(){
+    return stats;
+}
+
+void Clock::clearSwitchStats(){
+    stats.count = 0;
+    stats.failed = 0;
+    stats.lastNs = 0;
+    stats.maxNs = 0;
+}
+
+/**
+ * Private: call every listener
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+void Clock::notify(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    for(uint8_t i = 0; i < CLOCK_MAX_LISTENERS; i++){
+        if(listeners[i] != 0) listeners[i](phase, oldFreq, newFreq);
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Clock.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_CLOCK_HPP_
+#define PERIPHERALS_CLOCK_HPP_
+
+#include <stdint.h>
+#include <Peripherals/Board.hpp>
+
+// Runtime system clock switching (e.g. PIOSC while idle, PLL under load).
+// Drivers whose timing depends on the system clock subscribe a listener, called
+// before and after every switch to reprogram their divisors:
+//  - SerialPort: only UARTs clocked from the system clock (over 1 Mbaud), the
+//      frame in flight is finished before the switch
+//  - I2CMaster: SCL timer period, never faster than the requested speed meanwhile
+// Switch from thread context, not from an interrupt handler.
+
+#ifndef CLOCK_MAX_LISTENERS
+#define CLOCK_MAX_LISTENERS     8
+#endif
+
+// Listener phases
+#define CLOCK_PRE_CHANGE        0   //Old frequency still running
+#define CLOCK_POST_CHANGE       1   //New frequency running (old one if the switch failed)
+
+/**
+ * System clock change notification
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+typedef void (*ClockListener)(uint8_t phase, uint32_t oldFreq, uint32_t newFreq);
+
+// Switch latency, from the first listener call to the last one
+typedef struct{
+    uint32_t count;     //Switches made
+    uint32_t failed;    //Invalid frequency or PLL not locked
+    uint32_t lastNs;
+    uint32_t maxNs;
+} ClockSwitchStats;
+
+class Clock{
+    public:
+        static uint32_t set(uint32_t);
+        static uint32_t frequency();
+
+        static bool subscribe(ClockListener);
+        static void unsubscribe(ClockListener);
+
+        static const ClockSwitchStats& switchStats();
+        static void clearSwitchStats();
+
+    private:
+        static ClockListener listeners[CLOCK_MAX_LISTENERS];
+        static ClockSwitchStats stats;
+
+        static void notify(uint8_t, uint32_t, uint32_t);
+};
+
+
+#endif /* PERIPHERALS_CLOCK_HPP_ */
@@ -0,0 +1,240 @@
+/*
+ * EventLoop.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <../inc/tm4c1294ncpdt.h>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/Clock.hpp>
+#include <Peripherals/EventLoop.hpp>
+#include "../driverlib/interrupt.h"
+#include "../driverlib/rom_map.h"
+
+static_assert(EVENT_QUEUE_SIZE >= 2 && EVENT_QUEUE_SIZE <= 32768 && (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) == 0,
+              "EVENT_QUEUE_SIZE must be a power of 2 between 2 and 32768");
+
+#define EVENT_TIMER_IRQ     19      //Timer0 subtimer A
+#define EVENT_TIMER_TATO    0x01    //Timer A time-out interrupt
+
+Event EventLoop::queue[EVENT_QUEUE_SIZE];
+volatile uint16_t EventLoop::head = 0;
+volatile uint16_t EventLoop::tail = 0;
+EventLoop::Timer EventLoop::timers[EVENT_MAX_TIMERS];
+volatile uint32_t EventLoop::tickCount = 0;
+EventLatencyStats EventLoop::stats;
+
+/**
+ * Start the Timer0 tick (EVENT_TICK_HZ) and clear the queue, timers and latency stats
+ * Call it once, after the system clock is set
+ */
+void EventLoop::init(){
+    head = 0;   tail = 0;
+    tickCount = 0;
+    for(uint8_t i = 0; i < EVENT_MAX_TIMERS; i++) timers[i].handler = 0;
+    clearLatency();
+    enableCycleCounter();   //Latency time base
+
+    SYSCTL_RCGCTIMER_R |= 0x01;                 //Enable Timer 0
+    while((SYSCTL_RCGCTIMER_R & 0x01) == 0x00); //Wait for timer0 clock enable
+    TIMER0_CTL_R = 0x00;                        //Disable Timer A and B
+    TIMER0_CFG_R = 0x00;                        //Configure as 32 bit timer
+    TIMER0_TAMR_R = 0x02;                       //Periodic Mode
+    TIMER0_TAILR_R = systemClock() / EVENT_TICK_HZ - 1;
+    TIMER0_ICR_R = EVENT_TIMER_TATO;
+    TIMER0_IMR_R = EVENT_TIMER_TATO;            //Timer A TimeOut Interrupt Mask
+    Clock::subscribe(onClockChange);
+    NVIC_EN0_R = 1 << EVENT_TIMER_IRQ;          //Enable NVIC Timer0 Interrupt
+    TIMER0_CTL_R |= 0x01;                       //Enable Timer0
+}
+
+/**
+ * Queue an event, can be called from interrupt handlers
+ *
+ * @param handler is called by the event loop
+ * @param arg is the handler argument
+ * @param data is the handler data value
+ * @return false if the queue is full (event dropped)
+ */
+bool EventLoop::post(EventHandler handler, void* arg, uint32_t data){
+    if(handler == 0) return false;
+    bool masked = MAP_IntMasterDisable();   //Serialize producers of any priority
+    uint16_t h = head;
+    bool room = (uint16_t)(h - tail) < EVENT_QUEUE_SIZE;
+    if(room){
+        Event& e = queue[h & (EVENT_QUEUE_SIZE - 1)];
+        e.handler = handler;
+        e.arg = arg;
+        e.data = data;
+        e.postedAt = CYCLE_COUNT();
+        head = h + 1;   //Publish event after it is stored
+    }else{
+        stats.dropped++;
+    }
+    if(!masked) MAP_IntMasterEnable();
+    return room;
+}
+
+/**
+ * Run a handler periodically, the first run is one period from now
+ *
+ * @param ms is the period in milliseconds (1 or more)
+ * @param handler is called by the event loop, data is the tick count
+ * @param arg is the handler argument
+ * @return timer id for cancel, EVENT_NO_TIMER if there is no free timer
+ */
+uint8_t EventLoop::every(uint32_t ms, EventHandler handler, void* arg){
+    return startTimer(ms, ms ? ms : 1, handler, arg);
+}
+
+/**
+ * Run a handler once, ms milliseconds from now
+ *
+ * @param ms is the delay in milliseconds (1 or more)
+ * @param handler is called by the event loop, data is the tick count
+ * @param arg is the handler argument
+ * @return timer id for cancel, EVENT_NO_TIMER if there is no free timer
+ */
+uint8_t EventLoop::after(uint32_t ms, EventHandler handler, void* arg){
+    return startTimer(ms, 0, handler, arg);
+}
+
+/**
+ * Stop a timer, an event it already posted still runs
+ * @param id is the timer id returned by every or after
+ */
+void EventLoop::cancel(uint8_t id){
+    if(id < EVENT_MAX_TIMERS) timers[id].handler = 0;
+}
+
+/**
+ * Dispatch the oldest event
+ * @return false if there was none
+ */
+bool EventLoop::runOnce(){
+    uint16_t t = tail;
+    if(t == head) return false;
+    Event e = queue[t & (EVENT_QUEUE_SIZE - 1)];
+    tail = t + 1;   //Release slot after it is read
+
+    uint32_t us = (CYCLE_COUNT() - e.postedAt) / (systemClock() / 1000000);
+    uint8_t bin = 0;
+    while(bin < EVENT_LATENCY_BINS - 1 && (us >> bin) != 0) bin++;
+    stats.bins[bin]++;
+    stats.dispatched++;
+    if(us > stats.maxUs) stats.maxUs = us;
+
+    e.handler(e.data, e.arg);
+    return true;
+}
+
+/**
+ * Dispatch events forever, sleeping until the next interrupt when the queue is empty
+ */
+void EventLoop::run(){
+    while(1){
+        while(runOnce());
+        MAP_IntMasterDisable();         //An event posted after the check wakes WFI
+        if(tail == head) BOARD_SLEEP();
+        MAP_IntMasterEnable();
+    }
+}
+
+/**
+ * @return milliseconds since init (wraps every 2^32 ms)
+ */
+uint32_t EventLoop::ticks(){
+    return tickCount;
+}
+
+/**
+ * @return dispatched and dropped events, post to dispatch latency histogram
+ */
+const EventLatencyStats& EventLoop::latency(){
+    return stats;
+}
+
+void EventLoop::clearLatency(){
+    stats.dispatched = 0;
+    stats.dropped = 0;
+    stats.maxUs = 0;
+    for(uint8_t i = 0; i < EVENT_LATENCY_BINS; i++) stats.bins[i] = 0;
+}
+
+/**
+ * Print the latency histogram, a CSV line per bin preceded by a header line:
+ *  latency_us,events
+ * latency_us is the bin upper limit, the last bin has no limit (+)
+ *
+ * @param out is the output, usually a SerialPort
+ */
+void EventLoop::dumpLatency(Print& out){
+    out.println("latency_us,events");
+    for(uint8_t i = 0; i < EVENT_LATENCY_BINS - 1; i++){
+        out.printf("<%u,%u\r\n", 1u << i, stats.bins[i]);
+    }
+    out.printf("+,%u\r\n", stats.bins[EVENT_LATENCY_BINS - 1]);
+    out.printf("max %u us, %u dispatched, %u dropped\r\n", stats.maxUs, stats.dispatched, stats.dropped);
+}
+
+/**
+ * Timer0A interrupt: count the tick and post the events of the timers due
+ */
+void EventLoop::serviceTick(){
+    TIMER0_ICR_R = EVENT_TIMER_TATO;
+    uint32_t now = ++tickCount;
+    for(uint8_t i = 0; i < EVENT_MAX_TIMERS; i++){
+        Timer& t = timers[i];
+        if(t.handler == 0 || --t.left != 0) continue;
+        post(t.handler, t.arg, now);
+        if(t.period != 0){
+            t.left = t.period;
+        }else{
+            t.handler = 0;  //One shot done
+        }
+    }
+}
+
+/**
+ * Private: take a free timer
+ *
+ * @param ms is the delay of the first run
+ * @param period is the delay of the next runs, 0 for a single run
+ * @param handler is called by the event loop
+ * @param arg is the handler argument
+ * @return timer id, EVENT_NO_TIMER if there is no free timer
+ */
+uint8_t EventLoop::startTimer(uint32_t ms, uint32_t period, EventHandler handler, void* arg){
+    if(handler == 0) return EVENT_NO_TIMER;
+    bool masked = MAP_IntMasterDisable();   //Tick interrupt reads the timers
+    uint8_t id = EVENT_NO_TIMER;
+    for(uint8_t i = 0; i < EVENT_MAX_TIMERS && id == EVENT_NO_TIMER; i++){
+        if(timers[i].handler == 0) id = i;
+    }
+    if(id != EVENT_NO_TIMER){
+        timers[id].arg = arg;
+        timers[id].period = period;
+        timers[id].left = ms ? ms : 1;
+        timers[id].handler = handler;
+    }
+    if(!masked) MAP_IntMasterEnable();
+    return id;
+}
+
+/**
+ * Private: keep the tick at EVENT_TICK_HZ after system clock switches
+ */
+void EventLoop::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    (void)oldFreq;
+    if(phase == CLOCK_POST_CHANGE) TIMER0_TAILR_R = newFreq / EVENT_TICK_HZ - 1;
+}
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void EventLoop_Timer0A_Interrupt(){ EventLoop::serviceTick(); }
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+/*
+ * EventLoop.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_EVENTLOOP_HPP_
+#define PERIPHERALS_EVENTLOOP_HPP_
+
+#include <stdint.h>
+#include <Util/Print.hpp>
+
+// Run to completion event scheduler
+//  - post() queues a handler call, from thread context or any interrupt handler
+//    (e.g. driver completion callbacks: SerialPort line callback, I2CTransaction callback)
+//  - every() and after() run handlers from millisecond timers, ticked by Timer0
+//  - run() dispatches the events in post order and sleeps (WFI) while there are none
+// Handlers run one at a time in thread context, they shouldn't wait for long.
+// Timer0 and its interrupt (EventLoop_Timer0A_Interrupt) belong to the event loop.
+
+#ifndef EVENT_QUEUE_SIZE
+#define EVENT_QUEUE_SIZE        32  //Must be a power of 2
+#endif
+
+#ifndef EVENT_MAX_TIMERS
+#define EVENT_MAX_TIMERS        8
+#endif
+
+#define EVENT_TICK_HZ           1000    //Timer tick, 1 ms
+#define EVENT_NO_TIMER          0xFF
+
+// Post to dispatch latency histogram: bin 0 < 1 us, bin n [2^(n-1), 2^n) us, last bin the rest
+#define EVENT_LATENCY_BINS      12
+
+/**
+ * Event handler
+ * @param data is the value given when the event was posted (timers: tick count)
+ * @param arg is the user argument
+ */
+typedef void (*EventHandler)(uint32_t data, void* arg);
+
+typedef struct{
+    EventHandler handler;
+    void* arg;
+    uint32_t data;
+    uint32_t postedAt;  //Cycle count
+} Event;
+
+typedef struct{
+    uint32_t dispatched;
+    uint32_t dropped;                   //Queue full, events lost
+    uint32_t maxUs;
+    uint32_t bins[EVENT_LATENCY_BINS];
+} EventLatencyStats;
+
+class EventLoop{
+    public:
+        static void init();
+
+        static bool post(EventHandler, void* = 0, uint32_t = 0);
+        static uint8_t every(uint32_t, EventHandler, void* = 0);
+        static uint8_t after(uint32_t, EventHandler, void* = 0);
+        static void cancel(uint8_t);
+
+        static bool runOnce();
+        static void run();
+        static uint32_t ticks();
+
+        static const EventLatencyStats& latency();
+        static void clearLatency();
+        static void dumpLatency(Print&);
+
+        static void serviceTick();
+
+    private:
+        typedef struct{
+            EventHandler handler;
+            void* arg;
+            uint32_t period;    //Ticks, 0 for one shot timers
+            uint32_t left;      //Ticks to the next run, 0 if free
+        } Timer;
+
+        static Event queue[EVENT_QUEUE_SIZE];
+        static volatile uint16_t head;      //Free running indexes, posts are serialized with PRIMASK
+        static volatile uint16_t tail;      //Written only by the dispatcher
+        static Timer timers[EVENT_MAX_TIMERS];
+        static volatile uint32_t tickCount;
+        static EventLatencyStats stats;
+
+        static uint8_t startTimer(uint32_t, uint32_t, EventHandler, void*);
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+};
+
+
+#endif /* PERIPHERALS_EVENTLOOP_HPP_ */
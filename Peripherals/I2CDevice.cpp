@@ -0,0 +1,179 @@
+/*
+ * I2CDevice.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Peripherals/I2CDevice.hpp>
+
+/**
+ * @param bus is an opened I2CMaster
+ * @param address is the 7-bit slave address
+ * @param shadow is the register shadow, size bytes
+ * @param valid is the shadow valid bitmap, (size + 7) / 8 bytes
+ * @param size is the shadow size, registers below it are cached
+ * @param gap is the readAll join distance
+ */
+I2CDeviceBase::I2CDeviceBase(I2CMaster& bus, uint8_t address, uint8_t* shadow, uint8_t* valid, uint16_t size, uint8_t gap):
+    bus(bus), address(address), shadow(shadow), valid(valid), cacheSize(size), gap(gap){
+    invalidate();
+}
+
+/**
+ * Forget the shadow, next field writes read their register first
+ * (call it after a device reset or a write not made through this object)
+ */
+void I2CDeviceBase::invalidate(){
+    for(uint16_t i = 0; i < (cacheSize + 7) / 8; i++){
+        valid[i] = 0;
+    }
+}
+
+/**
+ * Private: one blocking transaction to the device
+ * @param reg is the first register
+ * @param tx are the bytes written from reg (0 if none)
+ * @param txLen is the quantity of bytes to write
+ * @param rx receives the bytes read from reg (0 if none)
+ * @param rxLen is the quantity of bytes to read
+ * @return I2C transaction result
+ */
+PrintStatus I2CDeviceBase::transfer(uint8_t reg, const uint8_t* tx, uint8_t txLen, uint8_t* rx, uint8_t rxLen){
+    I2CTransaction t = {address, I2C_TRXN_REG, reg, I2C_PRIORITY_NORMAL,
+                        tx, txLen, rx, rxLen, 0, 0, I2C_BUSY, 0};
+    return bus.transfer(&t);
+}
+
+/**
+ * Private: registers kept in the shadow are not volatile and below its size
+ * @return true if the register is cached
+ */
+bool I2CDeviceBase::cacheable(uint8_t reg, uint8_t width, uint8_t flags){
+    return (flags & I2C_REG_VOLATILE) == 0 && reg + width <= cacheSize;
+}
+
+/**
+ * Private: keep a register value read from or written to the device
+ * @param bytes is the register as on the bus
+ */
+void I2CDeviceBase::store(uint8_t reg, const uint8_t* bytes, uint8_t width, uint8_t flags){
+    if(!cacheable(reg, width, flags)) return;
+    for(uint8_t i = 0; i < width; i++){
+        shadow[reg + i] = bytes[i];
+        valid[(reg + i) >> 3] |= 1 << ((reg + i) & 0x07);
+    }
+}
+
+/**
+ * Private: take a register value from the shadow
+ * @param bytes receives the register as on the bus
+ * @return false if the shadow doesn't hold it
+ */
+bool I2CDeviceBase::load(uint8_t reg, uint8_t* bytes, uint8_t width, uint8_t flags){
+    if(!cacheable(reg, width, flags)) return false;
+    for(uint8_t i = 0; i < width; i++){
+        if((valid[(reg + i) >> 3] & (1 << ((reg + i) & 0x07))) == 0) return false;
+        bytes[i] = shadow[reg + i];
+    }
+    return true;
+}
+
+/**
+ * Private: register bytes to value
+ * @param flags selects the byte order (I2C_REG_LE)
+ */
+uint32_t I2CDeviceBase::decode(const uint8_t* bytes, uint8_t width, uint8_t flags){
+    uint32_t value = 0;
+    for(uint8_t i = 0; i < width; i++){
+        value = (value << 8) | bytes[(flags & I2C_REG_LE) ? width - 1 - i : i];
+    }
+    return value;
+}
+
+/**
+ * Private: value to register bytes
+ * @param flags selects the byte order (I2C_REG_LE)
+ */
+void I2CDeviceBase::encode(uint32_t value, uint8_t* bytes, uint8_t width, uint8_t flags){
+    for(uint8_t i = 0; i < width; i++){
+        bytes[(flags & I2C_REG_LE) ? i : width - 1 - i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+/**
+ * Read a register from the device, the shadow is updated
+ * @param value receives the register
+ * @return I2C transaction result
+ */
+PrintStatus I2CDeviceBase::readReg(uint8_t reg, uint32_t& value, uint8_t width, uint8_t flags){
+    uint8_t bytes[4];
+    PrintStatus status = transfer(reg, 0, 0, bytes, width);
+    value = 0;
+    if(status != I2C_READ_OK) return status;
+    store(reg, bytes, width, flags);
+    value = decode(bytes, width, flags);
+    return status;
+}
+
+/**
+ * Write a register, the shadow is updated if the device took it
+ * @return I2C transaction result
+ */
+PrintStatus I2CDeviceBase::writeReg(uint8_t reg, uint32_t value, uint8_t width, uint8_t flags){
+    uint8_t bytes[4];
+    encode(value, bytes, width, flags);
+    PrintStatus status = transfer(reg, bytes, width, 0, 0);
+    if(status == I2C_WRITE_OK) store(reg, bytes, width, flags);
+    return status;
+}
+
+/**
+ * Replace the mask bits of a register, it is read from the device only if
+ * the shadow doesn't hold it
+ * @param mask are the bits to replace
+ * @param bits is the new value of the mask bits
+ * @return I2C transaction result
+ */
+PrintStatus I2CDeviceBase::modify(uint8_t reg, uint32_t mask, uint32_t bits, uint8_t width, uint8_t flags){
+    uint8_t bytes[4];
+    uint32_t value;
+    if(load(reg, bytes, width, flags)){
+        value = decode(bytes, width, flags);
+    }else{
+        PrintStatus status = readReg(reg, value, width, flags);
+        if(status != I2C_READ_OK) return status;
+    }
+    return writeReg(reg, (value & ~mask) | (bits & mask), width, flags);
+}
+
+/**
+ * Read registers in address order, joining them in bursts (see I2CRegMap::joins)
+ * @param values receives a register value each, 0 for the ones not read
+ * @return OK, or the first failed transaction result
+ */
+PrintStatus I2CDeviceBase::readList(const uint8_t* regs, const uint8_t* width, const uint8_t* flags, uint8_t n, uint32_t* values){
+    uint8_t buf[I2C_DEVICE_BURST_MAX];
+    for(uint8_t i = 0; i < n; i++){
+        values[i] = 0;
+    }
+
+    uint8_t first = 0;
+    while(first < n){
+        uint8_t last = first;
+        while(last + 1 < n && I2CRegMap::joins(regs, width, first, last + 1, gap)) last++;
+
+        uint8_t len = regs[last] + width[last] - regs[first];
+        PrintStatus status = transfer(regs[first], 0, 0, buf, len);
+        if(status != I2C_READ_OK) return status;
+        for(uint8_t i = first; i <= last; i++){
+            const uint8_t* bytes = buf + (regs[i] - regs[first]);
+            store(regs[i], bytes, width[i], flags[i]);
+            values[i] = decode(bytes, width[i], flags[i]);
+        }
+        first = last + 1;
+    }
+    return I2C_READ_OK;
+}
@@ -0,0 +1,247 @@
+/*
+ * I2CDevice.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_I2CDEVICE_HPP_
+#define PERIPHERALS_I2CDEVICE_HPP_
+
+#include <stdint.h>
+#include <Peripherals/I2CMaster.hpp>
+
+// Register map device drivers on top of I2CMaster
+// A device is described by types: registers (address, width, byte order) and
+// bitfields, so accesses compile to plain transactions with constant arguments:
+//
+//   namespace Sensor{
+//       typedef I2CReg<0x1B> Config;                    //8-bit register
+//       typedef I2CField<Config, 3, 2> Range;           //Config bits 4:3
+//       typedef I2CReg<0x3B, 2, I2C_REG_VOLATILE> X;    //16-bit big endian data
+//       typedef I2CReg<0x3D, 2, I2C_REG_VOLATILE> Y;
+//   }
+//   I2CDevice<0x40> dev(bus, 0x68);         //Shadow of registers 0x00 - 0x3F
+//   dev.write<Sensor::Range>(3);            //Read-modify-write of Config
+//   dev.write<Sensor::Range>(1);            //Config known: write only
+//   uint32_t xy[2];
+//   dev.readAll<Sensor::X, Sensor::Y>(xy);  //One 4 byte burst
+//
+// Register reads go to the device, writes go through the shadow: a field write
+// reads its register only if the shadow doesn't hold it (first access, volatile
+// register or invalidate()). readAll joins registers closer than GAP bytes into
+// one burst (the device must auto-increment its register address). Signed
+// registers are cast by the caller: (int16_t)xy[0].
+// See I2CDeviceMaps.hpp for device descriptions.
+
+#define I2C_REG_LE          0x01    //Least significant byte at the lowest address
+#define I2C_REG_VOLATILE    0x02    //Changed by the device (data, status), never taken from the shadow
+#define I2C_REG_RO          0x04    //Read only, writes don't compile
+
+#ifndef I2C_DEVICE_GAP
+#define I2C_DEVICE_GAP      0       //Unused register bytes a readAll burst may read to join two registers
+#endif
+
+#ifndef I2C_DEVICE_BURST_MAX
+#define I2C_DEVICE_BURST_MAX 32     //Max bytes of a readAll burst (stack buffer)
+#endif
+
+/**
+ * Device register
+ * @tparam ADDR is the register address
+ * @tparam WIDTH is the register size in bytes (1 to 4), consecutive addresses
+ * @tparam FLAGS are I2C_REG_xx flags (default big endian, read/write, cacheable)
+ */
+template<uint8_t ADDR, uint8_t WIDTH = 1, uint8_t FLAGS = 0>
+struct I2CReg{
+    static_assert(WIDTH >= 1 && WIDTH <= 4, "I2CReg WIDTH must be 1 to 4 bytes");
+    static_assert(ADDR + WIDTH <= 256, "I2CReg past the register address space");
+    typedef I2CReg Reg;
+    static constexpr uint8_t address = ADDR;
+    static constexpr uint8_t width = WIDTH;
+    static constexpr uint8_t flags = FLAGS;
+    static constexpr uint8_t lsb = 0;
+    static constexpr uint32_t mask = WIDTH == 4 ? 0xFFFFFFFF : (1UL << (8 * WIDTH)) - 1;
+};
+
+/**
+ * Bitfield of a device register
+ * @tparam R is the I2CReg
+ * @tparam LSB is the first bit
+ * @tparam BITS is the field size
+ */
+template<class R, uint8_t LSB, uint8_t BITS>
+struct I2CField{
+    static_assert(BITS >= 1 && LSB + BITS <= 8 * R::width, "I2CField out of its register");
+    typedef typename R::Reg Reg;
+    static constexpr uint8_t lsb = LSB;
+    static constexpr uint32_t mask = (BITS == 32 ? 0xFFFFFFFF : ((1UL << BITS) - 1)) << LSB;
+};
+
+namespace I2CRegMap{
+    /**
+     * @return true if the registers are in address order and don't overlap
+     *      (fields of a register may repeat it)
+     */
+    constexpr bool ascending(const uint8_t* address, const uint8_t* width, uint8_t n){
+        for(uint8_t i = 1; i < n; i++){
+            bool same = address[i] == address[i - 1] && width[i] == width[i - 1];
+            if(!same && address[i] < address[i - 1] + width[i - 1]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @param first is the first register of the current burst
+     * @param i is the next register, i > first
+     * @return true if register i is read by the burst of first
+     */
+    constexpr bool joins(const uint8_t* address, const uint8_t* width, uint8_t first, uint8_t i, uint8_t gap){
+        return address[i] <= address[i - 1] + width[i - 1] + gap &&
+               address[i] + width[i] - address[first] <= I2C_DEVICE_BURST_MAX;
+    }
+
+    /**
+     * @return transactions readAll makes for the registers
+     */
+    constexpr uint8_t bursts(const uint8_t* address, const uint8_t* width, uint8_t n, uint8_t gap){
+        uint8_t count = 0;
+        uint8_t first = 0;
+        for(uint8_t i = 0; i < n; i++){
+            if(i != 0 && joins(address, width, first, i, gap)) continue;
+            count++;
+            first = i;
+        }
+        return count;
+    }
+
+    /**
+     * Registers of a readAll, as arrays
+     * @tparam Ts are I2CReg or I2CField types
+     */
+    template<class... Ts>
+    struct List{
+        static constexpr uint8_t count = sizeof...(Ts);
+        static constexpr uint8_t address[count] = {Ts::Reg::address...};
+        static constexpr uint8_t width[count] = {Ts::Reg::width...};
+        static constexpr uint8_t flags[count] = {Ts::Reg::flags...};
+        static constexpr uint8_t lsb[count] = {Ts::lsb...};
+        static constexpr uint32_t mask[count] = {Ts::mask...};
+    };
+    template<class... Ts> constexpr uint8_t List<Ts...>::address[];
+    template<class... Ts> constexpr uint8_t List<Ts...>::width[];
+    template<class... Ts> constexpr uint8_t List<Ts...>::flags[];
+    template<class... Ts> constexpr uint8_t List<Ts...>::lsb[];
+    template<class... Ts> constexpr uint32_t List<Ts...>::mask[];
+}
+
+/**
+ * Register access of a device, the shadow storage is given by I2CDevice
+ */
+class I2CDeviceBase{
+    public:
+        void invalidate();
+
+    protected:
+        I2CDeviceBase(I2CMaster&, uint8_t, uint8_t*, uint8_t*, uint16_t, uint8_t);
+
+        PrintStatus readReg(uint8_t, uint32_t&, uint8_t, uint8_t);
+        PrintStatus writeReg(uint8_t, uint32_t, uint8_t, uint8_t);
+        PrintStatus modify(uint8_t, uint32_t, uint32_t, uint8_t, uint8_t);
+        PrintStatus readList(const uint8_t*, const uint8_t*, const uint8_t*, uint8_t, uint32_t*);
+
+    private:
+        I2CMaster& bus;
+        uint8_t address;
+        uint8_t* shadow;    //Register values, cacheSize bytes
+        uint8_t* valid;     //Shadow byte holds the device value, a bit per byte
+        uint16_t cacheSize;
+        uint8_t gap;
+
+        PrintStatus transfer(uint8_t, const uint8_t*, uint8_t, uint8_t*, uint8_t);
+        bool cacheable(uint8_t, uint8_t, uint8_t);
+        void store(uint8_t, const uint8_t*, uint8_t, uint8_t);
+        bool load(uint8_t, uint8_t*, uint8_t, uint8_t);
+        static uint32_t decode(const uint8_t*, uint8_t, uint8_t);
+        static void encode(uint32_t, uint8_t*, uint8_t, uint8_t);
+};
+
+/**
+ * I2C device driven through its register map
+ * @tparam CACHE is the shadow size: registers below this address are cached (0 none)
+ * @tparam GAP is the readAll join distance (see I2C_DEVICE_GAP), unused registers
+ *      it reads must have no read side effects
+ */
+template<uint16_t CACHE = 0, uint8_t GAP = I2C_DEVICE_GAP>
+class I2CDevice:public I2CDeviceBase{
+    static_assert(CACHE <= 256, "I2CDevice CACHE must be 0 to 256 registers");
+    public:
+        /**
+         * @param bus is an opened I2CMaster, shared with other devices
+         * @param address is the 7-bit slave address
+         */
+        I2CDevice(I2CMaster& bus, uint8_t address):
+            I2CDeviceBase(bus, address, shadowRegs, validRegs, CACHE, GAP){}
+
+        /**
+         * Read a register or field from the device
+         * @tparam T is the I2CReg or I2CField
+         * @param value receives the register, or the field shifted to bit 0
+         * @return I2C transaction result
+         */
+        template<class T>
+        inline PrintStatus read(uint32_t& value){
+            PrintStatus status = readReg(T::Reg::address, value, T::Reg::width, T::Reg::flags);
+            value = (value & T::mask) >> T::lsb;
+            return status;
+        }
+
+        /**
+         * Write a register, or a field (read-modify-write, the read is skipped if the shadow holds the register)
+         * @tparam T is the I2CReg or I2CField
+         * @param value is the register value, or the field value from bit 0
+         * @return I2C transaction result
+         */
+        template<class T>
+        inline PrintStatus write(uint32_t value){
+            static_assert((T::Reg::flags & I2C_REG_RO) == 0, "I2CDevice write of a read only register");
+            if(T::mask == T::Reg::mask) return writeReg(T::Reg::address, value, T::Reg::width, T::Reg::flags);
+            return modify(T::Reg::address, T::mask, value << T::lsb, T::Reg::width, T::Reg::flags);
+        }
+
+        /**
+         * Read registers and fields with the least transactions: registers in
+         * address order, GAP bytes apart at most, are read by one burst
+         * @tparam Ts are I2CReg or I2CField types, in address order (fields of a register together)
+         * @param values receives a value per type, as read()
+         * @return OK, or the first failed transaction result (later bursts aren't read)
+         */
+        template<class... Ts>
+        PrintStatus readAll(uint32_t* values){
+            static_assert(sizeof...(Ts) != 0, "I2CDevice readAll without registers");
+            typedef I2CRegMap::List<Ts...> L;
+            static_assert(I2CRegMap::ascending(L::address, L::width, L::count), "I2CDevice readAll registers out of address order");
+            PrintStatus status = readList(L::address, L::width, L::flags, L::count, values);
+            for(uint8_t i = 0; i < L::count; i++){
+                values[i] = (values[i] & L::mask[i]) >> L::lsb[i];
+            }
+            return status;
+        }
+
+        /**
+         * @return transactions readAll<Ts...> makes, a compile time constant
+         */
+        template<class... Ts>
+        static constexpr uint8_t bursts(){
+            typedef I2CRegMap::List<Ts...> L;
+            return I2CRegMap::bursts(L::address, L::width, L::count, GAP);
+        }
+
+    private:
+        uint8_t shadowRegs[CACHE ? CACHE : 1];
+        uint8_t validRegs[CACHE ? (CACHE + 7) / 8 : 1];
+};
+
+
+#endif /* PERIPHERALS_I2CDEVICE_HPP_ */
@@ -0,0 +1,95 @@
+/*
+ * I2CDeviceMaps.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_I2CDEVICEMAPS_HPP_
+#define PERIPHERALS_I2CDEVICEMAPS_HPP_
+
+#include <Peripherals/I2CDevice.hpp>
+
+// Register maps of common I2C devices, for I2CDevice (see I2CDevice.hpp)
+//
+//   I2CDevice<Mpu6050::CACHE> imu(bus, Mpu6050::ADDRESS);
+//   imu.write<Mpu6050::Sleep>(0);
+//   imu.write<Mpu6050::AccelRange>(Mpu6050::ACCEL_8G);
+//   uint32_t m[7];
+//   imu.readAll<Mpu6050::AccelX, Mpu6050::AccelY, Mpu6050::AccelZ, Mpu6050::Temp,
+//               Mpu6050::GyroX, Mpu6050::GyroY, Mpu6050::GyroZ>(m);    //One 14 byte burst
+
+/**
+ * InvenSense MPU-6050 accelerometer and gyroscope, 16-bit big endian samples
+ */
+namespace Mpu6050{
+    static const uint8_t ADDRESS = 0x68;    //AD0 low, 0x69 AD0 high
+    static const uint16_t CACHE = 0x6C;     //Configuration up to PWR_MGMT_1
+
+    typedef I2CReg<0x19> SampleDivider;
+    typedef I2CReg<0x1A> Config;
+    typedef I2CField<Config, 0, 3> LowPass;         //DLPF_CFG
+    typedef I2CReg<0x1B> GyroConfig;
+    typedef I2CField<GyroConfig, 3, 2> GyroRange;   //FS_SEL: 250, 500, 1000, 2000 deg/s
+    typedef I2CReg<0x1C> AccelConfig;
+    typedef I2CField<AccelConfig, 3, 2> AccelRange; //AFS_SEL: ACCEL_xG
+    typedef I2CReg<0x38> IntEnable;
+    typedef I2CReg<0x3A, 1, I2C_REG_VOLATILE | I2C_REG_RO> IntStatus;
+
+    typedef I2CReg<0x3B, 2, I2C_REG_VOLATILE | I2C_REG_RO> AccelX;
+    typedef I2CReg<0x3D, 2, I2C_REG_VOLATILE | I2C_REG_RO> AccelY;
+    typedef I2CReg<0x3F, 2, I2C_REG_VOLATILE | I2C_REG_RO> AccelZ;
+    typedef I2CReg<0x41, 2, I2C_REG_VOLATILE | I2C_REG_RO> Temp;    //deg C = (int16_t)Temp / 340 + 36.53
+    typedef I2CReg<0x43, 2, I2C_REG_VOLATILE | I2C_REG_RO> GyroX;
+    typedef I2CReg<0x45, 2, I2C_REG_VOLATILE | I2C_REG_RO> GyroY;
+    typedef I2CReg<0x47, 2, I2C_REG_VOLATILE | I2C_REG_RO> GyroZ;
+
+    typedef I2CReg<0x6B> PowerManagement1;          //invalidate() the device after DeviceReset
+    typedef I2CField<PowerManagement1, 0, 3> ClockSelect;
+    typedef I2CField<PowerManagement1, 6, 1> Sleep;
+    typedef I2CField<PowerManagement1, 7, 1> DeviceReset;
+    typedef I2CReg<0x75, 1, I2C_REG_RO> WhoAmI;     //0x68
+
+    static const uint8_t ACCEL_2G = 0;
+    static const uint8_t ACCEL_4G = 1;
+    static const uint8_t ACCEL_8G = 2;
+    static const uint8_t ACCEL_16G = 3;
+}
+
+/**
+ * Bosch BME280 humidity, pressure and temperature sensor: 20-bit big endian
+ * samples (value >> 4), 16-bit little endian calibration words
+ */
+namespace Bme280{
+    static const uint8_t ADDRESS = 0x76;    //SDO low, 0x77 SDO high
+    static const uint16_t CACHE = 0xF6;     //Configuration up to CONFIG (0 saves the RAM, field writes read first)
+
+    typedef I2CReg<0x88, 2, I2C_REG_LE | I2C_REG_RO> DigT1;   //unsigned
+    typedef I2CReg<0x8A, 2, I2C_REG_LE | I2C_REG_RO> DigT2;   //signed
+    typedef I2CReg<0x8C, 2, I2C_REG_LE | I2C_REG_RO> DigT3;   //signed
+    typedef I2CReg<0xD0, 1, I2C_REG_RO> Id;         //0x60
+    typedef I2CReg<0xE0> Reset;                     //Write 0xB6
+
+    typedef I2CReg<0xF2> CtrlHumidity;
+    typedef I2CField<CtrlHumidity, 0, 3> HumidityOversampling;
+    typedef I2CReg<0xF3, 1, I2C_REG_VOLATILE | I2C_REG_RO> Status;
+    typedef I2CField<Status, 3, 1> Measuring;
+    typedef I2CReg<0xF4> CtrlMeasure;
+    typedef I2CField<CtrlMeasure, 0, 2> Mode;       //MODE_xx
+    typedef I2CField<CtrlMeasure, 2, 3> PressureOversampling;
+    typedef I2CField<CtrlMeasure, 5, 3> TemperatureOversampling;
+    typedef I2CReg<0xF5> Config;
+    typedef I2CField<Config, 2, 3> Filter;
+
+    typedef I2CReg<0xF7, 3, I2C_REG_VOLATILE | I2C_REG_RO> Pressure;     //20-bit raw: value >> 4
+    typedef I2CReg<0xFA, 3, I2C_REG_VOLATILE | I2C_REG_RO> Temperature;  //20-bit raw: value >> 4
+    typedef I2CReg<0xFD, 2, I2C_REG_VOLATILE | I2C_REG_RO> Humidity;
+
+    static const uint8_t MODE_SLEEP = 0;
+    static const uint8_t MODE_FORCED = 1;
+    static const uint8_t MODE_NORMAL = 3;
+}
+
+
+#endif /* PERIPHERALS_I2CDEVICEMAPS_HPP_ */
@@ -12,14 +12,85 @@
 #include <../inc/tm4c1294ncpdt.h>
 #include <Peripherals/Board.hpp>
 #include <Peripherals/I2CMaster.hpp>
+#include <Peripherals/Pin.hpp>
 #include "../driverlib/sysctl.h"
+#include "../driverlib/interrupt.h"
 #include "../driverlib/rom_map.h"
 
-static const uint8_t I2C_SCLIO_B[] = {2, 0, 0, 4, 6, 0, 6, 4, 2, 0}; //SCL Bit, SDA = SCLIO + 1, EXCEPT I2C_2, store SDA2 = SCL2-1
-static const uint8_t I2C_PORT_OFF[] = {GPIO_PORTB_OFF, GPIO_PORTG_OFF, GPIO_PORTL_OFF,
-                                      GPIO_PORTK_OFF, GPIO_PORTK_OFF, GPIO_PORTB_OFF,
-                                      GPIO_PORTA_OFF, GPIO_PORTA_OFF, GPIO_PORTA_OFF,
-                                      GPIO_PORTA_OFF}; //GPIO Base offset
+static const uint8_t I2C_IRQ_N[] = {8, 37, 61, 62, 70, 71, 102, 103, 109, 110}; //NVIC interrupt number
+
+/**
+ * @return true if both pins of every I2C module have the Port Mux 2 function (see GPIO_PIN_AF)
+ */
+static constexpr bool i2cPinsValid(){
+    for(uint8_t i = 0; i < sizeof(I2C_PORT_OFF); i++){
+        if(!gpioHasAF(I2C_PORT_OFF[i], I2C_SCLIO_B[i], 2) || !gpioHasAF(I2C_PORT_OFF[i], I2C_SCLIO_B[i] + 1, 2)) return false;
+    }
+    return true;
+}
+static_assert(i2cPinsValid(), "I2C pin table doesn't match the GPIO alternate functions");
+
+#define I2C_MIMR_IM         0x01    //Master (transaction done) interrupt
+#define I2C_MIMR_CLKIM      0x02    //Clock timeout interrupt
+#define I2C_MIMR_DMARXIM    0x04    //RX DMA complete interrupt
+#define I2C_MIMR_DMATXIM    0x08    //TX DMA complete interrupt
+#define I2C_MIMR_TXIM       0x100   //TX FIFO request (at or below trigger level)
+#define I2C_MIMR_RXIM       0x200   //RX FIFO request (at or above trigger level)
+
+#define I2C_MCS_BURST           0x40    //Burst enable, MBLEN bytes per command
+
+#define I2C_MCS_FIFO_SINGLE     0x46    //Burst, START, STOP: whole MBLEN transfer
+#define I2C_MCS_FIFO_RX_START   0x4A    //Burst, START, ACK: receive MBLEN bytes, hold the bus
+#define I2C_MCS_FIFO_RX_FINISH  0x44    //Burst, STOP: receive MBLEN bytes (last NACKed)
+
+#define I2C_FIFOCTL_DMATXENA    0x00002000
+#define I2C_FIFOCTL_TXFLUSH     0x00004000
+#define I2C_FIFOCTL_DMARXENA    0x20000000
+#define I2C_FIFOCTL_RXFLUSH     0x40000000
+#define I2C_FIFOCTL_TXTRIG      0x00000002  //TX FIFO request with <= 2 bytes
+#define I2C_FIFOCTL_RXTRIG      0x00060000  //RX FIFO request with >= 6 bytes
+
+#define I2C_FIFOSTATUS_TXFF     0x00000002  //TX FIFO full
+#define I2C_FIFOSTATUS_RXFE     0x00010000  //RX FIFO empty
+
+#define I2C_ASYNC_IDLE      0
+#define I2C_ASYNC_WRITE     1
+#define I2C_ASYNC_READ      2   //Receiving first len-1 bytes
+#define I2C_ASYNC_READ_LAST 3   //Receiving last byte
+#define I2C_ASYNC_TRXN_TX   4   //Transaction descriptor, sending
+#define I2C_ASYNC_TRXN_RX   5   //Transaction descriptor, receiving
+#define I2C_ASYNC_TRXN_TX_BURST 6   //Transaction descriptor, sending through TX FIFO
+#define I2C_ASYNC_TRXN_RX_BURST 7   //Transaction descriptor, receiving through RX FIFO
+#define I2C_ASYNC_RECOVERY  8   //Bus recovery, pins driven as GPIOs
+#define I2C_ASYNC_STOP      9   //Next transaction waits for a STOP still going out
+
+#define I2C_MCS_BUSY        0x01    //Controller busy (a command, the STOP of an error)
+#define I2C_MCS_BUSBSY      0x40    //Bus busy (START seen, no STOP yet)
+
+#define I2C_MBMON_SCL       0x01    //SCL line high
+#define I2C_MBMON_SDA       0x02    //SDA line high
+
+
+I2CMaster* I2CMaster::instances[10] = {0};
+
+/**
+ * SCL timer period for a bus frequency at a system clock
+ * SCL period = 2 x (1 + TPR) x (SCL_LP + SCL_HP) system clocks, with SCL_LP + SCL_HP
+ * = 10 in standard, fast and fast plus modes and 3 in high speed mode.
+ * TPR is rounded to nearest and clamped to 1..127, a system clock too slow
+ * for the bus frequency gives the fastest SCL it can make
+ *
+ * @param freq is the bus frequency
+ * @param clock is the system clock
+ * @return MTPR value
+ */
+uint32_t I2CMaster::timerPeriod(uint32_t freq, uint32_t clock){
+    bool hs = freq > 1000000;
+    uint32_t sclClocks = 2 * (hs ? 3 : 10) * freq;
+    uint32_t tpr = (clock + sclClocks / 2) / sclClocks;
+    tpr = tpr < 2 ? 1 : (tpr > 128 ? 127 : tpr - 1);
+    return tpr | (hs ? I2C_MTPR_HS : 0x00);
+}
 /**
  * Default I2CMaster Constructor
  * I2C0 selected, 100kHz
@@ -28,6 +99,15 @@ I2CMaster::I2CMaster(){
     I2Cx = 0;
     freq = 100000;
     mode = 0;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    retryCount = I2C_RETRY_COUNT;
+    retryBackoffUs = I2C_RETRY_BACKOFF_US;
+    dmaRxCh = UDMA_NO_CHANNEL;  dmaTxCh = UDMA_NO_CHANNEL;
+    asyncState = I2C_ASYNC_IDLE;
+    trxn = 0;
+    busHeld = false;
+    queueLen = 0;
+    clearQueueStats();
     open();
 }
 
@@ -40,6 +120,15 @@ I2CMaster::I2CMaster(uint32_t speed, uint8_t i2cx){
     I2Cx = i2cx;
     freq = speed;
     mode = 0;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    retryCount = I2C_RETRY_COUNT;
+    retryBackoffUs = I2C_RETRY_BACKOFF_US;
+    dmaRxCh = UDMA_NO_CHANNEL;  dmaTxCh = UDMA_NO_CHANNEL;
+    asyncState = I2C_ASYNC_IDLE;
+    trxn = 0;
+    busHeld = false;
+    queueLen = 0;
+    clearQueueStats();
     open();
 }
 
@@ -57,13 +146,13 @@ void I2CMaster::setAddress(uint8_t addr){
  * Must be called before write or read attempts
  */
 void I2CMaster::open(){
-    if(I2Cx > 9  || !assertValidI2CSpeed()){
+    if(I2Cx > 9  || !validSpeed(freq)){
         mode = 1;
         return;
     }
 
-    PORT_R = (uint32_t*)(GPIO_PORT_BASE + (I2C_PORT_OFF[I2Cx] << 12)); //Set pointer to GPIO Port Base Register
-    I2C_R = (uint32_t*)(GET_I2C_BASE_R(I2Cx) + (I2Cx << 12)); //Get I2Cx Base Register
+    PORT_R = HWREG_PTR(GPIO_PORT_BASE + (I2C_PORT_OFF[I2Cx] << 12)); //Set pointer to GPIO Port Base Register
+    I2C_R = HWREG_PTR(I2C_MODULE_BASE(I2Cx)); //Get I2Cx Base Register (4 modules per block)
     I2C_STATUS_R = I2C_R + (0x004 >> 2);
 
     SYSCTL_RCGCI2C_R |= (1 << I2Cx); //Enable I2Cx clock
@@ -87,37 +176,75 @@ void I2CMaster::open(){
     *(PORT_R + (0x51C >> 2)) |= 0x03 << I2C_SCLIO_B[I2Cx];         //Enable SDA,SCL Pins
 
     *(I2C_R + (0x020 >> 2)) |= 0x10; //Set I2C as Master or Slave
-    *(I2C_R + (0x00C >> 2)) = ((CPU_FREQUENCY/(20*freq) -1) & 0x7F) | (freq <= 1000000 ? 0x00 : 0x80); //Set SCL Speed TPR Val
+    *(I2C_R + (0x00C >> 2)) = timerPeriod(freq, systemClock());  //Set SCL Speed TPR Val
+
+    mode = 0;
+    enableCycleCounter();           //Queue wait time stats
+    instances[I2Cx] = this;         //Route I2Cx interrupt to this instance
+    Clock::subscribe(onClockChange);
+    uint8_t irq = I2C_IRQ_N[I2Cx];
+    *(&NVIC_EN0_R + (irq >> 5)) = 1 << (irq & 0x1F); //Enable NVIC I2Cx Interrupt
 }
 
-//!TODO
 /**
- * Close the I2C selected bus
- * Must be called for free reserved I2Cx GPIOs
+ * I2CMaster destructor, the I2Cx interrupt and the clock switches stop using this instance
  */
-void I2CMaster::close(){
-    if(mode) return;
+I2CMaster::~I2CMaster(){
+    if(I2Cx <= 9 && instances[I2Cx] == this) instances[I2Cx] = 0;
 }
 
 /**
- * Private: Get I2C transaction result
+ * Private: system clock switch listener (see Clock)
+ * The SCL timer period is reprogrammed before a switch to a faster clock and
+ * after a switch to a slower one, so SCL is never faster than the bus speed.
+ * Transfers in flight continue, bits meanwhile are only slower
  *
- * @param stopIfError if true, generate stop condition if error detected
- * @return I2C_WRITE_ERROR if transaction failed, otherwise I2C_WRITE_OK
- */
-uint8_t I2CMaster::I2CTransactionResult(bool stopIfError){
-    MAP_SysCtlDelay(100); //!TODO change delay
-    while(((*I2C_STATUS_R) & 0x01) != 0); //Wait until controller idle
-    //Check Error bit
-    if(((*I2C_STATUS_R) & 0x02) != 0){ //Error found
-        if(stopIfError && (((*I2C_STATUS_R) & 0x10) == 0)){ //I2C Controller won arbitration
-            *I2C_STATUS_R = 0x04; //Generate stop condition
-        }
-        return I2C_WRITE_ERROR;
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+void I2CMaster::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    if((phase == CLOCK_PRE_CHANGE) != (newFreq > oldFreq)) return;
+    for(uint8_t i = 0; i <= 9; i++){
+        I2CMaster* bus = instances[i];
+        if(bus != 0) *(bus->I2C_R + (0x00C >> 2)) = timerPeriod(bus->freq, newFreq);
     }
-    return I2C_WRITE_OK;
 }
 
+/**
+ * Close the I2C selected bus
+ * Queued transactions and the one in progress end with I2C_BUSY (a STOP is sent),
+ * the module is powered off and SDA, SCL are returned to GPIO inputs.
+ * open() starts the bus again
+ */
+void I2CMaster::close(){
+    if(mode) return;
+    if(asyncState == I2C_ASYNC_WRITE || asyncState == I2C_ASYNC_READ || asyncState == I2C_ASYNC_READ_LAST){
+        *I2C_STATUS_R = 0x04;   //Generate stop condition
+        endAsync(I2C_BUSY);
+    }
+    while(queueLen != 0 || trxn != 0){ //Waiting ones first, so none starts
+        cancel(queueLen != 0 ? queue[0] : trxn, I2C_BUSY);
+    }
+    asyncState = I2C_ASYNC_IDLE;    //A STOP wait or a recovery won't get its end
+    busHeld = false;
+    trxn = 0;
+
+    uint8_t irq = I2C_IRQ_N[I2Cx];
+    *(&NVIC_DIS0_R + (irq >> 5)) = 1 << (irq & 0x1F); //Disable NVIC I2Cx Interrupt
+    *(I2C_R + (0x010 >> 2)) = 0x00;                     //Mask interrupts
+    *(I2C_R + (0x020 >> 2)) = 0x00;                     //Disable master function
+    if(instances[I2Cx] == this) instances[I2Cx] = 0;
+
+    uint8_t pins = 0x03 << I2C_SCLIO_B[I2Cx];
+    *(PORT_R + (0x51C >> 2)) &= ~pins;                          //Disable SDA, SCL Pins
+    *(PORT_R + (0x52C >> 2)) &= ~(0xFF << (I2C_SCLIO_B[I2Cx]<<2)); //Port Mux SDA, SCL to GPIO
+    *(PORT_R + (0x420 >> 2)) &= ~pins;                          //Disable alternative function
+    *(PORT_R + (0x50C >> 2)) &= ~pins;                          //Disable open-drain
+
+    SYSCTL_RCGCI2C_R &= ~(1 << I2Cx); //Disable I2Cx clock
+    mode = 1;
+}
 
 /**
  * Read n bytes from I2C device (address previously saved), and store them in
@@ -126,37 +253,18 @@ uint8_t I2CMaster::I2CTransactionResult(bool stopIfError){
  * @param out_r points the external buffer that store read values
  * @param len is the quantity of bytes to receive
  * @param endRx if true, adds a '\0' value at the end of the buffer
- * @return I2C transaction result
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return I2C transaction result, I2C_DEADLINE if canceled at the deadline
  */
-uint8_t I2CMaster::read(void* out_r, uint8_t len, bool endRx){
+uint8_t I2CMaster::read(void* out_r, uint8_t len, bool endRx, uint64_t deadline){
     if(mode) return I2C_READ_ERROR;
     if(len == 0)return I2C_READ_ERROR;
     uint8_t* out = (uint8_t*)out_r;
 
-    *I2C_R = slaveAddress | 0x01; //Set Slave Address - Receive Mode
-
-    if(len == 1){
-        *I2C_STATUS_R = 0x07; //Init single byte receive
-        if(I2CTransactionResult() != I2C_READ_OK) return I2C_READ_ERROR;
-        *out = (uint8_t)(*(I2C_R + (0x008 >> 2)));
-        return I2C_READ_OK;
-    }else{
-        *I2C_STATUS_R = 0x0B;
-
-        while(1){
-            if(I2CTransactionResult(true) != I2C_READ_OK) return I2C_READ_ERROR;
-            *(out++) = *(I2C_R + (0x008 >> 2)); //Read Rx data byte
-            if(--len > 1){
-                *I2C_STATUS_R = 0x09; //Continue Rx with acknowledge
-            }else break;
-        }
-        *I2C_STATUS_R = 0x05; //End last byte transaction
-
-        if(I2CTransactionResult() != I2C_READ_OK) return I2C_READ_ERROR;
-        *out = (uint8_t)(*(I2C_R + (0x008 >> 2))); //Read last Rx data byte
-        if(endRx) *(out+1) = '\0';
-        return I2C_READ_OK;
-    }
+    I2CTransaction t = {(uint8_t)(slaveAddress >> 1), 0, 0, I2C_PRIORITY_NORMAL, 0, 0, out, len, 0, 0, I2C_BUSY, 0};
+    PrintStatus status = execute(&t, until(deadline));
+    if(status == I2C_READ_OK && endRx) out[len] = '\0';
+    return status;
 }
 
 /**
@@ -166,35 +274,147 @@ uint8_t I2CMaster::read(void* out_r, uint8_t len, bool endRx){
  * @param dev_reg is the command or memory address to read in the external device
  * @param out_r points the external buffer that store read values
  * @param len is the quantity of bytes to receive
- * @return I2C transaction result
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return I2C transaction result, I2C_DEADLINE if canceled at the deadline
  */
-PrintStatus I2CMaster::readFrom(uint8_t dev_reg, void* out_r, uint8_t len){
+PrintStatus I2CMaster::readFrom(uint8_t dev_reg, void* out_r, uint8_t len, uint64_t deadline){
     if(mode)  return I2C_READ_ERROR;
     if(len == 0)return I2C_READ_ERROR;
-    uint8_t* out = (uint8_t*)out_r;
 
-    *I2C_R = slaveAddress; //Set slave address, Tx Mode for subregister
-    *(I2C_R + (0x008 >> 2)) = dev_reg; //Set device register to MDR
-    while(((*I2C_STATUS_R) & 0x40) != 0); //Wait until bus free
-    *I2C_STATUS_R = 0x03; //Init single byte transmit, hold master enable
-    if(I2CTransactionResult() != I2C_READ_OK) return I2C_READ_ERROR;
+    I2CTransaction t = {(uint8_t)(slaveAddress >> 1), I2C_TRXN_REG, dev_reg, I2C_PRIORITY_NORMAL,
+                        0, 0, (uint8_t*)out_r, len, 0, 0, I2C_BUSY, 0};
+    return execute(&t, until(deadline));
+}
 
-    *I2C_R = slaveAddress | 0x01; //Set slave address, Rx Mode
-    *I2C_STATUS_R = 0x0B; //Enable I2C, Start condition, with acknowledge
+/**
+ * Limit the time blocking calls (read, readFrom without deadline, writes and
+ * prints) wait for their transaction, the transaction is canceled (I2C_DEADLINE)
+ * when it passes. The limit applies to each call, from its start
+ *
+ * @param us is the limit in microseconds, TIMEBASE_NO_TIMEOUT (default) to wait forever
+ */
+void I2CMaster::setTimeout(uint32_t us){
+    timeoutUs = us;
+}
 
-    while(1){
-        if(I2CTransactionResult(true) != I2C_READ_OK) return I2C_READ_ERROR;
+/**
+ * Retry blocking calls (read, readFrom, writes and prints) whose transaction
+ * ended with I2C_ADDR_NACK (device busy), I2C_ARB_LOST or I2C_TIMEOUT.
+ * The wait before each retry doubles, a retry that would start after the call
+ * deadline isn't made. Submitted transactions aren't retried
+ *
+ * @param count is the number of retries after the first attempt, 0 disables them
+ * @param backoffUs is the wait before the first retry in microseconds
+ */
+void I2CMaster::setRetry(uint8_t count, uint32_t backoffUs){
+    retryCount = count;
+    retryBackoffUs = backoffUs;
+}
 
-        *(out++) = *(I2C_R + (0x008 >> 2)); //Read Rx data byte
-        if(--len > 1){
-            *I2C_STATUS_R = 0x09; //Continue Rx with acknowledge
-        }else break;
+/**
+ * Free a bus a slave holds (SDA low, e.g. after a reset in the middle of a read):
+ * SCL and SDA are switched to open-drain GPIOs, SCL is pulsed (up to 9 clocks)
+ * until the slave releases SDA, a STOP is sent and the module is reset.
+ * Blocking calls recover the bus by themselves after a clock timeout or with SDA
+ * held low. Busy waits about 100 us
+ *
+ * @return OK if SDA was released, I2C_BUS_STUCK if it stays low,
+ *      I2C_BUSY if a transfer is in progress, ERROR if bus not opened
+ */
+PrintStatus I2CMaster::recoverBus(){
+    if(mode) return _PRINT_STATUS_ERROR;
+    bool wasDisabled = MAP_IntMasterDisable();
+    bool busy = asyncState != I2C_ASYNC_IDLE;
+    if(!busy) asyncState = I2C_ASYNC_RECOVERY;  //Queued transactions wait
+    if(!wasDisabled) MAP_IntMasterEnable();
+    if(busy) return I2C_BUSY;
+
+    uint8_t scl = I2C_SCLIO_B[I2Cx], sda = scl + 1;
+    if(I2Cx == 2){  //SDA2 = SCL2 - 1
+        sda = scl;
+        scl++;
     }
-    *I2C_STATUS_R = 0x05; //End I2C Transaction
+    HwReg* sclPin = PORT_R + (1 << scl);    //GPIODATA masked to a single pin
+    HwReg* sdaPin = PORT_R + (1 << sda);
+    uint8_t pins = (1 << scl) | (1 << sda);
 
-    if(I2CTransactionResult() != I2C_READ_OK) return I2C_READ_ERROR;
-    *out = (uint8_t)(*(I2C_R + (0x008 >> 2))); //Read last Rx data byte
-    return I2C_READ_OK;
+    *sclPin = 0xFF;                         //Released (open-drain high)
+    *sdaPin = 0xFF;
+    *(PORT_R + (0x50C >> 2)) |= pins;       //SCL open-drain too
+    *(PORT_R + (0x400 >> 2)) |= 1 << scl;   //SCL output, SDA input
+    *(PORT_R + (0x420 >> 2)) &= ~pins;      //GPIO function
+
+    for(uint8_t i = 0; i < 9 && *sdaPin == 0; i++){ //Slave shifts out the rest of its byte
+        *sclPin = 0x00;
+        Timebase::delayUs(I2C_RECOVERY_HALF_US);
+        *sclPin = 0xFF;
+        Timebase::delayUs(I2C_RECOVERY_HALF_US);
+    }
+
+    *sclPin = 0x00;                         //STOP: SDA rises while SCL is high
+    *sdaPin = 0x00;
+    *(PORT_R + (0x400 >> 2)) |= 1 << sda;
+    Timebase::delayUs(I2C_RECOVERY_HALF_US);
+    *sclPin = 0xFF;
+    Timebase::delayUs(I2C_RECOVERY_HALF_US);
+    *sdaPin = 0xFF;
+    *(PORT_R + (0x400 >> 2)) &= ~(1 << sda);
+    Timebase::delayUs(I2C_RECOVERY_HALF_US);
+    bool released = *sdaPin != 0;
+
+    *(PORT_R + (0x400 >> 2)) &= ~pins;      //Back to the I2C module
+    *(PORT_R + (0x50C >> 2)) &= ~(1 << scl);
+    *(PORT_R + (0x420 >> 2)) |= pins;
+    resetModule();
+
+    wasDisabled = MAP_IntMasterDisable();
+    stats.recoveries++;
+    busHeld = false;
+    asyncState = I2C_ASYNC_IDLE;
+    startNext();
+    if(!wasDisabled) MAP_IntMasterEnable();
+    return released ? I2C_WRITE_OK : I2C_BUS_STUCK;
+}
+
+/**
+ * Private: reset the I2Cx module (clears its bus busy and error state) and
+ * program it again as master
+ */
+void I2CMaster::resetModule(){
+    SYSCTL_SRI2C_R |= 1 << I2Cx;
+    SYSCTL_SRI2C_R &= ~(1 << I2Cx);
+    while((SYSCTL_PRI2C_R & (1 << I2Cx)) == 0);
+    *(I2C_R + (0x020 >> 2)) = 0x10;                             //Master function
+    *(I2C_R + (0x00C >> 2)) = timerPeriod(freq, systemClock()); //SCL Speed TPR Val
+}
+
+/**
+ * Private: bus line monitor after a failed transaction. The STOP of the error
+ * may still be going out (SDA, SCL legitimately low), the lines are read once
+ * the controller and the bus are idle, or I2C_STOP_WAIT_US later
+ *
+ * @param deadline is the Timebase deadline of the call
+ * @return true if SDA or SCL is held low, false if another transaction took the bus
+ */
+bool I2CMaster::busStuck(uint64_t deadline){
+    uint64_t stopEnd = Timebase::deadline(I2C_STOP_WAIT_US);
+    if(deadline < stopEnd) stopEnd = deadline;
+    while(*I2C_STATUS_R & (I2C_MCS_BUSY | I2C_MCS_BUSBSY)){
+        if(asyncState != I2C_ASYNC_IDLE && asyncState != I2C_ASYNC_STOP) return false;
+        if(Timebase::expired(stopEnd)) break;
+        BOARD_WAIT();
+    }
+    return (*(I2C_R + (0x02C >> 2)) & (I2C_MBMON_SCL | I2C_MBMON_SDA)) != (I2C_MBMON_SCL | I2C_MBMON_SDA);
+}
+
+/**
+ * Private: deadline of a blocking call
+ * @param deadline is the caller deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return the deadline to wait for, Timer1 isn't used without a limit
+ */
+uint64_t I2CMaster::until(uint64_t deadline){
+    if(deadline != TIMEBASE_FOREVER || timeoutUs == TIMEBASE_NO_TIMEOUT) return deadline;
+    return Timebase::deadline(timeoutUs);
 }
 
 /**
@@ -205,24 +425,7 @@ PrintStatus I2CMaster::readFrom(uint8_t dev_reg, void* out_r, uint8_t len){
  * @return I2C Transaction result
  */
 PrintStatus I2CMaster::write(uint8_t data, uint8_t flags){
-    if(mode) return I2C_WRITE_ERROR;
-
-    //Single byte transaction
-    if((flags & PRINT_WR_MODE) == PRINT_WR_MOD_SINGLE){
-        *I2C_R = slaveAddress;          //Set Slave Address - Transmit
-        *(I2C_R + (0x008 >> 2)) = data; //Set Desired data to MDR
-        *I2C_STATUS_R = 0x07;           //Init single byte transmit
-        return I2CTransactionResult();
-    }
-
-    //Multiple bytes transaction mode
-    if(flags & PRINT_WR_START){     //First byte in transaction?
-        *I2C_R = slaveAddress;      //Then Set Slave Address - Transmit Mode
-    }
-    *(I2C_R + (0x008 >> 2)) = data; //Set Desired data to MDR
-    *I2C_STATUS_R = flags & PRINT_WR_CTL; //Set transaction
-
-    return I2CTransactionResult((flags & PRINT_WR_STOP) != PRINT_WR_STOP);
+    return write((const char*)&data, 1, flags);
 }
 
 /**
@@ -232,37 +435,656 @@ PrintStatus I2CMaster::write(uint8_t data, uint8_t flags){
  * @param n is the number of the bytes to write
  *       if n < 0, write until a 0 is found in the array
  * @param flags specifies the transaction state (START, CONTINUE, STOP)
- * @return I2C Transaction result
+ * @return I2C Transaction result, I2C_DEADLINE if the setTimeout time passed
  */
 PrintStatus I2CMaster::write(const char* txt, int n, uint8_t flags){
     if(mode) return _PRINT_STATUS_ERROR;
-    if((*txt == 0 && n < 0) || n == 0)   return write(0, flags);        //Length 0 string
-    if((*(txt+1) == 0 && n < 0) || n == 1) return write(*(txt), flags); //Length 1 string
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    if(n < 0){  //Length of the string
+        n = 0;
+        while(txt[n]) n++;
+    }
+    if(n == 0)  return write((uint8_t)0, flags); //Length 0 string, send a 0
 
-    uint8_t count = 0;
-    PrintStatus status = write(*(txt++), flags & ~PRINT_WR_STOP); //Prevent stop, since length >= 2
+    I2CTransaction t = {(uint8_t)(slaveAddress >> 1), 0, 0, I2C_PRIORITY_NORMAL, (const uint8_t*)txt, 0, 0, 0, 0, 0, I2C_BUSY, 0};
+    if((flags & PRINT_WR_MODE) == PRINT_WR_MOD_MULTIPLE){
+        if((flags & PRINT_WR_START) == 0) t.flags |= I2C_TRXN_NO_START;
+        if((flags & PRINT_WR_STOP) == 0) t.flags |= I2C_TRXN_NO_STOP;
+    }
 
-    flags &= ~PRINT_WR_START; //Start condition handled, remove it
+    //Longer than a descriptor allows, send it as a held transaction
+    uint8_t lastFlags = t.flags;
+    while(n > 0xFFFF){
+        t.flags = lastFlags | I2C_TRXN_NO_STOP;
+        t.txLen = 0xFFFF;
+        PrintStatus status = execute(&t, deadline);
+        if(status != I2C_WRITE_OK) return status;
+        t.tx += 0xFFFF;
+        n -= 0xFFFF;
+        lastFlags |= I2C_TRXN_NO_START;
+    }
+    t.flags = lastFlags;
+    t.txLen = (uint16_t)n;
+    return execute(&t, deadline);
+}
 
-    while((n < 0 && *txt) || count < n){
-        if(status &_PRINT_STATUS_ERROR) return status;
-        if(((n < 0) && (*(txt+1) == 0)) || (count == n-1)){ //Is Last byte?
-            status = write(*txt, flags);
-        }else{  //Prevent stop transaction, since isn't last byte
-            status = write(*txt, flags & ~PRINT_WR_STOP);
+/**
+ * Queue a transaction and return without waiting, it runs from the I2Cx interrupt
+ * Queued transactions run back to back, by priority (FIFO for equal priority)
+ * A transaction with tx and rx bytes uses a repeated START between them
+ *
+ * A NO_START transaction continues the bus held by a NO_STOP one, which must
+ * have ended OK, be running or be queued ahead of it
+ *
+ * @param t is the transaction descriptor, must stay valid until t->status != I2C_BUSY
+ *      (or the callback is called)
+ * @return BUSY if the queue is full, ERROR if bus not opened, empty transaction
+ *      or NO_START without a held bus, otherwise OK (transaction queued or started)
+ */
+PrintStatus I2CMaster::submit(I2CTransaction* t){
+    if(mode || t == 0 || (t->txLen == 0 && t->rxLen == 0 && (t->flags & I2C_TRXN_REG) == 0)) return I2C_WRITE_ERROR;
+
+    bool wasDisabled = MAP_IntMasterDisable();
+    if((t->flags & I2C_TRXN_NO_START) && !busHeld && !holderPending()){
+        if(!wasDisabled) MAP_IntMasterEnable();
+        return I2C_WRITE_ERROR;     //Nothing to continue, it would be sent without START and address
+    }
+    if(queueLen == I2C_QUEUE_SIZE){
+        stats.rejected++;
+        if(!wasDisabled) MAP_IntMasterEnable();
+        return I2C_BUSY;
+    }
+
+    t->status = I2C_BUSY;
+    t->queuedAt = CYCLE_COUNT();
+    uint8_t i = queueLen++;
+    while(i > 0 && queue[i - 1]->priority < t->priority){ //Insert after equal or higher priority
+        queue[i] = queue[i - 1];
+        i--;
+    }
+    queue[i] = t;
+    stats.submitted++;
+    if(queueLen > stats.maxDepth) stats.maxDepth = queueLen;
+
+    startNext();
+    if(!wasDisabled) MAP_IntMasterEnable();
+    return I2C_WRITE_OK;
+}
+
+/**
+ * Run a transaction and wait until it ends, as the other blocking calls
+ * (setTimeout limit, setRetry retries, bus recovery). The slave address is the
+ * descriptor one, so devices sharing the bus don't need setAddress
+ *
+ * @param t is the transaction descriptor, its callback is called as with submit
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return transaction result, ERROR if bus not opened or empty transaction
+ */
+PrintStatus I2CMaster::transfer(I2CTransaction* t, uint64_t deadline){
+    if(mode) return _PRINT_STATUS_ERROR;
+    return execute(t, until(deadline));
+}
+
+/**
+ * Remove a submitted transaction from the queue, or stop it with a STOP
+ * condition if it is on the bus. Its callback is called with status
+ *
+ * @param t is the transaction descriptor
+ * @param status is the transaction result to report (default I2C_DEADLINE)
+ * @return false if the transaction already ended (or wasn't submitted)
+ */
+bool I2CMaster::cancel(I2CTransaction* t, PrintStatus status){
+    if(mode || t == 0) return false;
+    bool wasDisabled = MAP_IntMasterDisable();
+    bool found = false;
+    if(trxn == t){
+        found = true;
+        if(asyncState == I2C_ASYNC_TRXN_TX_BURST || asyncState == I2C_ASYNC_TRXN_RX_BURST){
+            *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH; //Drop the burst bytes left
+            *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXTRIG | I2C_FIFOCTL_RXTRIG;
+            *(I2C_R + (0x030 >> 2)) = 0;    //Burst ends after the byte on the bus
+        }
+        *I2C_STATUS_R = 0x04;   //STOP, leaves the bus free for the next transaction
+        endTransaction(status); //Starts the next one
+    }else{
+        for(uint8_t i = 0; i < queueLen && !found; i++){
+            if(queue[i] != t) continue;
+            found = true;
+            failQueued(i, status);
         }
-        count++; txt++;
     }
+    if(!wasDisabled) MAP_IntMasterEnable();
+    return found;
+}
 
-    return status;
+/**
+ * @return transaction queue statistics
+ */
+const I2CQueueStats& I2CMaster::queueStats(){
+    stats.depth = queueLen;
+    return stats;
+}
+
+/**
+ * Reset transaction queue statistics
+ */
+void I2CMaster::clearQueueStats(){
+    stats.submitted = 0;    stats.rejected = 0;
+    stats.depth = 0;        stats.maxDepth = 0;
+    stats.started = 0;      stats.maxWait = 0;
+    stats.totalWait = 0;
+    stats.retries = 0;      stats.recoveries = 0;
+}
+
+/**
+ * Private: check if a NO_STOP transaction that will hold the bus is running or queued
+ * @return true if a NO_START transaction submitted now can continue a held bus
+ */
+bool I2CMaster::holderPending(){
+    if(trxn != 0 && (trxn->flags & I2C_TRXN_NO_STOP)) return true;
+    for(uint8_t i = 0; i < queueLen; i++){
+        if(queue[i]->flags & I2C_TRXN_NO_STOP) return true;
+    }
+    return false;
+}
+
+/**
+ * Private: remove a queued transaction and end it without running it
+ * @param i is the queue index
+ * @param status is the transaction result, given to its callback
+ */
+void I2CMaster::failQueued(uint8_t i, PrintStatus status){
+    I2CTransaction* t = queue[i];
+    for(queueLen--; i < queueLen; i++){
+        queue[i] = queue[i + 1];
+    }
+    t->status = status;
+    if(t->callback) t->callback(status, t->arg);    //May submit (and start) the next one
+}
+
+/**
+ * Private: start the first queued transaction if the module is free
+ * While the bus is held (NO_STOP), only a NO_START transaction can continue it.
+ * A NO_START transaction reaching the free bus (its NO_STOP one failed) ends with ERROR.
+ * If a STOP (after an error or a cancel) is still going out, the transaction
+ * starts from the interrupt of its end (see handleInterrupt)
+ * Called with interrupts disabled or from the I2Cx interrupt
+ */
+void I2CMaster::startNext(){
+    while(!busHeld && asyncState == I2C_ASYNC_IDLE && queueLen != 0 && (queue[0]->flags & I2C_TRXN_NO_START)){
+        failQueued(0, I2C_WRITE_ERROR);
+    }
+    if(asyncState != I2C_ASYNC_IDLE || queueLen == 0) return;
+
+    uint8_t i = 0;
+    if(busHeld){
+        while(i < queueLen && (queue[i]->flags & I2C_TRXN_NO_START) == 0) i++;
+        if(i == queueLen) return;
+    }else if(*I2C_STATUS_R & 0x01){ //Commands are ignored until the STOP ends
+        asyncState = I2C_ASYNC_STOP;
+        *(I2C_R + (0x024 >> 2)) = I2C_CLK_TIMEOUT;              //SCL held low: clock timeout
+        *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_CLKIM;
+        return;
+    }
+
+    I2CTransaction* t = queue[i];
+    for(queueLen--; i < queueLen; i++){
+        queue[i] = queue[i + 1];
+    }
+
+    uint32_t wait = CYCLE_COUNT() - t->queuedAt;
+    stats.started++;
+    stats.totalWait += wait;
+    if(wait > stats.maxWait) stats.maxWait = wait;
+
+    startTransaction(t);
+}
+
+/**
+ * Private: program the module and send the first command of a transaction
+ * @param t is the transaction descriptor
+ */
+void I2CMaster::startTransaction(I2CTransaction* t){
+    trxn = t;
+    trxnIdx = 0;
+    *(I2C_R + (0x01C >> 2)) = 0xFFF;                        //Clear stale interrupts
+    *(I2C_R + (0x024 >> 2)) = I2C_CLK_TIMEOUT;              //SCL low timeout
+    *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_CLKIM;
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH; //Empty FIFOs, both assigned to master
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXTRIG | I2C_FIFOCTL_RXTRIG;
+
+    if(t->txLen != 0 || (t->flags & I2C_TRXN_REG)){
+        trxnStep();
+    }else{
+        trxnStartRx();
+    }
+}
+
+/**
+ * Private: run a transaction of a blocking call, retrying transient errors
+ * (see setRetry). The bus is recovered after a clock timeout or when a line
+ * stays low after an error
+ *
+ * @param t is the transaction descriptor
+ * @param deadline is the Timebase deadline, the transaction is canceled when it passes
+ * @return transaction result, I2C_BUS_STUCK if the bus couldn't be recovered
+ */
+PrintStatus I2CMaster::execute(I2CTransaction* t, uint64_t deadline){
+    uint32_t backoff = retryBackoffUs;
+    for(uint8_t n = 0; ; n++){
+        PrintStatus status = attempt(t, deadline);
+        bool transient = status == I2C_ADDR_NACK || status == I2C_ARB_LOST || status == I2C_TIMEOUT;
+        if(!transient) return status;
+
+        if((status == I2C_TIMEOUT || busStuck(deadline)) && recoverBus() == I2C_BUS_STUCK) return I2C_BUS_STUCK;
+        //A held bus was lost, the transaction can't be continued
+        if(n >= retryCount || (t->flags & I2C_TRXN_NO_START)) return status;
+        if(deadline != TIMEBASE_FOREVER && Timebase::now() + backoff >= deadline) return status;
+
+        stats.retries++;
+        Timebase::delayUs(backoff);
+        backoff = backoff > I2C_RETRY_BACKOFF_MAX / 2 ? I2C_RETRY_BACKOFF_MAX : 2 * backoff;
+    }
+}
+
+/**
+ * Private: queue a transaction and wait until it ends
+ * If the I2Cx interrupt can't be taken (interrupts disabled or called from an
+ * interrupt handler), the transaction is serviced here by polling
+ *
+ * @param t is the transaction descriptor
+ * @param deadline is the Timebase deadline, the transaction is canceled when it passes
+ * @return transaction result
+ */
+PrintStatus I2CMaster::attempt(I2CTransaction* t, uint64_t deadline){
+    PROBE_SCOPE(PROBE_I2C_TRXN);
+    bool masked = MAP_IntMasterDisable();
+    if(!masked) MAP_IntMasterEnable();
+    bool polled = masked || (NVIC_INT_CTRL_R & NVIC_INT_CTRL_VEC_ACT_M) != 0;
+
+    PrintStatus status;
+    while((status = submit(t)) == I2C_BUSY){ //Queue full, wait for room
+        if(Timebase::expired(deadline)) return I2C_DEADLINE;
+        if(polled && *(I2C_R + (0x018 >> 2)) != 0) handleInterrupt();
+        BOARD_WAIT();
+    }
+    if(status != I2C_WRITE_OK) return status;
+
+    while(t->status == I2C_BUSY){
+        if(Timebase::expired(deadline)) cancel(t);  //Ended meanwhile if it returns false
+        if(polled && *(I2C_R + (0x018 >> 2)) != 0) handleInterrupt();
+        BOARD_WAIT();
+    }
+    return t->status;
+}
+
+/**
+ * Private: start the transaction receive part (START or repeated START)
+ * Uses FIFO bursts unless the transaction receives a single byte or I2C_TRXN_NO_BURST
+ */
+void I2CMaster::trxnStartRx(){
+    trxnIdx = 0;
+    *I2C_R = (trxn->address << 1) | 0x01;   //Set Slave Address - Receive Mode
+    if(trxn->rxLen >= I2C_BURST_MIN && (trxn->flags & I2C_TRXN_NO_BURST) == 0){
+        asyncState = I2C_ASYNC_TRXN_RX_BURST;
+        trxnRxBurst();
+    }else{
+        asyncState = I2C_ASYNC_TRXN_RX;
+        trxnCommand(trxn->rxLen > 1 ? 0x0B : 0x07); //START, RUN and ACK, or NACK and STOP if single byte
+    }
+}
+
+/**
+ * Private: start the next receive burst (up to 255 bytes)
+ * Bytes are ACKed except the last one of the transaction, which is NACKed before STOP
+ */
+void I2CMaster::trxnRxBurst(){
+    uint16_t left = trxn->rxLen - trxnIdx;
+    uint8_t len = left > 255 ? 255 : (uint8_t)left;
+    uint8_t cmd = I2C_MCS_BURST;
+    if(trxnIdx == 0) cmd |= 0x02;               //START
+    cmd |= len == left ? 0x04 : 0x08;           //Last burst STOP, otherwise ACK all
+
+    trxnBurstEnd = trxnIdx + len;
+    *(I2C_R + (0x030 >> 2)) = len;              //Burst length
+    *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_CLKIM | I2C_MIMR_RXIM;
+    trxnCommand(cmd);
+}
+
+/**
+ * Private: move received bytes from the RX FIFO to the rx buffer
+ */
+void I2CMaster::trxnDrain(){
+    while(trxnIdx < trxn->rxLen && (*(I2C_R + (0xF08 >> 2)) & I2C_FIFOSTATUS_RXFE) == 0){
+        trxn->rx[trxnIdx++] = (uint8_t)(*(I2C_R + (0xF00 >> 2)));
+    }
+}
+
+/**
+ * Private: move bytes of the current burst to the TX FIFO until it is full
+ */
+void I2CMaster::trxnFill(){
+    while(trxnIdx < trxnBurstEnd && (*(I2C_R + (0xF08 >> 2)) & I2C_FIFOSTATUS_TXFF) == 0){
+        *(I2C_R + (0xF00 >> 2)) = trxnTxByte(trxnIdx++);
+    }
+    //Every byte of the burst queued, stop FIFO requests
+    *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_CLKIM | (trxnIdx < trxnBurstEnd ? I2C_MIMR_TXIM : 0);
+}
+
+/**
+ * Private: get a byte to send, the reg byte comes first if I2C_TRXN_REG
+ * @param i is the byte index (reg included)
+ * @return the byte
+ */
+inline uint8_t I2CMaster::trxnTxByte(uint16_t i){
+    if(trxn->flags & I2C_TRXN_REG){
+        return i == 0 ? trxn->reg : trxn->tx[i - 1];
+    }
+    return trxn->tx[i];
+}
+
+/**
+ * Private: send the next transaction byte or burst, or move to the receive part, or end
+ * Uses FIFO bursts (up to 255 bytes each) unless a single byte is sent or I2C_TRXN_NO_BURST
+ */
+void I2CMaster::trxnStep(){
+    I2CTransaction* t = trxn;
+    uint16_t txCount = t->txLen + ((t->flags & I2C_TRXN_REG) ? 1 : 0);
+    if(trxnIdx < txCount){
+        bool burst = txCount >= I2C_BURST_MIN && (t->flags & I2C_TRXN_NO_BURST) == 0;
+        uint16_t end = burst ? (txCount - trxnIdx > 255 ? trxnIdx + 255 : txCount) : trxnIdx + 1;
+
+        uint8_t cmd = burst ? I2C_MCS_BURST : 0x01; //BURST or RUN
+        if(trxnIdx == 0){
+            *I2C_R = t->address << 1;   //Set Slave Address - Transmit Mode
+            if((t->flags & I2C_TRXN_NO_START) == 0) cmd |= 0x02;
+        }
+        if(end == txCount && t->rxLen == 0 && (t->flags & I2C_TRXN_NO_STOP) == 0){
+            cmd |= 0x04; //Last byte, STOP
+        }
+
+        if(burst){
+            asyncState = I2C_ASYNC_TRXN_TX_BURST;
+            trxnBurstEnd = end;
+            *(I2C_R + (0x030 >> 2)) = end - trxnIdx;    //Burst length
+            trxnFill();                          //First 8 bytes, rest on FIFO requests
+        }else{
+            asyncState = I2C_ASYNC_TRXN_TX;
+            *(I2C_R + (0x008 >> 2)) = trxnTxByte(trxnIdx++);
+        }
+        trxnCommand(cmd);
+    }else if(t->rxLen != 0){
+        trxnStartRx();
+    }else{
+        endTransaction(I2C_WRITE_OK);
+    }
+}
+
+/**
+ * Private: write a command to MCS, remembering it for error handling
+ * @param cmd is the MCS command
+ */
+void I2CMaster::trxnCommand(uint8_t cmd){
+    trxnCmd = cmd;
+    *I2C_STATUS_R = cmd;
+}
+
+/**
+ * Private: transaction interrupt, a byte or burst was sent or received,
+ * a FIFO needs service or the clock timed out
+ * @param mis is the masked interrupt status
+ */
+void I2CMaster::trxnInterrupt(uint32_t mis){
+    uint32_t mcs = *I2C_STATUS_R;
+    if((mis & I2C_MIMR_CLKIM) || (mcs & 0x80)){ //Clock timeout
+        endTransaction(I2C_TIMEOUT);
+        return;
+    }
+
+    if(asyncState == I2C_ASYNC_TRXN_TX_BURST && (mis & I2C_MIMR_TXIM)){
+        trxnFill();
+    }
+    if(asyncState == I2C_ASYNC_TRXN_RX_BURST && (mis & (I2C_MIMR_RXIM | I2C_MIMR_IM))){
+        trxnDrain();
+    }
+    if((mis & I2C_MIMR_IM) == 0) return;
+
+    if(mcs & 0x02){ //Error found
+        PrintStatus status = errorStatus(mcs);
+        if((mcs & 0x10) == 0 && (trxnCmd & 0x04) == 0){ //I2C Controller won arbitration, no STOP sent
+            *I2C_STATUS_R = trxnCmd & I2C_MCS_BURST ? I2C_MCS_BURST | 0x04 : 0x04; //Generate stop condition
+        }
+        endTransaction(status);
+        return;
+    }
+
+    switch(asyncState){
+        case I2C_ASYNC_TRXN_TX: case I2C_ASYNC_TRXN_TX_BURST:{
+            trxnStep();
+        }break;
+        case I2C_ASYNC_TRXN_RX_BURST:{
+            if(trxnIdx < trxn->rxLen){
+                trxnRxBurst();
+            }else{
+                endTransaction(I2C_READ_OK);
+            }
+        }break;
+        default:{
+            trxn->rx[trxnIdx++] = (uint8_t)(*(I2C_R + (0x008 >> 2))); //Read Rx data byte
+            uint16_t left = trxn->rxLen - trxnIdx;
+            if(left == 0){
+                endTransaction(I2C_READ_OK);
+            }else{
+                trxnCommand(left > 1 ? 0x09 : 0x05); //Continue Rx with acknowledge, or last byte and STOP
+            }
+        }break;
+    }
+}
+
+/**
+ * Private: finish the running transaction, notify the user and start the next one
+ * @param status is the transaction result
+ */
+void I2CMaster::endTransaction(PrintStatus status){
+    I2CTransaction* t = trxn;
+    *(I2C_R + (0x010 >> 2)) = 0x00; //Mask interrupts
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH; //Drop unsent burst bytes
+    busHeld = status == I2C_WRITE_OK && t->rxLen == 0 && (t->flags & I2C_TRXN_NO_STOP) != 0;
+    trxn = 0;
+    asyncState = I2C_ASYNC_IDLE;    //Free before callback, so it can submit the next one
+    t->status = status;
+    if(t->callback) t->callback(status, t->arg);
+    startNext();
+}
+
+/**
+ * Select the uDMA channels used by writeAsync and readAsync
+ * (see TM4C1294 datasheet uDMA channel assignments table for I2Cx RX/TX)
+ *
+ * @param rxCh is the uDMA channel for I2Cx RX (UDMA_NO_CHANNEL disables readAsync)
+ * @param rxEnc is the channel map encoding for I2Cx RX
+ * @param txCh is the uDMA channel for I2Cx TX (UDMA_NO_CHANNEL disables writeAsync)
+ * @param txEnc is the channel map encoding for I2Cx TX
+ */
+void I2CMaster::setDmaChannels(uint8_t rxCh, uint8_t rxEnc, uint8_t txCh, uint8_t txEnc){
+    dmaRxCh = rxCh; dmaRxEnc = rxEnc;
+    dmaTxCh = txCh; dmaTxEnc = txEnc;
+}
+
+/**
+ * Send a buffer to the I2C device (address previously saved) in a single burst,
+ * with the uDMA feeding the I2C TX FIFO. Returns without waiting
+ *
+ * @param buf is the data to send, must stay valid until the transfer completes
+ * @param len is the quantity of bytes to send (1 to 255)
+ * @param callback is called from the I2C interrupt when the transaction ends (optional)
+ * @param arg is passed to the callback
+ * @return BUSY if a transfer is in progress or the channel is in use,
+ *      ERROR if bus not opened or no TX channel selected
+ */
+PrintStatus I2CMaster::writeAsync(const void* buf, uint8_t len, TransferCallback callback, void* arg){
+    if(mode || len == 0 || dmaTxCh == UDMA_NO_CHANNEL) return I2C_WRITE_ERROR;
+    if(asyncState != I2C_ASYNC_IDLE) return _PRINT_STATUS_BUSY;
+    if(!UDMA::claim(dmaTxCh, dmaTxEnc, this, onDmaError)) return _PRINT_STATUS_BUSY;
+
+    asyncCb = callback; asyncArg = arg;
+    asyncBusDone = false;   asyncDmaDone = false;
+    asyncState = I2C_ASYNC_WRITE;
+
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH; //Empty FIFOs, both assigned to master
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_DMATXENA | 0x04;  //TX FIFO requests uDMA while <= 4 bytes
+    *(I2C_R + (0x01C >> 2)) = 0xFFF;                        //Clear stale interrupts
+    *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_DMATXIM;
+    *I2C_R = slaveAddress;                                  //Set Slave Address - Transmit
+    *(I2C_R + (0x030 >> 2)) = len;                          //Burst length
+    UDMA::transfer(dmaTxCh, buf, I2C_R + (0xF00 >> 2), len, UDMA_CTL_MEM_TO_PERIPH | UDMA_CTL_ARB_1);
+    *I2C_STATUS_R = I2C_MCS_FIFO_SINGLE;                    //START, len bytes, STOP
+    return I2C_WRITE_OK;
+}
+
+/**
+ * Receive a buffer from the I2C device (address previously saved) in a burst,
+ * with the uDMA emptying the I2C RX FIFO. Returns without waiting
+ *
+ * @param buf is the destination buffer, must stay valid until the transfer completes
+ * @param len is the quantity of bytes to receive (1 to 255)
+ * @param callback is called from the I2C interrupt when the transaction ends (optional)
+ * @param arg is passed to the callback
+ * @return BUSY if a transfer is in progress or the channel is in use,
+ *      ERROR if bus not opened or no RX channel selected
+ */
+PrintStatus I2CMaster::readAsync(void* buf, uint8_t len, TransferCallback callback, void* arg){
+    if(mode || len == 0 || dmaRxCh == UDMA_NO_CHANNEL) return I2C_READ_ERROR;
+    if(asyncState != I2C_ASYNC_IDLE) return _PRINT_STATUS_BUSY;
+    if(!UDMA::claim(dmaRxCh, dmaRxEnc, this, onDmaError)) return _PRINT_STATUS_BUSY;
+
+    asyncCb = callback; asyncArg = arg;
+    asyncBusDone = false;   asyncDmaDone = false;
+    asyncState = len == 1 ? I2C_ASYNC_READ_LAST : I2C_ASYNC_READ;
+
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH;
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_DMARXENA | (0x01 << 16); //RX FIFO requests uDMA with >= 1 byte
+    *(I2C_R + (0x01C >> 2)) = 0xFFF;
+    *(I2C_R + (0x010 >> 2)) = I2C_MIMR_IM | I2C_MIMR_DMARXIM;
+    *I2C_R = slaveAddress | 0x01;                           //Set Slave Address - Receive
+    UDMA::transfer(dmaRxCh, I2C_R + (0xF00 >> 2), buf, len, UDMA_CTL_PERIPH_TO_MEM | UDMA_CTL_ARB_1);
+    if(len == 1){
+        *(I2C_R + (0x030 >> 2)) = 1;
+        *I2C_STATUS_R = I2C_MCS_FIFO_SINGLE;                //START, 1 byte NACK, STOP
+    }else{
+        *(I2C_R + (0x030 >> 2)) = len - 1;
+        *I2C_STATUS_R = I2C_MCS_FIFO_RX_START;              //START, len-1 bytes ACK; last byte from ISR
+    }
+    return I2C_READ_OK;
+}
+
+/**
+ * @return true while a writeAsync or readAsync transaction is in progress
+ */
+bool I2CMaster::asyncBusy(){
+    return asyncState != I2C_ASYNC_IDLE;
+}
+
+/**
+ * Private: Finish the async transaction, release the channel and notify the user
+ * @param status is the transaction result
+ */
+void I2CMaster::endAsync(PrintStatus status){
+    uint8_t channel = asyncState == I2C_ASYNC_WRITE ? dmaTxCh : dmaRxCh;
+    *(I2C_R + (0x010 >> 2)) = 0x00;                         //Mask interrupts
+    *(I2C_R + (0xF04 >> 2)) = I2C_FIFOCTL_TXFLUSH | I2C_FIFOCTL_RXFLUSH; //Disable FIFO DMA requests
+    UDMA::release(channel, this);
+    asyncState = I2C_ASYNC_IDLE;
+    if(asyncCb) asyncCb(status, asyncArg);
+    startNext();
+}
+
+/**
+ * Classify a failed command
+ * @param mcs is the MCS status with the ERROR bit set
+ * @return I2C_ARB_LOST, I2C_ADDR_NACK, I2C_DATA_NACK, I2C_TIMEOUT or ERROR
+ */
+PrintStatus I2CMaster::errorStatus(uint32_t mcs){
+    if(mcs & 0x10) return I2C_ARB_LOST;
+    if(mcs & 0x04) return I2C_ADDR_NACK;
+    if(mcs & 0x08) return I2C_DATA_NACK;
+    if(mcs & 0x80) return I2C_TIMEOUT;
+    return I2C_WRITE_ERROR;
+}
+
+/**
+ * Private: I2Cx master interrupt service routine for this instance
+ */
+void I2CMaster::handleInterrupt(){
+    PROBE_SCOPE(PROBE_I2C_ISR);
+    uint32_t mis = *(I2C_R + (0x018 >> 2)); //Masked interrupt status
+    *(I2C_R + (0x01C >> 2)) = mis;          //Clear serviced interrupts
+    if(asyncState == I2C_ASYNC_IDLE || asyncState == I2C_ASYNC_RECOVERY) return;
+    if(asyncState == I2C_ASYNC_STOP){  //STOP ended (or SCL held low), start the next transaction
+        *(I2C_R + (0x010 >> 2)) = 0x00;
+        asyncState = I2C_ASYNC_IDLE;
+        if((mis & I2C_MIMR_CLKIM) && queueLen != 0) failQueued(0, I2C_BUS_STUCK);
+        startNext();
+        return;
+    }
+    if(asyncState >= I2C_ASYNC_TRXN_TX){
+        trxnInterrupt(mis);
+        return;
+    }
+
+    if(mis & (I2C_MIMR_DMATXIM | I2C_MIMR_DMARXIM)){
+        asyncDmaDone = true;
+    }
+    if(mis & I2C_MIMR_IM){
+        uint32_t mcs = *I2C_STATUS_R;
+        if(mcs & 0x02){ //Error found
+            if((mcs & 0x10) == 0){ //I2C Controller won arbitration
+                *I2C_STATUS_R = 0x04; //Generate stop condition
+            }
+            endAsync(errorStatus(mcs));
+            return;
+        }
+        if(asyncState == I2C_ASYNC_READ){ //First len-1 bytes received, NACK last one and STOP
+            asyncState = I2C_ASYNC_READ_LAST;
+            *(I2C_R + (0x030 >> 2)) = 1;
+            *I2C_STATUS_R = I2C_MCS_FIFO_RX_FINISH;
+        }else{
+            asyncBusDone = true;
+        }
+    }
+    if(asyncBusDone && asyncDmaDone) endAsync(I2C_WRITE_OK);
+}
+
+/**
+ * Private: uDMA bus error, abort the async transaction of the owner
+ * @param owner is the I2CMaster instance
+ */
+void I2CMaster::onDmaError(void* owner){
+    I2CMaster* bus = (I2CMaster*)owner;
+    if(bus->asyncState != I2C_ASYNC_IDLE){
+        *(bus->I2C_STATUS_R) = 0x04; //Generate stop condition
+        bus->endAsync(I2C_WRITE_ERROR);
+    }
+}
+
+/**
+ * Dispatch an I2C interrupt to the I2CMaster instance that opened the module
+ *
+ * @param i2cx is the I2C module that raised the interrupt
+ */
+void I2CMaster::serviceInterrupt(uint8_t i2cx){
+    if(i2cx <= 9 && instances[i2cx] != 0){
+        instances[i2cx]->handleInterrupt();
+    }
 }
 
 /**
  * Asserts is a valid I2CSpeed
  * (Tiva TM4C1294 doesn't limit for specific bus frequency values, but this ones are the most common)
+ * @param freq is the bus frequency
  * @return true if valid frequency
  */
-inline bool I2CMaster::assertValidI2CSpeed(){
+bool I2CMaster::validSpeed(uint32_t freq){
     switch(freq){
         case 100000:    //100KHz
         case 400000:    //400KHz
@@ -272,3 +1094,21 @@ inline bool I2CMaster::assertValidI2CSpeed(){
     }
     return false;
 }
+
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void I2CMaster_I2C0_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C0); }
+void I2CMaster_I2C1_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C1); }
+void I2CMaster_I2C2_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C2); }
+void I2CMaster_I2C3_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C3); }
+void I2CMaster_I2C4_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C4); }
+void I2CMaster_I2C5_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C5); }
+void I2CMaster_I2C6_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C6); }
+void I2CMaster_I2C7_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C7); }
+void I2CMaster_I2C8_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C8); }
+void I2CMaster_I2C9_Interrupt(){ I2CMaster::serviceInterrupt(I2C_I2C9); }
+#ifdef __cplusplus
+}
+#endif
@@ -10,6 +10,11 @@
 #define PERIPHERALS_I2CMASTER_HPP_
 #include <stdint.h>
 #include <Util/Print.hpp>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/UDMA.hpp>
+#include <Peripherals/Clock.hpp>
+#include <Peripherals/Timebase.hpp>
+#include <Peripherals/Pin.hpp>
 
 #define I2C_I2C0    0
 #define I2C_I2C1    1
@@ -22,6 +27,14 @@
 #define I2C_I2C8    8
 #define I2C_I2C9    9
 
+// I2C pins, checked against GPIO_PIN_AF in I2CMaster.cpp
+static constexpr uint8_t I2C_SCLIO_B[] = {2, 0, 0, 4, 6, 0, 6, 4, 2, 0}; //SCL Bit, SDA = SCLIO + 1, EXCEPT I2C_2, store SDA2 = SCL2-1
+static constexpr uint8_t I2C_PORT_OFF[] = {GPIO_PORTB_OFF, GPIO_PORTG_OFF, GPIO_PORTL_OFF,
+                                      GPIO_PORTK_OFF, GPIO_PORTK_OFF, GPIO_PORTB_OFF,
+                                      GPIO_PORTA_OFF, GPIO_PORTA_OFF, GPIO_PORTA_OFF,
+                                      GPIO_PORTA_OFF}; //GPIO Base offset
+
+#define I2C_MTPR_HS         0x80    //High speed mode timer period
 
 #define I2C_WRITE_OK    _PRINT_STATUS_OK
 #define I2C_WRITE_ERROR _PRINT_STATUS_ERROR
@@ -29,6 +42,54 @@
 #define I2C_READ_OK    _PRINT_STATUS_OK
 #define I2C_READ_ERROR _PRINT_STATUS_ERROR
 
+// Transaction error codes, ERROR bit set (status & _PRINT_STATUS_ERROR)
+#define I2C_BUSY        _PRINT_STATUS_BUSY  //Module in use or transaction in progress
+#define I2C_ADDR_NACK   0x05    //Slave address not acknowledged
+#define I2C_DATA_NACK   0x09    //Transmitted byte not acknowledged
+#define I2C_ARB_LOST    0x11    //Arbitration lost to another master
+#define I2C_TIMEOUT     0x21    //SCL held low by a slave (clock timeout)
+#define I2C_DEADLINE    _PRINT_STATUS_TIMEOUT   //Deadline passed, transaction canceled (0x41)
+#define I2C_BUS_STUCK   0x81    //SDA still held low after bus recovery
+
+// I2C TRANSACTION FLAGS
+#define I2C_TRXN_NO_START   0x01    //Continue a transaction held by a previous NO_STOP one
+#define I2C_TRXN_NO_STOP    0x02    //Hold the bus after the tx bytes (tx only transactions)
+#define I2C_TRXN_REG        0x04    //Send the reg byte before the tx bytes
+#define I2C_TRXN_NO_BURST   0x08    //Byte per command, don't use the FIFOs
+
+#ifndef I2C_BURST_MIN
+#define I2C_BURST_MIN       2       //Min bytes of a tx or rx part for FIFO burst transfer
+#endif
+
+// I2C TRANSACTION PRIORITIES (higher value is served first)
+#define I2C_PRIORITY_LOW    0
+#define I2C_PRIORITY_NORMAL 1
+#define I2C_PRIORITY_HIGH   2
+
+#ifndef I2C_QUEUE_SIZE
+#define I2C_QUEUE_SIZE      8       //Transactions waiting per I2C module
+#endif
+
+#ifndef I2C_CLK_TIMEOUT
+#define I2C_CLK_TIMEOUT     0xFF    //MCLKOCNT clock low timeout count
+#endif
+
+// Blocking calls retry ADDR_NACK, ARB_LOST and TIMEOUT transactions (see setRetry)
+#ifndef I2C_RETRY_COUNT
+#define I2C_RETRY_COUNT     0       //Retries after the first attempt, 0 disables them
+#endif
+#ifndef I2C_RETRY_BACKOFF_US
+#define I2C_RETRY_BACKOFF_US 100    //Wait before the first retry, doubled on each one
+#endif
+#define I2C_RETRY_BACKOFF_MAX 100000
+
+#ifndef I2C_RECOVERY_HALF_US
+#define I2C_RECOVERY_HALF_US 5      //Bus recovery SCL half period (100 kHz)
+#endif
+#ifndef I2C_STOP_WAIT_US
+#define I2C_STOP_WAIT_US    100     //Max wait for the STOP of an error before the lines are checked
+#endif
+
 
 // I2C FLAG WR DESCRIPTION (8 bits) Same as defined in PRINT, for external class use
 #define I2C_WR_MODE           PRINT_WR_MODE
@@ -47,36 +108,128 @@
 
 
 
+/**
+ * Transaction descriptor for I2CMaster::submit, executed from the I2C interrupt:
+ * START, tx bytes, repeated START, rx bytes, STOP (tx or rx part may be empty)
+ */
+typedef struct{
+    uint8_t address;            //7-bit slave address
+    uint8_t flags;              //I2C_TRXN_xx flags
+    uint8_t reg;                //Device register, sent first if I2C_TRXN_REG
+    uint8_t priority;           //I2C_PRIORITY_xx, order in the module queue
+    const uint8_t* tx;          //Bytes to send
+    uint16_t txLen;
+    uint8_t* rx;                //Received bytes
+    uint16_t rxLen;
+    TransferCallback callback;  //Called from the I2C interrupt when the transaction ends (optional)
+    void* arg;                  //Callback argument
+    volatile PrintStatus status;//I2C_BUSY while queued or in progress, then OK or the I2C error code
+    uint32_t queuedAt;          //Internal: cycle count when submitted
+} I2CTransaction;
+
+// Transaction queue statistics, wait times in CPU cycles (submit to start)
+typedef struct{
+    uint32_t submitted;     //Transactions accepted
+    uint32_t rejected;      //Transactions refused, queue full
+    uint8_t depth;          //Transactions waiting now
+    uint8_t maxDepth;       //Max transactions waiting at once
+    uint32_t started;       //Transactions started
+    uint32_t maxWait;
+    uint64_t totalWait;     //Average wait = totalWait / started
+    uint32_t retries;       //Blocking call attempts repeated (setRetry)
+    uint32_t recoveries;    //Bus recoveries (recoverBus)
+} I2CQueueStats;
+
+
 class I2CMaster:public Print{
     public:
         I2CMaster(); //Default 400kHz, I2C0
         I2CMaster(uint32_t, uint8_t=0); //speed, port, mode
+        ~I2CMaster();
 
         void open();
         void close();
         void setAddress(uint8_t);
 
 
-        PrintStatus read(void*, uint8_t=1, bool=false);
-        PrintStatus readFrom(uint8_t, void*, uint8_t=1);
+        PrintStatus read(void*, uint8_t=1, bool=false, uint64_t=TIMEBASE_FOREVER);
+        PrintStatus readFrom(uint8_t, void*, uint8_t=1, uint64_t=TIMEBASE_FOREVER);
+        void setTimeout(uint32_t);
+        void setRetry(uint8_t, uint32_t = I2C_RETRY_BACKOFF_US);
+        PrintStatus recoverBus();
 
 
         PrintStatus write(const char*, int, uint8_t) override;
         PrintStatus write(uint8_t c, uint8_t flags=0) override;
 
+        PrintStatus submit(I2CTransaction*);
+        PrintStatus transfer(I2CTransaction*, uint64_t=TIMEBASE_FOREVER);
+        bool cancel(I2CTransaction*, PrintStatus = I2C_DEADLINE);
+        const I2CQueueStats& queueStats();
+        void clearQueueStats();
+
+        void setDmaChannels(uint8_t, uint8_t, uint8_t, uint8_t);
+        PrintStatus writeAsync(const void*, uint8_t, TransferCallback = 0, void* = 0);
+        PrintStatus readAsync(void*, uint8_t, TransferCallback = 0, void* = 0);
+        bool asyncBusy();
+
+        static void serviceInterrupt(uint8_t);
+        static bool validSpeed(uint32_t);
+        static uint32_t timerPeriod(uint32_t, uint32_t);
+        static PrintStatus errorStatus(uint32_t);
 
     private:
         uint8_t mode;
         uint32_t freq;
         uint8_t I2Cx;
         uint8_t slaveAddress;
-
-        volatile uint32_t* PORT_R;
-        volatile uint32_t* I2C_R;
-        volatile uint32_t* I2C_STATUS_R;
-
-        uint8_t I2CTransactionResult(bool=false);
-        inline bool assertValidI2CSpeed();
+        uint32_t timeoutUs;     //Blocking calls limit, TIMEBASE_NO_TIMEOUT if none
+        uint8_t retryCount;
+        uint32_t retryBackoffUs;
+
+        HwReg* PORT_R;
+        HwReg* I2C_R;
+        HwReg* I2C_STATUS_R;
+
+        uint8_t dmaRxCh, dmaRxEnc, dmaTxCh, dmaTxEnc;
+        volatile uint8_t asyncState;
+        volatile bool asyncBusDone;
+        volatile bool asyncDmaDone;
+        TransferCallback asyncCb;
+        void* asyncArg;
+        I2CTransaction* trxn;
+        uint16_t trxnIdx;
+        uint16_t trxnBurstEnd;
+        uint8_t trxnCmd;
+        bool busHeld;
+        I2CTransaction* queue[I2C_QUEUE_SIZE];
+        uint8_t queueLen;
+        I2CQueueStats stats;
+
+        static I2CMaster* instances[10];
+
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+        uint64_t until(uint64_t);
+        PrintStatus execute(I2CTransaction*, uint64_t);
+        PrintStatus attempt(I2CTransaction*, uint64_t);
+        bool busStuck(uint64_t);
+        void resetModule();
+        void trxnCommand(uint8_t);
+        void trxnStartRx();
+        void trxnStep();
+        void trxnRxBurst();
+        void trxnDrain();
+        void trxnFill();
+        inline uint8_t trxnTxByte(uint16_t);
+        void trxnInterrupt(uint32_t);
+        void endTransaction(PrintStatus);
+        void startTransaction(I2CTransaction*);
+        void startNext();
+        bool holderPending();
+        void failQueued(uint8_t, PrintStatus);
+        void handleInterrupt();
+        void endAsync(PrintStatus);
+        static void onDmaError(void*);
 
 };
 
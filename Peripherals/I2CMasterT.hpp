@@ -0,0 +1,335 @@
+/*
+ * I2CMasterT.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_I2CMASTERT_HPP_
+#define PERIPHERALS_I2CMASTERT_HPP_
+
+#include <stdint.h>
+#include <../inc/tm4c1294ncpdt.h>
+#include <Util/PrintT.hpp>
+#include <Peripherals/I2CMaster.hpp>
+#include <Peripherals/Pin.hpp>
+
+// Compile-time I2C master: the module is a template argument, so register
+// addresses and pins are constants, an invalid module doesn't compile, and
+// print/printf call the writes directly (PrintT). Blocking transfers, one
+// polled command per byte (no queue, FIFOs, uDMA or interrupts), same status
+// codes and PRINT_WR transaction flags as I2CMaster, SCL reprogrammed on
+// Clock::set switches.
+// I2CMaster stays for code that needs Print& (runtime module, I2CDevice),
+// queued or async transactions, retries and bus recovery. Don't open both on
+// the same module.
+//
+//   I2CMasterT<I2C_I2C0> bus(400000);
+//   bus.setAddress(0x50);
+//   bus.printf("%c%s", 0x00, "data");       //Register pointer, then bytes
+//   bus.readFrom(0x00, buf, 4);
+
+#define I2C_MCS_RUN     0x01
+#define I2C_MCS_START   0x02
+#define I2C_MCS_STOP    0x04
+#define I2C_MCS_ACK     0x08
+
+template<uint8_t I2C>
+class I2CMasterT:public PrintT<I2CMasterT<I2C>>{
+    static_assert(I2C <= I2C_I2C9, "I2CMasterT I2C must be I2C_I2C0 to I2C_I2C9");
+    friend class PrintT<I2CMasterT<I2C>>;
+
+    public:
+        //SDA = SCL + 1, except I2C2 (table bit is SDA, SCL = SDA + 1)
+        typedef Pin<I2C_PORT_OFF[I2C], I2C_SCLIO_B[I2C] + (I2C == I2C_I2C2 ? 1 : 0)> Scl;
+        typedef Pin<I2C_PORT_OFF[I2C], I2C_SCLIO_B[I2C] + (I2C == I2C_I2C2 ? 0 : 1)> Sda;
+        static constexpr uint32_t BASE = I2C_MODULE_BASE(I2C);  //I2C registers
+
+        I2CMasterT(uint32_t = 100000);
+        ~I2CMasterT();
+
+        void open();
+        void close();
+        void setAddress(uint8_t);
+        void setTimeout(uint32_t);
+
+        PrintStatus read(void*, uint8_t=1, bool=false, uint64_t=TIMEBASE_FOREVER);
+        PrintStatus readFrom(uint8_t, void*, uint8_t=1, uint64_t=TIMEBASE_FOREVER);
+
+    private:
+        uint32_t freq;
+        uint8_t slaveAddress;
+        uint32_t timeoutUs;     //Blocking calls limit, TIMEBASE_NO_TIMEOUT if none
+        bool opened;
+
+        static I2CMasterT* instance;    //Opened bus, for the clock switches
+
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+        inline uint64_t until(uint64_t);
+        PrintStatus command(uint8_t, uint64_t);
+        PrintStatus receive(uint8_t*, uint8_t, uint64_t);
+
+        inline PrintStatus write(uint8_t, uint8_t = 0);
+        PrintStatus write(const char*, int, uint8_t);
+};
+
+template<uint8_t I2C>
+I2CMasterT<I2C>* I2CMasterT<I2C>::instance = 0;
+
+/**
+ * I2CMasterT Constructor, opens the bus
+ * @param speed is the bus frequency (see I2CMaster::validSpeed)
+ */
+template<uint8_t I2C>
+I2CMasterT<I2C>::I2CMasterT(uint32_t speed){
+    freq = speed;
+    slaveAddress = 0;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    opened = false;
+    open();
+}
+
+/**
+ * I2CMasterT destructor, clock switches stop using this instance
+ */
+template<uint8_t I2C>
+I2CMasterT<I2C>::~I2CMasterT(){
+    if(instance == this){
+        instance = 0;
+        Clock::unsubscribe(onClockChange);
+    }
+}
+
+/**
+ * Enable the module as master and its pins (SDA open-drain)
+ * An unsupported speed leaves the bus closed, transfers return ERROR
+ */
+template<uint8_t I2C>
+void I2CMasterT<I2C>::open(){
+    if(!I2CMaster::validSpeed(freq)) return;
+
+    SYSCTL_RCGCI2C_R |= 1 << I2C;       //Enable I2C clock
+    Scl::enable();
+    Scl::template alternate<2>();
+    Sda::template alternate<2>();
+    Sda::openDrain(true);
+    while((SYSCTL_PRI2C_R & (1 << I2C)) == 0);
+
+    TIVA_HWREG(BASE + 0x020) = 0x10;    //Master function
+    TIVA_HWREG(BASE + 0x00C) = I2CMaster::timerPeriod(freq, systemClock());  //SCL Speed TPR Val
+    TIVA_HWREG(BASE + 0x024) = I2C_CLK_TIMEOUT;     //SCL low timeout
+    TIVA_HWREG(BASE + 0x010) = 0x00;    //Mask interrupts
+
+    opened = true;
+    instance = this;
+    Clock::subscribe(onClockChange);
+}
+
+/**
+ * Disable the module, SDA and SCL return to GPIO inputs. open() starts the bus again
+ */
+template<uint8_t I2C>
+void I2CMasterT<I2C>::close(){
+    if(!opened) return;
+    while(TIVA_HWREG(BASE + 0x004) & 0x01);     //STOP after an error still going out
+    TIVA_HWREG(BASE + 0x020) = 0x00;    //Disable master function
+    Scl::disable();
+    Sda::disable();
+    Sda::openDrain(false);
+    SYSCTL_RCGCI2C_R &= ~(1 << I2C);    //Disable I2C clock
+    opened = false;
+    if(instance == this){
+        instance = 0;
+        Clock::unsubscribe(onClockChange);
+    }
+}
+
+/**
+ * Sets the external device address
+ * @param addr is the 7-bit external device address
+ */
+template<uint8_t I2C>
+void I2CMasterT<I2C>::setAddress(uint8_t addr){
+    slaveAddress = (addr << 1) & 0xFE;
+}
+
+/**
+ * Limit the time blocking calls wait for their transfer, it is ended with a
+ * STOP (I2C_DEADLINE) when it passes (see I2CMaster::setTimeout)
+ * @param us is the limit in microseconds, TIMEBASE_NO_TIMEOUT (default) to wait forever
+ */
+template<uint8_t I2C>
+void I2CMasterT<I2C>::setTimeout(uint32_t us){
+    timeoutUs = us;
+}
+
+/**
+ * Read n bytes from the device (address previously saved)
+ *
+ * @param out_r points the external buffer that store read values
+ * @param len is the quantity of bytes to receive
+ * @param endRx if true, adds a '\0' value at the end of the buffer
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return OK or the I2C error code (see I2CMaster)
+ */
+template<uint8_t I2C>
+PrintStatus I2CMasterT<I2C>::read(void* out_r, uint8_t len, bool endRx, uint64_t deadline){
+    if(!opened || len == 0) return I2C_READ_ERROR;
+    uint8_t* out = (uint8_t*)out_r;
+    TIVA_HWREG(BASE) = slaveAddress | 0x01;     //Slave Address - Receive Mode
+    PrintStatus status = receive(out, len, until(deadline));
+    if(status == I2C_READ_OK && endRx) out[len] = '\0';
+    return status;
+}
+
+/**
+ * Send a register byte, then read n bytes after a repeated START
+ *
+ * @param dev_reg is the command or memory address to read in the external device
+ * @param out_r points the external buffer that store read values
+ * @param len is the quantity of bytes to receive
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return OK or the I2C error code (see I2CMaster)
+ */
+template<uint8_t I2C>
+PrintStatus I2CMasterT<I2C>::readFrom(uint8_t dev_reg, void* out_r, uint8_t len, uint64_t deadline){
+    if(!opened || len == 0) return I2C_READ_ERROR;
+    deadline = until(deadline);
+    TIVA_HWREG(BASE) = slaveAddress;            //Slave Address - Transmit Mode
+    TIVA_HWREG(BASE + 0x008) = dev_reg;
+    PrintStatus status = command(I2C_MCS_START | I2C_MCS_RUN, deadline);
+    if(status != I2C_WRITE_OK) return status;
+    TIVA_HWREG(BASE) = slaveAddress | 0x01;     //Slave Address - Receive Mode
+    return receive((uint8_t*)out_r, len, deadline);
+}
+
+/**
+ * Private: system clock switch listener (see I2CMaster::onClockChange)
+ *
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+template<uint8_t I2C>
+void I2CMasterT<I2C>::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    if((phase == CLOCK_PRE_CHANGE) != (newFreq > oldFreq)) return;
+    if(instance != 0) TIVA_HWREG(BASE + 0x00C) = I2CMaster::timerPeriod(instance->freq, newFreq);
+}
+
+/**
+ * Private: deadline of a blocking call
+ * @param deadline is the caller deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return the deadline to wait for, Timer1 isn't used without a limit
+ */
+template<uint8_t I2C>
+inline uint64_t I2CMasterT<I2C>::until(uint64_t deadline){
+    if(deadline != TIMEBASE_FOREVER || timeoutUs == TIMEBASE_NO_TIMEOUT) return deadline;
+    return Timebase::deadline(timeoutUs);
+}
+
+/**
+ * Private: run a master command and wait until it is done (MRIS, raw master
+ * and clock timeout interrupts). A failed command without STOP, or one past
+ * the deadline, is ended with a STOP
+ *
+ * @param cmd is the MCS command (I2C_MCS_xx)
+ * @param deadline is the Timebase deadline
+ * @return OK, the I2C error code of the failed command, or I2C_DEADLINE
+ */
+template<uint8_t I2C>
+PrintStatus I2CMasterT<I2C>::command(uint8_t cmd, uint64_t deadline){
+    if(cmd & I2C_MCS_START){
+        while(TIVA_HWREG(BASE + 0x004) & 0x01);  //STOP after an error still going out, commands are ignored meanwhile
+    }
+    TIVA_HWREG(BASE + 0x01C) = 0x03;            //Clear done and clock timeout
+    TIVA_HWREG(BASE + 0x004) = cmd;
+    while((TIVA_HWREG(BASE + 0x014) & 0x03) == 0){
+        if(Timebase::expired(deadline)){
+            TIVA_HWREG(BASE + 0x004) = I2C_MCS_STOP;
+            return I2C_DEADLINE;
+        }
+    }
+    uint32_t mcs = TIVA_HWREG(BASE + 0x004);
+    if(mcs & 0x02){     //Error found
+        if((mcs & 0x10) == 0 && (cmd & I2C_MCS_STOP) == 0){ //I2C Controller won arbitration
+            TIVA_HWREG(BASE + 0x004) = I2C_MCS_STOP;
+        }
+        return I2CMaster::errorStatus(mcs);
+    }
+    return I2C_WRITE_OK;
+}
+
+/**
+ * Private: receive len bytes (slave address already set), START first,
+ * the last byte is NACKed and followed by STOP
+ *
+ * @param out receives the bytes
+ * @param len is the quantity of bytes (1 or more)
+ * @param deadline is the Timebase deadline
+ * @return OK or the failed command result
+ */
+template<uint8_t I2C>
+PrintStatus I2CMasterT<I2C>::receive(uint8_t* out, uint8_t len, uint64_t deadline){
+    uint8_t cmd = I2C_MCS_START | I2C_MCS_RUN;
+    for(uint8_t i = 0; i < len; i++){
+        cmd |= i + 1 < len ? I2C_MCS_ACK : I2C_MCS_STOP;
+        PrintStatus status = command(cmd, deadline);
+        if(status != I2C_READ_OK) return status;
+        out[i] = (uint8_t)TIVA_HWREG(BASE + 0x008);
+        cmd = I2C_MCS_RUN;
+    }
+    return I2C_READ_OK;
+}
+
+/**
+ * Private: PrintT writer, send a byte
+ *
+ * @param data is the byte to send
+ * @param flags specifies the transaction state (START, CONTINUE, STOP)
+ * @return I2C Transaction result
+ */
+template<uint8_t I2C>
+inline PrintStatus I2CMasterT<I2C>::write(uint8_t data, uint8_t flags){
+    return write((const char*)&data, 1, flags);
+}
+
+/**
+ * Private: PrintT writer, send n bytes, one command per byte
+ *
+ * @param txt is the byte array pointer to send
+ * @param n is the number of the bytes to write
+ *       if n < 0, write until a 0 is found in the array (a 0 if empty)
+ * @param flags specifies the transaction state (START, CONTINUE, STOP),
+ *      PRINT_WR_MOD_SINGLE sends a whole transaction
+ * @return I2C Transaction result, I2C_DEADLINE if the setTimeout time passed
+ */
+template<uint8_t I2C>
+PrintStatus I2CMasterT<I2C>::write(const char* txt, int n, uint8_t flags){
+    if(!opened) return I2C_WRITE_ERROR;
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    if(n < 0){  //Length of the string
+        n = 0;
+        while(txt[n]) n++;
+    }
+    uint8_t zero = 0;
+    if(n == 0){ //Length 0 string, send a 0
+        txt = (const char*)&zero;
+        n = 1;
+    }
+
+    uint8_t ctl = (flags & PRINT_WR_MODE) == PRINT_WR_MOD_MULTIPLE ? flags : PRINT_WR_CTL;
+    if(ctl & PRINT_WR_START) TIVA_HWREG(BASE) = slaveAddress;   //Slave Address - Transmit Mode
+    uint8_t cmd = I2C_MCS_RUN | (ctl & PRINT_WR_START ? I2C_MCS_START : 0);
+    for(int i = 0; i < n; i++){
+        if(i + 1 == n && (ctl & PRINT_WR_STOP)) cmd |= I2C_MCS_STOP;
+        TIVA_HWREG(BASE + 0x008) = (uint8_t)txt[i];
+        PrintStatus status = command(cmd, deadline);
+        if(status != I2C_WRITE_OK) return status;
+        cmd = I2C_MCS_RUN;
+    }
+    return I2C_WRITE_OK;
+}
+
+
+#endif /* PERIPHERALS_I2CMASTERT_HPP_ */
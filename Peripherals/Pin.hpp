@@ -0,0 +1,366 @@
+/*
+ * Pin.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_PIN_HPP_
+#define PERIPHERALS_PIN_HPP_
+
+#include <stdint.h>
+#include <Peripherals/Board.hpp>
+
+// Compile-time GPIO pins: port registers, the GPIODATA address masked to the
+// pin and the bit-band aliases of its register bits are constants, so every
+// access is one load or store to a fixed address:
+//
+//   typedef Pin<GPIO_PORTN_OFF, 1> Led;     //PN1, user LED D1
+//   Led::enable();                          //Port clock
+//   Led::output();
+//   Led::set();                             //One store to the masked GPIODATA
+//   Led::toggle();                          //Load and store of the masked GPIODATA
+//
+//   typedef Pin<GPIO_PORTA_OFF, 0> U0Rx;
+//   U0Rx::alternate<1>();                   //PCTL 1 (U0Rx), checked by GPIO_PIN_AF
+//   U0Rx::alternate<4>();                   //Doesn't compile, PA0 has no function 4
+//
+// Data writes only reach the pin bits (GPIODATA address mask), configuration
+// bits are written through their bit-band alias: no read-modify-write, so an
+// interrupt changing other pins of the port is never undone. toggle() reads
+// the pin first, only a concurrent toggle of the same pin can race it.
+// Pins known at run time only (drivers taking a module number) keep their
+// tables, checked against GPIO_PIN_AF with gpioHasAF in static_asserts.
+
+#define GPIO_BITBAND_BASE   0x40000000U     //Peripheral bit-band region
+#define GPIO_BITBAND_ALIAS  0x42000000U     //32 alias words per region word
+
+// PORT REGISTER OFFSETS
+#define GPIO_DIR        0x400
+#define GPIO_AFSEL      0x420
+#define GPIO_ODR        0x50C
+#define GPIO_PUR        0x510
+#define GPIO_PDR        0x514
+#define GPIO_DEN        0x51C
+#define GPIO_AMSEL      0x528
+#define GPIO_PCTL       0x52C
+
+/**
+ * Port Mux (GPIOPCTL) encodings of every pin: bit 0 set if the pin is bonded
+ * out (GPIO), bit n set if PCTL n selects a function (TM4C1294NCPDT datasheet,
+ * GPIO pins and alternate functions table)
+ */
+constexpr uint16_t GPIO_PIN_AF[15][8] = {
+    {   //Port A
+        0x008F,  //PA0: U0Rx(1), I2C9SCL(2), T0CCP0(3), CAN0Rx(7)
+        0x008F,  //PA1: U0Tx(1), I2C9SDA(2), T0CCP1(3), CAN0Tx(7)
+        0x800F,  //PA2: U4Rx(1), I2C8SCL(2), T1CCP0(3), SSI0Clk(15)
+        0x800F,  //PA3: U4Tx(1), I2C8SDA(2), T1CCP1(3), SSI0Fss(15)
+        0x800F,  //PA4: U3Rx(1), I2C7SCL(2), T2CCP0(3), SSI0XDAT0(15)
+        0x800F,  //PA5: U3Tx(1), I2C7SDA(2), T2CCP1(3), SSI0XDAT1(15)
+        0xA02F,  //PA6: U2Rx(1), I2C6SCL(2), T3CCP0(3), USB0EPEN(5), SSI0XDAT2(13), EPI0S8(15)
+        0xA82F   //PA7: U2Tx(1), I2C6SDA(2), T3CCP1(3), USB0PFLT(5), USB0EPEN(11), SSI0XDAT3(13), EPI0S9(15)
+    },
+    {   //Port B
+        0x008F,  //PB0: U1Rx(1), I2C5SCL(2), T4CCP0(3), CAN1Rx(7)
+        0x008F,  //PB1: U1Tx(1), I2C5SDA(2), T4CCP1(3), CAN1Tx(7)
+        0xC00D,  //PB2: I2C0SCL(2), T5CCP0(3), USB0STP(14), EPI0S27(15)
+        0xC00D,  //PB3: I2C0SDA(2), T5CCP1(3), USB0CLK(14), EPI0S28(15)
+        0x8007,  //PB4: U0CTS(1), I2C5SCL(2), SSI1Fss(15)
+        0x8007,  //PB5: U0RTS(1), I2C5SDA(2), SSI1Clk(15)
+        0x0000,  //PB6: not bonded
+        0x0000   //PB7: not bonded
+    },
+    {   //Port C
+        0x0003,  //PC0: TCK/SWCLK(1)
+        0x0003,  //PC1: TMS/SWDIO(1)
+        0x0003,  //PC2: TDI(1)
+        0x0003,  //PC3: TDO/SWO(1)
+        0x8003,  //PC4: U7Rx(1), EPI0S7(15)
+        0x8083,  //PC5: U7Tx(1), RTCCLK(7), EPI0S6(15)
+        0x8003,  //PC6: U5Rx(1), EPI0S5(15)
+        0x8003   //PC7: U5Tx(1), EPI0S4(15)
+    },
+    {   //Port D
+        0x802D,  //PD0: I2C7SCL(2), T0CCP0(3), C0o(5), SSI2XDAT1(15)
+        0x802D,  //PD1: I2C7SDA(2), T0CCP1(3), C1o(5), SSI2XDAT0(15)
+        0x802D,  //PD2: I2C8SCL(2), T1CCP0(3), C2o(5), SSI2Fss(15)
+        0x800D,  //PD3: I2C8SDA(2), T1CCP1(3), SSI2Clk(15)
+        0x800B,  //PD4: U2Rx(1), T3CCP0(3), SSI1XDAT2(15)
+        0x800B,  //PD5: U2Tx(1), T3CCP1(3), SSI1XDAT3(15)
+        0x802B,  //PD6: U2RTS(1), T4CCP0(3), USB0EPEN(5), SSI2XDAT3(15)
+        0x812B   //PD7: U2CTS(1), T4CCP1(3), USB0PFLT(5), NMI(8), SSI2XDAT2(15)
+    },
+    {   //Port E
+        0x0003,  //PE0: U1RTS(1)
+        0x0003,  //PE1: U1DSR(1)
+        0x0003,  //PE2: U1DCD(1)
+        0x0003,  //PE3: U1DTR(1)
+        0x8003,  //PE4: U1RI(1), SSI1XDAT0(15)
+        0x8001,  //PE5: SSI1XDAT1(15)
+        0x0000,  //PE6: not bonded
+        0x0000   //PE7: not bonded
+    },
+    {   //Port F
+        0xC061,  //PF0: EN0LED0(5), M0PWM0(6), SSI3XDAT1(14), TRD2(15)
+        0xC061,  //PF1: EN0LED2(5), M0PWM1(6), SSI3XDAT0(14), TRD1(15)
+        0xC041,  //PF2: M0PWM2(6), SSI3Fss(14), TRD0(15)
+        0xC041,  //PF3: M0PWM3(6), SSI3Clk(14), TRCLK(15)
+        0xC061,  //PF4: EN0LED1(5), M0FAULT0(6), SSI3XDAT2(14), TRD3(15)
+        0x0000,  //PF5: not bonded
+        0x0000,  //PF6: not bonded
+        0x0000   //PF7: not bonded
+    },
+    {   //Port G
+        0x8065,  //PG0: I2C1SCL(2), EN0PPS(5), M0PWM4(6), EPI0S11(15)
+        0x8045,  //PG1: I2C1SDA(2), M0PWM5(6), EPI0S10(15)
+        0x0000,  //PG2: not bonded
+        0x0000,  //PG3: not bonded
+        0x0000,  //PG4: not bonded
+        0x0000,  //PG5: not bonded
+        0x0000,  //PG6: not bonded
+        0x0000   //PG7: not bonded
+    },
+    {   //Port H
+        0x8003,  //PH0: U0RTS(1), EPI0S0(15)
+        0x8003,  //PH1: U0CTS(1), EPI0S1(15)
+        0x8003,  //PH2: U0DCD(1), EPI0S2(15)
+        0x8003,  //PH3: U0DSR(1), EPI0S3(15)
+        0x0000,  //PH4: not bonded
+        0x0000,  //PH5: not bonded
+        0x0000,  //PH6: not bonded
+        0x0000   //PH7: not bonded
+    },
+    {   //Port J
+        0x0023,  //PJ0: U3Rx(1), EN0PPS(5)
+        0x0003,  //PJ1: U3Tx(1)
+        0x0000,  //PJ2: not bonded
+        0x0000,  //PJ3: not bonded
+        0x0000,  //PJ4: not bonded
+        0x0000,  //PJ5: not bonded
+        0x0000,  //PJ6: not bonded
+        0x0000   //PJ7: not bonded
+    },
+    {   //Port K
+        0x8003,  //PK0: U4Rx(1), EPI0S0(15)
+        0x8003,  //PK1: U4Tx(1), EPI0S1(15)
+        0x8003,  //PK2: U4RTS(1), EPI0S2(15)
+        0x8003,  //PK3: U4CTS(1), EPI0S3(15)
+        0x8065,  //PK4: I2C3SCL(2), EN0LED0(5), M0PWM6(6), EPI0S32(15)
+        0x8065,  //PK5: I2C3SDA(2), EN0LED2(5), M0PWM7(6), EPI0S31(15)
+        0x8065,  //PK6: I2C4SCL(2), EN0LED1(5), M0FAULT1(6), EPI0S25(15)
+        0x8067   //PK7: U0RI(1), I2C4SDA(2), RTCCLK(5), M0FAULT2(6), EPI0S24(15)
+    },
+    {   //Port L
+        0xC045,  //PL0: I2C2SDA(2), M0FAULT3(6), USB0D0(14), EPI0S16(15)
+        0xC045,  //PL1: I2C2SCL(2), PhA0(6), USB0D1(14), EPI0S17(15)
+        0xC061,  //PL2: C0o(5), PhB0(6), USB0D2(14), EPI0S18(15)
+        0xC061,  //PL3: C1o(5), IDX0(6), USB0D3(14), EPI0S19(15)
+        0xC009,  //PL4: T0CCP0(3), USB0D4(14), EPI0S26(15)
+        0xC009,  //PL5: T0CCP1(3), USB0D5(14), EPI0S33(15)
+        0x0009,  //PL6: T1CCP0(3)
+        0x0009   //PL7: T1CCP1(3)
+    },
+    {   //Port M
+        0x8009,  //PM0: T2CCP0(3), EPI0S15(15)
+        0x8009,  //PM1: T2CCP1(3), EPI0S14(15)
+        0x8009,  //PM2: T3CCP0(3), EPI0S13(15)
+        0x8009,  //PM3: T3CCP1(3), EPI0S12(15)
+        0x000B,  //PM4: U0CTS(1), T4CCP0(3)
+        0x000B,  //PM5: U0DCD(1), T4CCP1(3)
+        0x000B,  //PM6: U0DSR(1), T5CCP0(3)
+        0x000B   //PM7: U0RI(1), T5CCP1(3)
+    },
+    {   //Port N
+        0x0003,  //PN0: U1RTS(1)
+        0x0003,  //PN1: U1CTS(1)
+        0x8007,  //PN2: U1DCD(1), U2RTS(2), EPI0S29(15)
+        0x8007,  //PN3: U1DSR(1), U2CTS(2), EPI0S30(15)
+        0x800F,  //PN4: U1DTR(1), U3RTS(2), I2C2SDA(3), EPI0S34(15)
+        0x800F,  //PN5: U1RI(1), U3CTS(2), I2C2SCL(3), EPI0S35(15)
+        0x0000,  //PN6: not bonded
+        0x0000   //PN7: not bonded
+    },
+    {   //Port P
+        0x8003,  //PP0: U6Rx(1), SSI3XDAT2(15)
+        0x8003,  //PP1: U6Tx(1), SSI3XDAT3(15)
+        0xC003,  //PP2: U0DTR(1), USB0NXT(14), EPI0S29(15)
+        0xC087,  //PP3: U1CTS(1), U0DCD(2), RTCCLK(7), USB0DIR(14), EPI0S30(15)
+        0x4007,  //PP4: U3RTS(1), U0DSR(2), USB0D7(14)
+        0x4007,  //PP5: U3CTS(1), I2C2SCL(2), USB0D6(14)
+        0x0000,  //PP6: not bonded
+        0x0000   //PP7: not bonded
+    },
+    {   //Port Q
+        0xC001,  //PQ0: SSI3Clk(14), EPI0S20(15)
+        0xC001,  //PQ1: SSI3Fss(14), EPI0S21(15)
+        0xC001,  //PQ2: SSI3XDAT0(14), EPI0S22(15)
+        0xC001,  //PQ3: SSI3XDAT1(14), EPI0S23(15)
+        0x0083,  //PQ4: U1Rx(1), DIVSCLK(7)
+        0x0000,  //PQ5: not bonded
+        0x0000,  //PQ6: not bonded
+        0x0000   //PQ7: not bonded
+    }
+
+};
+
+/**
+ * @param port is the GPIO port (GPIO_PORTx_OFF)
+ * @param bit is the pin (0 to 7)
+ * @return true if the pin is bonded out
+ */
+constexpr bool gpioPinExists(uint8_t port, uint8_t bit){
+    return port <= GPIO_PORTQ_OFF && bit <= 7 && (GPIO_PIN_AF[port][bit] & 0x01) != 0;
+}
+
+/**
+ * @param port is the GPIO port (GPIO_PORTx_OFF)
+ * @param bit is the pin (0 to 7)
+ * @param af is the Port Mux encoding (1 to 15)
+ * @return true if PCTL af selects a function of the pin
+ */
+constexpr bool gpioHasAF(uint8_t port, uint8_t bit, uint8_t af){
+    return gpioPinExists(port, bit) && af >= 1 && af <= 15 && (GPIO_PIN_AF[port][bit] & (1 << af)) != 0;
+}
+
+/**
+ * GPIO pin
+ * @tparam PORT is the GPIO port (GPIO_PORTx_OFF)
+ * @tparam BIT is the pin (0 to 7)
+ */
+template<uint8_t PORT, uint8_t BIT>
+class Pin{
+    static_assert(PORT <= GPIO_PORTQ_OFF, "Pin PORT must be GPIO_PORTA_OFF to GPIO_PORTQ_OFF");
+    static_assert(BIT <= 7, "Pin BIT must be 0 to 7");
+    static_assert(gpioPinExists(PORT, BIT), "Pin not bonded out on the TM4C1294NCPDT");
+
+    public:
+        static constexpr uint32_t BASE = GPIO_AHB_BASE + ((uint32_t)PORT << 12);   //Port registers
+        static constexpr uint8_t MASK = 1 << BIT;
+        static constexpr uint32_t DATA = BASE + ((uint32_t)MASK << 2);              //GPIODATA masked to the pin
+
+        /**
+         * @param offset is a port register offset (GPIO_DIR, GPIO_DEN, ...)
+         * @param bit is the register bit, the pin one by default
+         * @return bit-band alias address of the register bit
+         */
+        static constexpr uint32_t bitband(uint32_t offset, uint8_t bit = BIT){
+            return GPIO_BITBAND_ALIAS + ((BASE + offset - GPIO_BITBAND_BASE) << 5) + ((uint32_t)bit << 2);
+        }
+
+        /**
+         * Enable the port clock, waits until the port is ready
+         */
+        static void enable(){
+            TIVA_HWREG(0x400FE608) |= 1 << PORT;                    //RCGCGPIO
+            while((TIVA_HWREG(0x400FEA08) & (1 << PORT)) == 0);     //PRGPIO
+        }
+
+        /**
+         * GPIO digital output, push-pull (open-drain with openDrain)
+         */
+        static void output(){
+            TIVA_HWREG(bitband(GPIO_AFSEL)) = 0;
+            TIVA_HWREG(bitband(GPIO_AMSEL)) = 0;
+            TIVA_HWREG(bitband(GPIO_DIR)) = 1;
+            TIVA_HWREG(bitband(GPIO_DEN)) = 1;
+        }
+
+        /**
+         * GPIO digital input
+         */
+        static void input(){
+            TIVA_HWREG(bitband(GPIO_AFSEL)) = 0;
+            TIVA_HWREG(bitband(GPIO_AMSEL)) = 0;
+            TIVA_HWREG(bitband(GPIO_DIR)) = 0;
+            TIVA_HWREG(bitband(GPIO_DEN)) = 1;
+        }
+
+        /**
+         * Map the pin to a peripheral, digital enabled
+         * @tparam AF is the Port Mux encoding, it must be one of the pin (GPIO_PIN_AF)
+         */
+        template<uint8_t AF>
+        static void alternate(){
+            static_assert(gpioHasAF(PORT, BIT, AF), "Pin has no alternate function with this PCTL value");
+            TIVA_HWREG(bitband(GPIO_AFSEL)) = 1;
+            TIVA_HWREG(bitband(GPIO_AMSEL)) = 0;
+            for(uint8_t i = 0; i < 4; i++){     //PCTL field, bit by bit
+                TIVA_HWREG(bitband(GPIO_PCTL, BIT * 4 + i)) = (AF >> i) & 0x01;
+            }
+            TIVA_HWREG(bitband(GPIO_DEN)) = 1;
+        }
+
+        /**
+         * Disconnect the pin: no peripheral, digital disabled, input
+         */
+        static void disable(){
+            TIVA_HWREG(bitband(GPIO_DEN)) = 0;
+            for(uint8_t i = 0; i < 4; i++){
+                TIVA_HWREG(bitband(GPIO_PCTL, BIT * 4 + i)) = 0;
+            }
+            TIVA_HWREG(bitband(GPIO_AFSEL)) = 0;
+            TIVA_HWREG(bitband(GPIO_DIR)) = 0;
+        }
+
+        /**
+         * @param enable selects open-drain (true) or push-pull (false) output
+         */
+        static void openDrain(bool enable){
+            TIVA_HWREG(bitband(GPIO_ODR)) = enable;
+        }
+
+        /**
+         * @param enable connects the weak pull-up (true) or disconnects it (false)
+         */
+        static void pullUp(bool enable){
+            TIVA_HWREG(bitband(GPIO_PUR)) = enable;
+        }
+
+        /**
+         * @param enable connects the weak pull-down (true) or disconnects it (false)
+         */
+        static void pullDown(bool enable){
+            TIVA_HWREG(bitband(GPIO_PDR)) = enable;
+        }
+
+        /**
+         * Drive the pin high
+         */
+        static inline void set(){
+            TIVA_HWREG(DATA) = 0xFF;
+        }
+
+        /**
+         * Drive the pin low
+         */
+        static inline void clear(){
+            TIVA_HWREG(DATA) = 0x00;
+        }
+
+        /**
+         * @param high is the level to drive
+         */
+        static inline void write(bool high){
+            TIVA_HWREG(DATA) = high ? 0xFF : 0x00;
+        }
+
+        /**
+         * Invert the pin output, other pins of the port are untouched
+         */
+        static inline void toggle(){
+            HwReg& data = TIVA_HWREG(DATA);
+            data = ~(uint32_t)data;
+        }
+
+        /**
+         * @return the pin level (true high)
+         */
+        static inline bool read(){
+            return TIVA_HWREG(DATA) != 0;
+        }
+};
+
+
+#endif /* PERIPHERALS_PIN_HPP_ */
@@ -0,0 +1,166 @@
+/*
+ * SPIFlash.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Peripherals/SPIFlash.hpp>
+
+/**
+ * @param spi is an opened SPIMaster with 8-bit frames, chip select on the flash
+ * @param dataLanes is the data phase lanes, SPI_LANES_1, SPI_LANES_2 or SPI_LANES_4
+ */
+SPIFlash::SPIFlash(SPIMaster& spi, uint8_t dataLanes): bus(spi){
+    lanes = SPI_LANES_1;
+    setLanes(dataLanes);
+}
+
+/**
+ * Change the data phase lanes of reads and programs
+ * @param dataLanes is SPI_LANES_1, SPI_LANES_2 or SPI_LANES_4, other values are ignored
+ */
+void SPIFlash::setLanes(uint8_t dataLanes){
+    if(dataLanes == SPI_LANES_1 || dataLanes == SPI_LANES_2 || dataLanes == SPI_LANES_4) lanes = dataLanes;
+}
+
+/**
+ * @return the data phase lanes
+ */
+uint8_t SPIFlash::getLanes(){
+    return lanes;
+}
+
+/**
+ * Private: Send a command, its 3 byte address and dummy bytes on 1 lane
+ *
+ * @param cmd is the command
+ * @param address is the flash address
+ * @param dummy is the quantity of dummy bytes after the address
+ * @param flags are PRINT_WR flags (see SPIMaster::transfer)
+ * @param deadline is the Timebase deadline
+ * @return SPIMaster::send result
+ */
+PrintStatus SPIFlash::command(uint8_t cmd, uint32_t address, uint8_t dummy, uint8_t flags, uint64_t deadline){
+    uint8_t header[4 + SPI_FLASH_DUMMY_BYTES] = {cmd, (uint8_t)(address >> 16), (uint8_t)(address >> 8), (uint8_t)address};
+    for(uint8_t i = 0; i < dummy; i++) header[4 + i] = 0xFF;
+    return bus.send(header, 4 + dummy, SPI_LANES_1, flags, deadline);
+}
+
+/**
+ * Private: Set the flash write enable latch, needed by every program and erase
+ * @param deadline is the Timebase deadline
+ * @return SPIMaster::send result
+ */
+PrintStatus SPIFlash::writeEnable(uint64_t deadline){
+    uint8_t cmd = SPI_FLASH_WRITE_ENABLE;
+    return bus.send(&cmd, 1, SPI_LANES_1, PRINT_WR_CTL_SNGL_TRXN, deadline);
+}
+
+/**
+ * @return JEDEC ID: manufacturer, memory type and capacity bytes (0x00MMTTCC),
+ *      0 if the transfer failed
+ */
+uint32_t SPIFlash::readId(){
+    uint8_t tx[4] = {SPI_FLASH_READ_ID, 0xFF, 0xFF, 0xFF};
+    uint8_t rx[4];
+    if(bus.transfer(tx, rx, 4) != _PRINT_STATUS_OK) return 0;
+    return ((uint32_t)rx[1] << 16) | ((uint32_t)rx[2] << 8) | rx[3];
+}
+
+/**
+ * Read with the fast read command of the data lanes, waits for the data
+ *
+ * @param address is the first flash address
+ * @param buf receives the bytes
+ * @param n is the quantity of bytes
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the bus setTimeout one (per phase)
+ * @return SPIMaster::send or SPIMaster::receive result
+ */
+PrintStatus SPIFlash::read(uint32_t address, void* buf, uint32_t n, uint64_t deadline){
+    uint8_t cmd = lanes == SPI_LANES_4 ? SPI_FLASH_QUAD_READ : (lanes == SPI_LANES_2 ? SPI_FLASH_DUAL_READ : SPI_FLASH_FAST_READ);
+    PrintStatus status = command(cmd, address, SPI_FLASH_DUMMY_BYTES, PRINT_WR_CTL_INIT_TRXN, deadline);
+    if(status != _PRINT_STATUS_OK) return status;   //Chip select already deasserted
+    return bus.receive(buf, n, lanes, PRINT_WR_CTL_END_TRXN, deadline);
+}
+
+/**
+ * Read with the fast read command of the data lanes, the data phase is streamed
+ * to buf by the uDMA (see SPIMaster::receiveAsync), returns after the command
+ *
+ * @param address is the first flash address
+ * @param buf receives the bytes
+ * @param n is the quantity of bytes
+ * @param callback is called from the SSI interrupt when the read completes (optional)
+ * @param arg is passed to the callback
+ * @return BUSY during another transfer, else SPIMaster::send or SPIMaster::receiveAsync result
+ */
+PrintStatus SPIFlash::readAsync(uint32_t address, void* buf, uint32_t n, TransferCallback callback, void* arg){
+    if(bus.busy()) return _PRINT_STATUS_BUSY;
+    uint8_t cmd = lanes == SPI_LANES_4 ? SPI_FLASH_QUAD_READ : (lanes == SPI_LANES_2 ? SPI_FLASH_DUAL_READ : SPI_FLASH_FAST_READ);
+    PrintStatus status = command(cmd, address, SPI_FLASH_DUMMY_BYTES, PRINT_WR_CTL_INIT_TRXN, TIMEBASE_FOREVER);
+    if(status != _PRINT_STATUS_OK) return status;
+    return bus.receiveAsync(buf, n, lanes, callback, arg, PRINT_WR_CTL_END_TRXN);
+}
+
+/**
+ * Program bytes (1 bits to 0, erased bytes are 0xFF), split at the page
+ * boundaries. Waits until every page is programmed
+ *
+ * @param address is the first flash address
+ * @param data are the bytes to program
+ * @param n is the quantity of bytes
+ * @param deadline is the Timebase deadline of the whole call, TIMEBASE_FOREVER
+ *      waits forever (the bus setTimeout limits each transfer)
+ * @return the first failed step result, else OK
+ */
+PrintStatus SPIFlash::program(uint32_t address, const void* data, uint32_t n, uint64_t deadline){
+    const uint8_t* src = (const uint8_t*)data;
+    uint8_t cmd = lanes == SPI_LANES_4 ? SPI_FLASH_QUAD_PROGRAM : SPI_FLASH_PROGRAM;
+    uint8_t dataLanes = lanes == SPI_LANES_4 ? SPI_LANES_4 : SPI_LANES_1;
+    PrintStatus status = _PRINT_STATUS_OK;
+    while(n > 0 && status == _PRINT_STATUS_OK){
+        uint32_t chunk = SPI_FLASH_PAGE - (address & (SPI_FLASH_PAGE - 1));   //Up to the page end
+        if(chunk > n) chunk = n;
+        status = writeEnable(deadline);
+        if(status == _PRINT_STATUS_OK) status = command(cmd, address, 0, PRINT_WR_CTL_INIT_TRXN, deadline);
+        if(status == _PRINT_STATUS_OK) status = bus.send(src, chunk, dataLanes, PRINT_WR_CTL_END_TRXN, deadline);
+        if(status == _PRINT_STATUS_OK) status = waitReady(deadline);
+        address += chunk;
+        src += chunk;
+        n -= chunk;
+    }
+    return status;
+}
+
+/**
+ * Erase the 4 KB sector of an address (bytes to 0xFF), waits until it is erased
+ *
+ * @param address is any address of the sector
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER waits forever
+ *      (the bus setTimeout limits each transfer)
+ * @return the first failed step result, else OK
+ */
+PrintStatus SPIFlash::erase(uint32_t address, uint64_t deadline){
+    PrintStatus status = writeEnable(deadline);
+    if(status == _PRINT_STATUS_OK) status = command(SPI_FLASH_ERASE_4K, address, 0, PRINT_WR_CTL_SNGL_TRXN, deadline);
+    if(status == _PRINT_STATUS_OK) status = waitReady(deadline);
+    return status;
+}
+
+/**
+ * Poll the status register until the write in progress bit clears
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER waits forever
+ * @return OK, TIMEOUT if the deadline passed, or the failed poll result
+ */
+PrintStatus SPIFlash::waitReady(uint64_t deadline){
+    uint8_t tx[2] = {SPI_FLASH_READ_STATUS, 0xFF};
+    uint8_t rx[2];
+    while(1){
+        PrintStatus status = bus.transfer(tx, rx, 2, PRINT_WR_CTL_SNGL_TRXN, deadline);
+        if(status != _PRINT_STATUS_OK) return status;
+        if((rx[1] & SPI_FLASH_STATUS_WIP) == 0) return _PRINT_STATUS_OK;
+        if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+    }
+}
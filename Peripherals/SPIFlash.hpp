@@ -0,0 +1,74 @@
+/*
+ * SPIFlash.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_SPIFLASH_HPP_
+#define PERIPHERALS_SPIFLASH_HPP_
+
+#include <stdint.h>
+#include <Peripherals/SPIMaster.hpp>
+
+// SPI-NOR serial flash on top of SPIMaster (8-bit frames, SPI mode 0 or 3),
+// JEDEC command set with 3 byte addresses. Command, address and dummy clocks
+// go on 1 lane, the data phase on the lanes given to the constructor:
+//      SPI_LANES_1 - FAST READ (0x0B), PAGE PROGRAM (0x02)
+//      SPI_LANES_2 - FAST READ DUAL OUTPUT (0x3B), PAGE PROGRAM (0x02)
+//      SPI_LANES_4 - FAST READ QUAD OUTPUT (0x6B), QUAD INPUT PAGE PROGRAM (0x32)
+// Quad commands need the flash Quad Enable bit set (device specific, see its
+// datasheet): the WP# and HOLD# pins become IO2 and IO3 (XDAT2, XDAT3).
+//
+//   SPIMaster bus(60000000, SPI_SSI3);
+//   SPIFlash flash(bus, SPI_LANES_4);
+//   flash.erase(0x1000);                        //4 KB sector
+//   flash.program(0x1000, data, 300);           //Split at the 256 byte pages
+//   flash.read(0x1000, buf, 300);               //Quad output fast read
+//   flash.readAsync(0x2000, frame, 8192, onFrame);  //Data phase streamed by the uDMA
+//
+// Program and erase wait until the flash is ready again (status register WIP).
+
+#define SPI_FLASH_WRITE_ENABLE  0x06
+#define SPI_FLASH_READ_STATUS   0x05
+#define SPI_FLASH_READ_ID       0x9F    //JEDEC manufacturer and device ID
+#define SPI_FLASH_FAST_READ     0x0B
+#define SPI_FLASH_DUAL_READ     0x3B    //Fast read dual output (1-1-2)
+#define SPI_FLASH_QUAD_READ     0x6B    //Fast read quad output (1-1-4)
+#define SPI_FLASH_PROGRAM       0x02
+#define SPI_FLASH_ERASE_4K      0x20
+
+#ifndef SPI_FLASH_QUAD_PROGRAM
+#define SPI_FLASH_QUAD_PROGRAM  0x32    //Quad input page program (1-1-4), 0x38 on some devices
+#endif
+
+#define SPI_FLASH_STATUS_WIP    0x01    //Write (program, erase) in progress
+#define SPI_FLASH_PAGE          256     //Program page size
+#define SPI_FLASH_SECTOR        4096    //Erase sector size
+#define SPI_FLASH_DUMMY_BYTES   1       //8 dummy clocks of the fast reads, on 1 lane
+
+class SPIFlash{
+    public:
+        SPIFlash(SPIMaster&, uint8_t = SPI_LANES_1);
+
+        void setLanes(uint8_t);
+        uint8_t getLanes();
+
+        uint32_t readId();
+        PrintStatus read(uint32_t, void*, uint32_t, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus readAsync(uint32_t, void*, uint32_t, TransferCallback = 0, void* = 0);
+        PrintStatus program(uint32_t, const void*, uint32_t, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus erase(uint32_t, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus waitReady(uint64_t = TIMEBASE_FOREVER);
+
+    private:
+        SPIMaster& bus;
+        uint8_t lanes;
+
+        PrintStatus command(uint8_t, uint32_t, uint8_t, uint8_t, uint64_t);
+        PrintStatus writeEnable(uint64_t);
+};
+
+
+#endif /* PERIPHERALS_SPIFLASH_HPP_ */
@@ -0,0 +1,868 @@
+/*
+ * SPIMaster.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <../inc/tm4c1294ncpdt.h>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/SPIMaster.hpp>
+#include <Peripherals/Pin.hpp>
+#include "../driverlib/sysctl.h"
+#include "../driverlib/rom_map.h"
+
+static constexpr uint8_t SSI_PORT_OFF[] = {GPIO_PORTA_OFF, GPIO_PORTB_OFF, GPIO_PORTD_OFF, GPIO_PORTQ_OFF}; //Clk, Fss GPIO Base offset
+static constexpr uint8_t SSI_CLKIO_B[] = {2, 5, 3, 0}; //Clk Bit
+static constexpr uint8_t SSI_FSSIO_B[] = {3, 4, 2, 1}; //Fss Bit (chip select GPIO)
+static constexpr uint8_t SSI_DAT_PORT_OFF[] = {GPIO_PORTA_OFF, GPIO_PORTE_OFF, GPIO_PORTD_OFF, GPIO_PORTQ_OFF}; //XDAT0, XDAT1 GPIO Base offset
+static constexpr uint8_t SSI_DAT0IO_B[] = {4, 4, 1, 2}; //XDAT0 (TX) Bit, XDAT1 (RX) = XDAT0 + 1, EXCEPT SSI_2, XDAT1 = XDAT0 - 1
+static constexpr uint8_t SSI_PCTL[] = {15, 15, 15, 14}; //Port Mux alternate function
+static constexpr uint8_t SSI_QUAD_PORT_OFF[] = {GPIO_PORTA_OFF, GPIO_PORTD_OFF, GPIO_PORTD_OFF, GPIO_PORTP_OFF}; //XDAT2, XDAT3 GPIO Base offset
+static constexpr uint8_t SSI_DAT2IO_B[] = {6, 4, 7, 0}; //XDAT2 Bit, XDAT3 = XDAT2 + 1, EXCEPT SSI_2, XDAT3 = XDAT2 - 1
+static constexpr uint8_t SSI_QUAD_PCTL[] = {13, 15, 15, 15}; //XDAT2, XDAT3 Port Mux alternate function
+static const uint8_t SSI_IRQ_N[] = {7, 34, 54, 55}; //NVIC interrupt number
+static const uint8_t SSI_DMA_RX_CH[] = {10, 24, 12, 14}; //uDMA RX channel, TX = RX + 1
+static const uint8_t SSI_DMA_ENC[] = {0, 0, 2, 2}; //uDMA channel map encoding
+
+/**
+ * @return true if the Clk and data pins of every SSI module have their Port
+ *      Mux function (see GPIO_PIN_AF), and the Fss pins are bonded out
+ */
+static constexpr bool ssiPinsValid(){
+    for(uint8_t i = 0; i < sizeof(SSI_PORT_OFF); i++){
+        int8_t next = i != 2 ? 1 : -1;  //XDAT1, XDAT3 bit from XDAT0, XDAT2
+        if(!gpioHasAF(SSI_PORT_OFF[i], SSI_CLKIO_B[i], SSI_PCTL[i]) || !gpioPinExists(SSI_PORT_OFF[i], SSI_FSSIO_B[i])) return false;
+        if(!gpioHasAF(SSI_DAT_PORT_OFF[i], SSI_DAT0IO_B[i], SSI_PCTL[i]) || !gpioHasAF(SSI_DAT_PORT_OFF[i], SSI_DAT0IO_B[i] + next, SSI_PCTL[i])) return false;
+        if(!gpioHasAF(SSI_QUAD_PORT_OFF[i], SSI_DAT2IO_B[i], SSI_QUAD_PCTL[i]) || !gpioHasAF(SSI_QUAD_PORT_OFF[i], SSI_DAT2IO_B[i] + next, SSI_QUAD_PCTL[i])) return false;
+    }
+    return true;
+}
+static_assert(ssiPinsValid(), "SSI pin table doesn't match the GPIO alternate functions");
+
+#define SSI_CR1_LBM     0x01    //Loopback mode
+#define SSI_CR1_SSE     0x02    //SSI enable
+#define SSI_CR1_EOT     0x10    //TXRIS at end of transmission (FIFO empty, not busy)
+#define SSI_CR1_MODE_M  0xC0    //Data lanes: legacy, bi-SSI, quad-SSI, advanced
+#define SSI_CR1_MODE_BI 0x40
+#define SSI_CR1_MODE_QUAD   0x80
+#define SSI_CR1_DIR     0x100   //Bi and quad modes: receive (TX FIFO frames only clock the bus)
+#define SSI_CR1_HSCLKEN 0x200   //High speed clock, SSInClk = system clock / 2
+
+#define SSI_SR_TFE      0x01    //Transmit FIFO empty
+#define SSI_SR_TNF      0x02    //Transmit FIFO not full
+#define SSI_SR_RNE      0x04    //Receive FIFO not empty
+#define SSI_SR_BSY      0x10    //Sending or receiving a frame, or TX FIFO not empty
+
+#define SSI_RIS_RXRIS   0x04    //Receive FIFO half full or more (level, raw status)
+
+#define SSI_IM_RORIM    0x01    //Receive overrun interrupt mask
+#define SSI_IM_TXIM     0x08    //Transmit FIFO (end of transmission with EOT) interrupt mask
+#define SSI_IM_DMARXIM  0x10    //Receive DMA complete interrupt mask
+#define SSI_IM_DMATXIM  0x20    //Transmit DMA complete interrupt mask
+
+#define SSI_DMACTL_RXDMAE   0x01
+#define SSI_DMACTL_TXDMAE   0x02
+
+#define GPIO_UNLOCK_KEY     0x4C4F434B  //GPIOLOCK value that unlocks GPIOCR
+
+static const uint16_t fillFrame = SPI_FILL; //Source of the uDMA TX channel without tx data
+
+SPIMaster* SPIMaster::instances[4] = {0};
+
+/**
+ * Default SPIMaster constructor
+ * SSI0 selected, 1 MHz, SPI mode 0, 8-bit frames
+ */
+SPIMaster::SPIMaster(){
+    SSI = 0;
+    rate = 1000000;
+    format = SPI_MODE_0;
+    frameBits = 8;
+    csPort = SSI_PORT_OFF[0];
+    csBit = SSI_FSSIO_B[0];
+    opened = false;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    QUAD_PORT_R = 0;
+    dmaLeft = 0;    dmaBusy = false;
+    open();
+}
+
+/**
+ * SPIMaster Constructor
+ * @param bitRate is the SSInClk frequency, the closest one not faster is used
+ *      (system clock / 2 at most, 60 MHz with the PLL)
+ * @param ssi is the ssi module to use (0 to 3)
+ * @param mode is the clock polarity and phase, SPI_MODE_0 to SPI_MODE_3
+ * @param bits is the frame size (4 to 16 bits)
+ */
+SPIMaster::SPIMaster(uint32_t bitRate, uint8_t ssi, uint8_t mode, uint8_t bits){
+    SSI = ssi;
+    rate = bitRate;
+    format = mode & SPI_MODE_3;
+    frameBits = bits < 4 ? 4 : (bits > 16 ? 16 : bits);
+    csPort = ssi <= 3 ? SSI_PORT_OFF[ssi] : 0;
+    csBit = ssi <= 3 ? SSI_FSSIO_B[ssi] : 0;
+    opened = false;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    QUAD_PORT_R = 0;
+    dmaLeft = 0;    dmaBusy = false;
+    open();
+}
+
+/**
+ * SPIMaster destructor, the SSIn interrupt and the clock switches stop using this instance
+ */
+SPIMaster::~SPIMaster(){
+    if(SSI <= 3 && instances[SSI] == this) instances[SSI] = 0;
+}
+
+/**
+ * TM4C1294 has 4 SSI Modules SSI0 - SSI3
+ * @return true if a valid SSI was selected
+ */
+inline bool SPIMaster::assertValidSSI(){
+    return SSI <= 3;
+}
+
+/**
+ * Private: bytes per frame in transfer buffers
+ * @return 1 for frames up to 8 bits, 2 for 9 to 16 bits
+ */
+inline uint8_t SPIMaster::itemSize(){
+    return frameBits > 8 ? 2 : 1;
+}
+
+/**
+ * Open the Selected TM4C1294 SSI if valid
+ * Clk and data pins are mapped to the SSI module, chip select is a GPIO output
+ * (deasserted). The SSI is a master with the constructor format and bit rate
+ */
+void SPIMaster::open(){
+    if(!assertValidSSI() || opened) return;
+
+    uint8_t clk = SSI_CLKIO_B[SSI];
+    uint8_t dat0 = SSI_DAT0IO_B[SSI];
+    uint8_t dats = SSI != 2 ? 0x03 << dat0 : 0x03 << (dat0 - 1); //XDAT0, XDAT1 pins
+
+    SYSCTL_RCGCSSI_R |= 1 << SSI;   //Enable SSI Clock
+    uint32_t ports = (1 << SSI_PORT_OFF[SSI]) | (1 << SSI_DAT_PORT_OFF[SSI]);
+    SYSCTL_RCGCGPIO_R |= ports;     //Enable GPIO Ports for Clk, data Signals
+    while((SYSCTL_PRSSI_R & (1 << SSI)) == 0 || (SYSCTL_PRGPIO_R & ports) != ports);
+
+    PORT_R = HWREG_PTR(GPIO_PORT_BASE + (SSI_PORT_OFF[SSI] << 12));     //Set pointer to GPIO Port Base Register
+    DAT_PORT_R = HWREG_PTR(GPIO_PORT_BASE + (SSI_DAT_PORT_OFF[SSI] << 12));
+    SSI_R = HWREG_PTR(SSI_BASE_REG + (SSI << 12));  //Set pointer to base SSI Register
+    SSI_SR_R = SSI_R + (0x00C >> 2);
+    SSI_DR_R = SSI_R + (0x008 >> 2);
+
+    muxPins(PORT_R, 1 << clk, SSI_PCTL[SSI]);       //Clk
+    muxPins(DAT_PORT_R, dats, SSI_PCTL[SSI]);       //XDAT0, XDAT1
+
+    *(SSI_R + (0x004 >> 2)) = 0x00;     //Disable SSI, master mode
+    *(SSI_R + (0xFC8 >> 2)) = 0x00;     //System clock as SSI clock source
+    *(SSI_R + (0x014 >> 2)) = 0x00;     //Mask all SSI interrupts
+    *(SSI_R + (0x024 >> 2)) = 0x00;     //No uDMA requests
+    setDivisors(systemClock());         //Frame format, bit rate, enable SSI
+    opened = true;
+    setChipSelect(csPort, csBit);
+
+    instances[SSI] = this;              //Route SSIn interrupt to this instance
+    Clock::subscribe(onClockChange);
+    uint8_t irq = SSI_IRQ_N[SSI];
+    *(&NVIC_EN0_R + (irq >> 5)) = 1 << (irq & 0x1F); //Enable NVIC SSIn Interrupt
+}
+
+/**
+ * Close the SSI: transfers in progress end with ERROR, Clk and data pins go
+ * back to GPIO (disabled) and the module clock is gated. Chip select stays deasserted
+ */
+void SPIMaster::close(){
+    if(!opened) return;
+    if(dmaBusy) endDma(_PRINT_STATUS_ERROR);
+
+    uint8_t irq = SSI_IRQ_N[SSI];
+    *(&NVIC_DIS0_R + (irq >> 5)) = 1 << (irq & 0x1F); //Disable NVIC SSIn Interrupt
+    *(SSI_R + (0x014 >> 2)) = 0x00;     //Mask interrupts
+    *(SSI_R + (0x004 >> 2)) = 0x00;     //Disable SSI
+    if(instances[SSI] == this) instances[SSI] = 0;
+
+    uint8_t dat0 = SSI_DAT0IO_B[SSI];
+    unmuxPins(PORT_R, 1 << SSI_CLKIO_B[SSI]);
+    unmuxPins(DAT_PORT_R, SSI != 2 ? 0x03 << dat0 : 0x03 << (dat0 - 1));
+    if(QUAD_PORT_R != 0){
+        uint8_t dat2 = SSI_DAT2IO_B[SSI];
+        unmuxPins(QUAD_PORT_R, SSI != 2 ? 0x03 << dat2 : 0x03 << (dat2 - 1));
+        QUAD_PORT_R = 0;
+    }
+
+    SYSCTL_RCGCSSI_R &= ~(1 << SSI);    //Disable SSI clock
+    opened = false;
+}
+
+/**
+ * Private: Map GPIO pins to a SSI alternate function, digital enabled
+ * @param port is the GPIO port base
+ * @param pins is the pin mask
+ * @param pctl is the Port Mux value
+ */
+void SPIMaster::muxPins(HwReg* port, uint8_t pins, uint8_t pctl){
+    uint32_t mask = 0;
+    uint32_t mux = 0;
+    for(uint8_t b = 0; b < 8; b++){
+        if((pins & (1 << b)) == 0) continue;
+        mask |= 0x0F << (b << 2);
+        mux |= pctl << (b << 2);
+    }
+    *(port + (0x420 >> 2)) |= pins;                                 //Select alternative function
+    *(port + (0x528 >> 2)) &= ~pins;                                //Disable analog function
+    *(port + (0x52C >> 2)) = (*(port + (0x52C >> 2)) & ~mask) | mux;    //Port Mux pins to SSI
+    *(port + (0x51C >> 2)) |= pins;                                 //Enable Pins
+}
+
+/**
+ * Private: Return pins mapped by muxPins to GPIO, disabled
+ * @param port is the GPIO port base
+ * @param pins is the pin mask
+ */
+void SPIMaster::unmuxPins(HwReg* port, uint8_t pins){
+    uint32_t mask = 0;
+    for(uint8_t b = 0; b < 8; b++){
+        if(pins & (1 << b)) mask |= 0x0F << (b << 2);
+    }
+    *(port + (0x51C >> 2)) &= ~pins;                                //Disable Pins
+    *(port + (0x52C >> 2)) &= ~mask;                                //Port Mux pins to GPIO
+    *(port + (0x420 >> 2)) &= ~pins;                                //Disable alternative function
+}
+
+/**
+ * Change the frame format, waits for transfers in progress
+ * The chip select level is kept, so a transaction may mix frame sizes
+ *
+ * @param mode is the clock polarity and phase, SPI_MODE_0 to SPI_MODE_3
+ * @param bits is the frame size (4 to 16 bits)
+ */
+void SPIMaster::setFormat(uint8_t mode, uint8_t bits){
+    format = mode & SPI_MODE_3;
+    frameBits = bits < 4 ? 4 : (bits > 16 ? 16 : bits);
+    if(!opened) return;
+    while(dmaBusy || (*SSI_SR_R & SSI_SR_BSY)) BOARD_WAIT();
+    setDivisors(systemClock());
+}
+
+/**
+ * Change the bit rate, waits for transfers in progress
+ * @param bitRate is the SSInClk frequency, the closest one not faster is used
+ */
+void SPIMaster::setBitRate(uint32_t bitRate){
+    rate = bitRate;
+    if(!opened) return;
+    while(dmaBusy || (*SSI_SR_R & SSI_SR_BSY)) BOARD_WAIT();
+    setDivisors(systemClock());
+}
+
+/**
+ * @return the SSInClk frequency in use, 0 if not opened
+ */
+uint32_t SPIMaster::getBitRate(){
+    if(!opened) return 0;
+    uint32_t cps = *(SSI_R + (0x010 >> 2));
+    uint32_t scr = (*SSI_R >> 8) & 0xFF;
+    return systemClock() / (cps * (scr + 1));
+}
+
+/**
+ * Private: Set the clock divisors and the frame format, according datasheet
+ * SSInClk = clock / (CPSDVSR x (1 + SCR)), CPSDVSR even from 2 to 254, SCR 0 to 255.
+ * The smallest prescaler that reaches the bit rate is used (finer SCR steps),
+ * rounding to the next slower rate. The SSI is disabled meanwhile
+ *
+ * @param clock is the system clock
+ */
+void SPIMaster::setDivisors(uint32_t clock){
+    uint32_t divisor = rate == 0 ? 0xFFFFFFFF : (clock + rate - 1) / rate;  //System clocks per bit, rounded up
+    if(divisor < 2) divisor = 2;
+    uint32_t cps = (divisor + 255) / 256;
+    cps = cps < 2 ? 2 : (cps + 1) & ~0x01;
+    if(cps > 254) cps = 254;
+    uint32_t scr = (divisor + cps - 1) / cps;
+    if(scr > 256) scr = 256;
+
+    uint32_t cr1 = *(SSI_R + (0x004 >> 2)) & ~(SSI_CR1_SSE | SSI_CR1_HSCLKEN);
+    *(SSI_R + (0x004 >> 2)) = cr1;                                  //Disable SSI
+    *(SSI_R + (0x010 >> 2)) = cps;                                  //Clock prescaler
+    *SSI_R = ((scr - 1) << 8) | format | (frameBits - 1);           //SCR, SPH, SPO, Freescale SPI, data size
+    if(cps * scr == 2) cr1 |= SSI_CR1_HSCLKEN;
+    *(SSI_R + (0x004 >> 2)) = cr1 | SSI_CR1_SSE;                    //Enable SSI
+}
+
+/**
+ * Private: system clock switch listener (see Clock)
+ * Transfers in flight finish at the old clock, the divisors are computed
+ * again for the new one
+ *
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+void SPIMaster::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    (void)oldFreq;
+    for(uint8_t i = 0; i < 4; i++){
+        SPIMaster* spi = instances[i];
+        if(spi == 0) continue;
+        if(phase == CLOCK_PRE_CHANGE){
+            while(spi->dmaBusy || (*spi->SSI_SR_R & SSI_SR_BSY)) BOARD_WAIT();
+        }else{
+            spi->setDivisors(newFreq);
+        }
+    }
+}
+
+/**
+ * Select the chip select pin, driven as a GPIO output, active low
+ * The module FSS pin is used by default
+ *
+ * @param port is the GPIO port (GPIO_PORTx_OFF)
+ * @param bit is the pin (0 to 7)
+ */
+void SPIMaster::setChipSelect(uint8_t port, uint8_t bit){
+    if(!assertValidSSI() || port > GPIO_PORTQ_OFF || bit > 7) return;
+    csPort = port;
+    csBit = bit;
+    if(!opened) return;
+
+    SYSCTL_RCGCGPIO_R |= 1 << port;     //Enable GPIO Port for the chip select
+    while((SYSCTL_PRGPIO_R & (1 << port)) == 0);
+    HwReg* cs = HWREG_PTR(GPIO_PORT_BASE + (port << 12));
+    CS_R = cs + (1 << bit);             //GPIODATA masked to the pin
+    *CS_R = 0xFF;                       //Deasserted before driving it
+    *(cs + (0x420 >> 2)) &= ~(1 << bit);                //GPIO function
+    *(cs + (0x52C >> 2)) &= ~(0x0F << (bit << 2));
+    *(cs + (0x528 >> 2)) &= ~(1 << bit);                //Disable analog function
+    *(cs + (0x400 >> 2)) |= 1 << bit;                   //Output
+    *(cs + (0x51C >> 2)) |= 1 << bit;                   //Enable pin
+}
+
+/**
+ * Limit the time blocking transfers and writes wait for the SSI (timed out
+ * calls return _PRINT_STATUS_TIMEOUT). The limit applies to each call, from its start
+ *
+ * @param us is the limit in microseconds, TIMEBASE_NO_TIMEOUT (default) to wait forever
+ */
+void SPIMaster::setTimeout(uint32_t us){
+    timeoutUs = us;
+}
+
+/**
+ * Private: deadline of a blocking call
+ * @param deadline is the caller deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return the deadline to wait for, Timer1 isn't used without a limit
+ */
+uint64_t SPIMaster::until(uint64_t deadline){
+    if(deadline != TIMEBASE_FOREVER || timeoutUs == TIMEBASE_NO_TIMEOUT) return deadline;
+    return Timebase::deadline(timeoutUs);
+}
+
+/**
+ * Connect the SSI TX output to its own RX input (internal loopback),
+ * so transfers receive the frames they send. For self tests
+ *
+ * @param enable selects loopback (true) or normal operation (false)
+ */
+void SPIMaster::setLoopback(bool enable){
+    if(!opened) return;
+    while(dmaBusy || (*SSI_SR_R & SSI_SR_BSY)) BOARD_WAIT();
+    uint32_t cr1 = *(SSI_R + (0x004 >> 2)) & ~(SSI_CR1_SSE | SSI_CR1_LBM);
+    *(SSI_R + (0x004 >> 2)) = cr1;                                  //Disable SSI
+    *(SSI_R + (0x004 >> 2)) = cr1 | (enable ? SSI_CR1_LBM : 0) | SSI_CR1_SSE;
+}
+
+/**
+ * Private: Select the data lanes and direction of the next frames (SSICR1 MODE
+ * and DIR), waits for the frames in flight. Chip select is kept, so a transaction
+ * may mix lanes. XDAT2, XDAT3 are mapped to the SSI on the first 4 lane call
+ *
+ * @param lanes is SPI_LANES_1 (legacy full-duplex), SPI_LANES_2 or SPI_LANES_4
+ * @param read is the direction of 2 and 4 lane frames (true receives)
+ * @return ERROR if lanes isn't valid, or over 1 lane without 8-bit frames, else OK
+ */
+PrintStatus SPIMaster::setLanes(uint8_t lanes, bool read){
+    uint32_t mode;
+    if(lanes == SPI_LANES_1) mode = 0;
+    else if(lanes == SPI_LANES_2) mode = SSI_CR1_MODE_BI;
+    else if(lanes == SPI_LANES_4) mode = SSI_CR1_MODE_QUAD;
+    else return _PRINT_STATUS_ERROR;
+    if(mode != 0){
+        if(frameBits != 8) return _PRINT_STATUS_ERROR;  //Advanced modes move bytes
+        if(read) mode |= SSI_CR1_DIR;
+    }
+
+    uint32_t cr1 = *(SSI_R + (0x004 >> 2));
+    if((cr1 & (SSI_CR1_MODE_M | SSI_CR1_DIR)) == mode) return _PRINT_STATUS_OK;
+    if(lanes == SPI_LANES_4 && QUAD_PORT_R == 0){
+        uint8_t port = SSI_QUAD_PORT_OFF[SSI];
+        uint8_t dat2 = SSI_DAT2IO_B[SSI];
+        uint8_t dats = SSI != 2 ? 0x03 << dat2 : 0x03 << (dat2 - 1); //XDAT2, XDAT3 pins
+        SYSCTL_RCGCGPIO_R |= 1 << port;
+        while((SYSCTL_PRGPIO_R & (1 << port)) == 0);
+        QUAD_PORT_R = HWREG_PTR(GPIO_PORT_BASE + (port << 12));
+        if(SSI == 2){   //PD7 is a locked (NMI) pin, commit its new function
+            *(QUAD_PORT_R + (0x520 >> 2)) = GPIO_UNLOCK_KEY;
+            *(QUAD_PORT_R + (0x524 >> 2)) |= dats;
+            *(QUAD_PORT_R + (0x520 >> 2)) = 0x00;
+        }
+        muxPins(QUAD_PORT_R, dats, SSI_QUAD_PCTL[SSI]);
+    }
+    while(*SSI_SR_R & SSI_SR_BSY) BOARD_WAIT();
+    *(SSI_R + (0x004 >> 2)) = (cr1 & ~(SSI_CR1_MODE_M | SSI_CR1_DIR)) | mode;
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Private: Assert chip select at the start of a transaction
+ * @param flags are the PRINT_WR flags of the call (SINGLE mode or START)
+ */
+void SPIMaster::select(uint8_t flags){
+    if((flags & PRINT_WR_MODE) == PRINT_WR_MOD_SINGLE || (flags & PRINT_WR_START)) *CS_R = 0x00;
+}
+
+/**
+ * Private: Deassert chip select at the end of a transaction, or if it failed
+ * @param flags are the PRINT_WR flags of the call (SINGLE mode or STOP)
+ * @param status is the call result
+ */
+void SPIMaster::deselect(uint8_t flags, PrintStatus status){
+    if((flags & PRINT_WR_MODE) == PRINT_WR_MOD_SINGLE || (flags & PRINT_WR_STOP) || status != _PRINT_STATUS_OK){
+        *CS_R = 0xFF;
+    }
+}
+
+/**
+ * Private: Empty the RX FIFO and clear its overrun flag (frames received
+ * while nobody read them, Print writes and transfers without rx)
+ */
+void SPIMaster::drain(){
+    while(*SSI_SR_R & SSI_SR_RNE) (void)*SSI_DR_R;
+    *(SSI_R + (0x020 >> 2)) = SSI_IM_RORIM;
+}
+
+/**
+ * Private: Full-duplex FIFO transfer, chip select untouched
+ * Up to SPI_FIFO_DEPTH frames are in flight, so the TX FIFO never fills
+ * and the RX FIFO never overruns: frames are written with no status check.
+ * A half full RX FIFO (RXRIS) is read with no status check per frame, the
+ * fastest lanes (quad at 60 MHz, a byte every 4 system clocks) outrun a
+ * status read per frame
+ *
+ * @param tx are the frames to send (itemSize() bytes each), 0 sends SPI_FILL
+ * @param rx receives the frames (itemSize() bytes each), 0 discards them
+ * @param n is the quantity of frames
+ * @param deadline is the Timebase deadline
+ * @return OK, or TIMEOUT if the deadline passed
+ */
+PrintStatus SPIMaster::exchange(const uint8_t* tx, uint8_t* rx, uint16_t n, uint64_t deadline){
+    bool wide = itemSize() == 2;
+    uint16_t sent = 0;
+    uint16_t received = 0;
+    while(received < n){
+        while(sent < n && (uint16_t)(sent - received) < SPI_FIFO_DEPTH){
+            *SSI_DR_R = tx == 0 ? SPI_FILL : (wide ? ((const uint16_t*)tx)[sent] : tx[sent]);
+            sent++;
+        }
+        uint8_t ready;
+        if((uint16_t)(sent - received) >= SPI_FIFO_DEPTH / 2 && (*(SSI_R + (0x018 >> 2)) & SSI_RIS_RXRIS)){
+            ready = SPI_FIFO_DEPTH / 2;     //Half full: one status read for half the FIFO
+        }else if(*SSI_SR_R & SSI_SR_RNE){
+            ready = 1;
+        }else{
+            if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+            BOARD_WAIT();
+            continue;
+        }
+        for(; ready > 0; ready--){
+            uint16_t frame = (uint16_t)*SSI_DR_R;
+            if(rx != 0){
+                if(wide) ((uint16_t*)rx)[received] = frame;
+                else rx[received] = (uint8_t)frame;
+            }
+            received++;
+        }
+    }
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Private: Send only FIFO transfer, 2 and 4 lane write frames fill no RX FIFO
+ * Waits until the last frame left the SSI, chip select untouched
+ *
+ * @param tx are the bytes to send
+ * @param n is the quantity of bytes
+ * @param deadline is the Timebase deadline
+ * @return OK, or TIMEOUT if the deadline passed
+ */
+PrintStatus SPIMaster::push(const uint8_t* tx, uint32_t n, uint64_t deadline){
+    for(uint32_t sent = 0; sent < n; sent++){
+        while((*SSI_SR_R & SSI_SR_TNF) == 0){
+            if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+            BOARD_WAIT();
+        }
+        *SSI_DR_R = tx[sent];
+    }
+    while(*SSI_SR_R & SSI_SR_BSY){
+        if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+        BOARD_WAIT();
+    }
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Send and receive frames at once (full-duplex), waits until the last one is received
+ *
+ * @param tx are the frames to send: uint8_t for frames up to 8 bits, uint16_t
+ *      over 8 bits (0 sends SPI_FILL frames)
+ * @param rx receives the frames, same type as tx (0 discards them)
+ * @param n is the quantity of frames
+ * @param flags are PRINT_WR flags: SINGLE mode asserts chip select around the
+ *      frames, MULTIPLE mode asserts it with START and deasserts it with STOP
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return ERROR if not opened or n = 0, BUSY during a transferAsync, TIMEOUT
+ *      if the deadline passed (chip select deasserted), else OK
+ */
+PrintStatus SPIMaster::transfer(const void* tx, void* rx, uint16_t n, uint8_t flags, uint64_t deadline){
+    if(!opened || n == 0) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    deadline = until(deadline);
+    setLanes(SPI_LANES_1, true);
+    drain();
+    select(flags);
+    PrintStatus status = exchange((const uint8_t*)tx, (uint8_t*)rx, n, deadline);
+    deselect(flags, status);
+    return status;
+}
+
+/**
+ * Send frames on 1 data lane, or 8-bit frames on 2 or 4, waits until the last
+ * one left the SSI. With 1 lane the received frames are discarded
+ *
+ * @param tx are the frames to send (see transfer)
+ * @param n is the quantity of frames
+ * @param lanes is SPI_LANES_1, SPI_LANES_2 or SPI_LANES_4
+ * @param flags are PRINT_WR flags (see transfer)
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return ERROR if not opened, n = 0, lanes not valid or frames not 8-bit over
+ *      1 lane, BUSY during a transferAsync, TIMEOUT if the deadline passed
+ *      (chip select deasserted), else OK
+ */
+PrintStatus SPIMaster::send(const void* tx, uint32_t n, uint8_t lanes, uint8_t flags, uint64_t deadline){
+    if(!opened || n == 0 || tx == 0) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    if(setLanes(lanes, false) != _PRINT_STATUS_OK){
+        deselect(flags, _PRINT_STATUS_ERROR);
+        return _PRINT_STATUS_ERROR;
+    }
+    deadline = until(deadline);
+    drain();
+    select(flags);
+
+    const uint8_t* data = (const uint8_t*)tx;
+    PrintStatus status = _PRINT_STATUS_OK;
+    if(lanes != SPI_LANES_1){
+        status = push(data, n, deadline);
+    }else{
+        while(n > 0 && status == _PRINT_STATUS_OK){
+            uint16_t chunk = n > 0xFFFF ? 0xFFFF : (uint16_t)n;
+            status = exchange(data, 0, chunk, deadline);
+            data += chunk * itemSize();
+            n -= chunk;
+        }
+    }
+    deselect(flags, status);
+    return status;
+}
+
+/**
+ * Receive frames on 1 data lane, or 8-bit frames on 2 or 4, waits until the last
+ * one is received. With 1 lane SPI_FILL frames are sent meanwhile
+ *
+ * @param rx receives the frames (see transfer)
+ * @param n is the quantity of frames
+ * @param lanes is SPI_LANES_1, SPI_LANES_2 or SPI_LANES_4
+ * @param flags are PRINT_WR flags (see transfer)
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return same as send
+ */
+PrintStatus SPIMaster::receive(void* rx, uint32_t n, uint8_t lanes, uint8_t flags, uint64_t deadline){
+    if(!opened || n == 0 || rx == 0) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    if(setLanes(lanes, true) != _PRINT_STATUS_OK){
+        deselect(flags, _PRINT_STATUS_ERROR);
+        return _PRINT_STATUS_ERROR;
+    }
+    deadline = until(deadline);
+    drain();
+    select(flags);
+
+    uint8_t* data = (uint8_t*)rx;
+    PrintStatus status = _PRINT_STATUS_OK;
+    while(n > 0 && status == _PRINT_STATUS_OK){
+        uint16_t chunk = n > 0xFFFF ? 0xFFFF : (uint16_t)n;
+        status = exchange(0, data, chunk, deadline);
+        data += chunk * itemSize();
+        n -= chunk;
+    }
+    deselect(flags, status);
+    return status;
+}
+
+/**
+ * Send and receive frames with the uDMA, returns without waiting
+ * Buffers over UDMA_MAX_TRANSFER frames are moved in chunks, programmed from
+ * the SSI interrupt. Without rx only the TX channel is used, the transfer
+ * ends when the last frame left the SSI
+ *
+ * @param tx are the frames to send (see transfer), 0 sends SPI_FILL frames
+ * @param rx receives the frames (see transfer), 0 discards them
+ * @param n is the quantity of frames
+ * @param callback is called from the SSI interrupt when the transfer completes,
+ *      after chip select is deasserted (optional)
+ * @param arg is passed to the callback
+ * @param flags are PRINT_WR flags (see transfer)
+ * @return BUSY if a transfer is in progress or a channel is in use,
+ *      ERROR if not opened, n = 0 or neither tx nor rx given
+ */
+PrintStatus SPIMaster::transferAsync(const void* tx, void* rx, uint32_t n, TransferCallback callback, void* arg, uint8_t flags){
+    if(!opened || n == 0 || (tx == 0 && rx == 0)) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    setLanes(SPI_LANES_1, true);
+    return startAsync(tx, rx, n, callback, arg, flags);
+}
+
+/**
+ * Receive frames on 1 data lane, or 8-bit frames on 2 or 4, with the uDMA, returns
+ * without waiting. Streams a flash read to memory (see SPIFlash::readAsync),
+ * the uDMA TX channel sends the frames that clock the bus
+ *
+ * @param rx receives the frames (see transfer)
+ * @param n is the quantity of frames
+ * @param lanes is SPI_LANES_1, SPI_LANES_2 or SPI_LANES_4
+ * @param callback is called from the SSI interrupt when the transfer completes (optional)
+ * @param arg is passed to the callback
+ * @param flags are PRINT_WR flags (see transfer)
+ * @return BUSY if a transfer is in progress or a channel is in use, ERROR if
+ *      not opened, n = 0, lanes not valid or frames not 8-bit over 1 lane
+ */
+PrintStatus SPIMaster::receiveAsync(void* rx, uint32_t n, uint8_t lanes, TransferCallback callback, void* arg, uint8_t flags){
+    if(!opened || n == 0 || rx == 0) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    if(setLanes(lanes, true) != _PRINT_STATUS_OK){
+        deselect(flags, _PRINT_STATUS_ERROR);
+        return _PRINT_STATUS_ERROR;
+    }
+    return startAsync(0, rx, n, callback, arg, flags);
+}
+
+/**
+ * Private: Claim the uDMA channels and start a transferAsync or receiveAsync
+ * transfer, lanes already selected (see transferAsync for the parameters)
+ * @return BUSY if a channel is in use, else OK
+ */
+PrintStatus SPIMaster::startAsync(const void* tx, void* rx, uint32_t n, TransferCallback callback, void* arg, uint8_t flags){
+    uint8_t ch = SSI_DMA_RX_CH[SSI];
+    bool claimed = UDMA::claim(ch + 1, SSI_DMA_ENC[SSI], this, onDmaError);
+    if(claimed && rx != 0 && !UDMA::claim(ch, SSI_DMA_ENC[SSI], this, onDmaError)){
+        UDMA::release(ch + 1, this);
+        claimed = false;
+    }
+    if(!claimed){   //Ends a transaction started by a blocking call
+        deselect(flags, _PRINT_STATUS_BUSY);
+        return _PRINT_STATUS_BUSY;
+    }
+
+    dmaTx = (const uint8_t*)tx;
+    dmaRx = (uint8_t*)rx;
+    dmaLeft = n;
+    dmaFlags = flags;
+    dmaCb = callback;
+    dmaArg = arg;
+    dmaBusy = true;
+
+    drain();
+    select(flags);
+    *(SSI_R + (0x020 >> 2)) = SSI_IM_DMARXIM | SSI_IM_DMATXIM;     //Clear stale DMA complete
+    if(rx != 0){
+        *(SSI_R + (0x024 >> 2)) = SSI_DMACTL_RXDMAE | SSI_DMACTL_TXDMAE;
+        *(SSI_R + (0x014 >> 2)) |= SSI_IM_DMARXIM;                  //Done when the last frame is received
+    }else{
+        *(SSI_R + (0x004 >> 2)) |= SSI_CR1_EOT;                     //TXRIS at end of transmission
+        *(SSI_R + (0x024 >> 2)) = SSI_DMACTL_TXDMAE;
+        *(SSI_R + (0x014 >> 2)) |= SSI_IM_DMATXIM;
+    }
+    startDma();
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * @return true while a transferAsync transfer is in progress
+ */
+bool SPIMaster::busy(){
+    return dmaBusy;
+}
+
+/**
+ * Private: Program the next chunk (up to UDMA_MAX_TRANSFER frames), RX
+ * channel first so no received frame is missed
+ */
+void SPIMaster::startDma(){
+    uint16_t chunk = dmaLeft > UDMA_MAX_TRANSFER ? UDMA_MAX_TRANSFER : dmaLeft;
+    uint8_t size = itemSize();
+    uint8_t ch = SSI_DMA_RX_CH[SSI];
+    dmaLeft -= chunk;
+    if(dmaRx != 0){
+        UDMA::transfer(ch, SSI_DR_R, dmaRx, chunk,
+                       (size == 2 ? UDMA_CTL_PERIPH_TO_MEM_16 : UDMA_CTL_PERIPH_TO_MEM) | UDMA_CTL_ARB_4);
+        dmaRx += chunk * size;
+    }
+    uint32_t ctl = (size == 2 ? UDMA_CTL_MEM_TO_PERIPH_16 : UDMA_CTL_MEM_TO_PERIPH) | UDMA_CTL_ARB_4;
+    if(dmaTx != 0){
+        UDMA::transfer(ch + 1, dmaTx, SSI_DR_R, chunk, ctl);
+        dmaTx += chunk * size;
+    }else{
+        UDMA::transfer(ch + 1, &fillFrame, SSI_DR_R, chunk, ctl | UDMA_CTL_SRC_INC_NONE);
+    }
+}
+
+/**
+ * Private: Finish transferAsync transfer, release the channels and notify the user
+ * @param status is the transfer result
+ */
+void SPIMaster::endDma(PrintStatus status){
+    uint8_t ch = SSI_DMA_RX_CH[SSI];
+    *(SSI_R + (0x014 >> 2)) &= ~(SSI_IM_DMARXIM | SSI_IM_DMATXIM | SSI_IM_TXIM);
+    *(SSI_R + (0x024 >> 2)) = 0x00;
+    *(SSI_R + (0x004 >> 2)) &= ~SSI_CR1_EOT;
+    UDMA::release(ch + 1, this);
+    UDMA::release(ch, this);
+    drain();
+    dmaLeft = 0;
+    dmaBusy = false;
+    deselect(dmaFlags, status);
+    if(dmaCb) dmaCb(status, dmaArg);
+}
+
+/**
+ * Private: uDMA bus error, abort the transfer if one of its channels was stopped
+ * @param owner is the SPIMaster instance
+ */
+void SPIMaster::onDmaError(void* owner){
+    SPIMaster* spi = (SPIMaster*)owner;
+    uint8_t ch = SSI_DMA_RX_CH[spi->SSI];
+    if(!spi->dmaBusy) return;
+    if(!UDMA::isActive(ch + 1) || (spi->dmaRx != 0 && !UDMA::isActive(ch))) spi->endDma(_PRINT_STATUS_ERROR);
+}
+
+/**
+ * Private: SSIn interrupt service routine for this instance
+ */
+void SPIMaster::handleInterrupt(){
+    uint32_t mis = *(SSI_R + (0x01C >> 2)); //Masked interrupt status
+    if(mis & SSI_IM_DMARXIM){
+        *(SSI_R + (0x020 >> 2)) = SSI_IM_DMARXIM;   //Clear RX DMA complete
+        if(dmaLeft != 0) startDma();
+        else if(dmaBusy) endDma(_PRINT_STATUS_OK);
+    }
+    if(mis & SSI_IM_DMATXIM){
+        *(SSI_R + (0x020 >> 2)) = SSI_IM_DMATXIM;   //Clear TX DMA complete
+        if(dmaLeft != 0){
+            startDma();
+        }else{  //Last frames still in the FIFO, wait for the end of transmission
+            *(SSI_R + (0x014 >> 2)) = (*(SSI_R + (0x014 >> 2)) & ~SSI_IM_DMATXIM) | SSI_IM_TXIM;
+        }
+    }
+    if(mis & SSI_IM_TXIM){
+        if(dmaBusy) endDma(_PRINT_STATUS_OK);
+        else *(SSI_R + (0x014 >> 2)) &= ~SSI_IM_TXIM;
+    }
+}
+
+/**
+ * Dispatch a SSI interrupt to the SPIMaster instance that opened the module
+ *
+ * @param ssi is the SSI module that raised the interrupt
+ */
+void SPIMaster::serviceInterrupt(uint8_t ssi){
+    if(ssi <= 3 && instances[ssi] != 0){
+        instances[ssi]->handleInterrupt();
+    }
+}
+
+/**
+ * Overrides Print class write method
+ *
+ * @param c is the byte to send
+ * @param flags specifies the transaction state (see transfer)
+ * @return transfer result
+ */
+PrintStatus SPIMaster::write(uint8_t c, uint8_t flags){
+    return write((const char*)&c, 1, flags);
+}
+
+/**
+ * Overrides Print class write method
+ * Bytes are frames up to 8 bits, frames over 8 bits take byte pairs (most
+ * significant first, an odd last byte padded with 0x00). Received frames are discarded
+ *
+ * @param txt is the byte array pointer to send
+ * @param n is the number of the bytes to write
+ *       if n < 0, write until a 0 is found in the array
+ * @param flags specifies the transaction state (see transfer)
+ * @return ERROR if not opened, BUSY during a transferAsync, TIMEOUT if the
+ *      setTimeout time passed, else OK
+ */
+PrintStatus SPIMaster::write(const char* txt, int n, uint8_t flags){
+    if(!opened) return _PRINT_STATUS_ERROR;
+    if(dmaBusy) return _PRINT_STATUS_BUSY;
+    if(n < 0){  //Length of the string
+        n = 0;
+        while(txt[n]) n++;
+    }
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    setLanes(SPI_LANES_1, true);
+    drain();
+    select(flags);
+
+    PrintStatus status = _PRINT_STATUS_OK;
+    if(itemSize() == 1){
+        while(n > 0 && status == _PRINT_STATUS_OK){
+            uint16_t chunk = n > 0xFFFF ? 0xFFFF : (uint16_t)n;
+            status = exchange((const uint8_t*)txt, 0, chunk, deadline);
+            txt += chunk;
+            n -= chunk;
+        }
+    }else{
+        uint16_t frames[2 * SPI_FIFO_DEPTH];
+        while(n > 0 && status == _PRINT_STATUS_OK){
+            uint16_t count = 0;
+            while(n > 0 && count < 2 * SPI_FIFO_DEPTH){
+                frames[count++] = ((uint8_t)txt[0] << 8) | (n > 1 ? (uint8_t)txt[1] : 0x00);
+                txt += 2;
+                n -= 2;
+            }
+            status = exchange((const uint8_t*)frames, 0, count, deadline);
+        }
+    }
+    deselect(flags, status);
+    return status;
+}
+
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void SPIMaster_SSI0_Interrupt(){ SPIMaster::serviceInterrupt(SPI_SSI0); }
+void SPIMaster_SSI1_Interrupt(){ SPIMaster::serviceInterrupt(SPI_SSI1); }
+void SPIMaster_SSI2_Interrupt(){ SPIMaster::serviceInterrupt(SPI_SSI2); }
+void SPIMaster_SSI3_Interrupt(){ SPIMaster::serviceInterrupt(SPI_SSI3); }
+#ifdef __cplusplus
+}
+#endif
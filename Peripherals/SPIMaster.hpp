@@ -0,0 +1,139 @@
+/*
+ * SPIMaster.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_SPIMASTER_HPP_
+#define PERIPHERALS_SPIMASTER_HPP_
+
+#include <Util/Print.hpp>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/UDMA.hpp>
+#include <Peripherals/Clock.hpp>
+#include <Peripherals/Timebase.hpp>
+#include <stdint.h>
+
+// SSI module as a SPI (Freescale format) master
+// Chip select is the module FSS pin driven as a GPIO (or the one given to
+// setChipSelect), active low. Print writes and transfer take PRINT_WR flags:
+//      SINGLE mode             - chip select asserted around the call
+//      MULTIPLE mode, START    - assert chip select before the first frame
+//      MULTIPLE mode, STOP     - deassert chip select after the last frame
+//
+//   SPIMaster adc(10000000, SPI_SSI2, SPI_MODE_0, 16);
+//   uint16_t cmd[2] = {0x8300, 0x0000}, data[2];
+//   adc.transfer(cmd, data, 2);         //CS low, 2 frames full-duplex, CS high
+//
+// Frames of 4 to 8 bits are uint8_t items, 9 to 16 bits uint16_t items.
+// Print writes with frames over 8 bits send byte pairs, most significant byte
+// first (an odd byte is padded with 0x00), received frames are discarded.
+//
+// send, receive and receiveAsync move 8-bit frames on 1, 2 (bi-SSI, XDAT0-1)
+// or 4 data lanes (quad-SSI, XDAT0-3), half-duplex. The lanes may change
+// within a transaction, e.g. a serial flash command on 1 lane then its data on 4:
+//   spi.send(cmd, 5, SPI_LANES_1, PRINT_WR_CTL_INIT_TRXN);
+//   spi.receive(buf, 256, SPI_LANES_4, PRINT_WR_CTL_END_TRXN);
+// The XDAT2, XDAT3 pins are mapped on the first 4 lane call (see SPIFlash).
+
+#define SPI_SSI0    0
+#define SPI_SSI1    1
+#define SPI_SSI2    2
+#define SPI_SSI3    3
+
+// CLOCK POLARITY AND PHASE (SSICR0 SPO, SPH)
+#define SPI_MODE_0  0x00    //Clock idle low, sample on the rising edge
+#define SPI_MODE_1  0x80    //Clock idle low, sample on the falling edge
+#define SPI_MODE_2  0x40    //Clock idle high, sample on the falling edge
+#define SPI_MODE_3  0xC0    //Clock idle high, sample on the rising edge
+
+// DATA LANES (SSICR1 MODE)
+#define SPI_LANES_1 1       //Legacy SPI, full-duplex
+#define SPI_LANES_2 2       //Bi-SSI, half-duplex
+#define SPI_LANES_4 4       //Quad-SSI, half-duplex
+
+#define SPI_FIFO_DEPTH      8       //TX and RX FIFO frames
+
+#ifndef SPI_FILL
+#define SPI_FILL            0xFFFF  //Frame sent when transfer has no tx data
+#endif
+
+class SPIMaster:public Print{
+    public:
+        SPIMaster();
+        SPIMaster(uint32_t, uint8_t=0, uint8_t=SPI_MODE_0, uint8_t=8);
+        ~SPIMaster();
+
+        void open();
+        void close();
+
+        void setFormat(uint8_t, uint8_t);
+        void setBitRate(uint32_t);
+        uint32_t getBitRate();
+        void setChipSelect(uint8_t, uint8_t);
+        void setTimeout(uint32_t);
+        void setLoopback(bool);
+
+        PrintStatus transfer(const void*, void*, uint16_t, uint8_t = PRINT_WR_CTL_SNGL_TRXN, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus transferAsync(const void*, void*, uint32_t, TransferCallback = 0, void* = 0, uint8_t = PRINT_WR_CTL_SNGL_TRXN);
+        PrintStatus send(const void*, uint32_t, uint8_t = SPI_LANES_1, uint8_t = PRINT_WR_CTL_SNGL_TRXN, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus receive(void*, uint32_t, uint8_t = SPI_LANES_1, uint8_t = PRINT_WR_CTL_SNGL_TRXN, uint64_t = TIMEBASE_FOREVER);
+        PrintStatus receiveAsync(void*, uint32_t, uint8_t = SPI_LANES_1, TransferCallback = 0, void* = 0, uint8_t = PRINT_WR_CTL_SNGL_TRXN);
+        bool busy();
+
+        static void serviceInterrupt(uint8_t);
+
+    private:
+        uint8_t SSI;
+        HwReg* PORT_R;          //Clk, Fss port
+        HwReg* DAT_PORT_R;      //Data pins port
+        HwReg* QUAD_PORT_R;     //XDAT2, XDAT3 port, 0 until mapped
+        HwReg* CS_R;            //Chip select masked GPIODATA address
+        HwReg* SSI_R;
+        HwReg* SSI_SR_R;
+        HwReg* SSI_DR_R;
+        uint32_t rate;          //Requested bit rate
+        uint8_t format;         //SPI_MODE_x
+        uint8_t frameBits;
+        uint8_t csPort;
+        uint8_t csBit;
+        bool opened;
+        uint32_t timeoutUs;     //Blocking calls limit, TIMEBASE_NO_TIMEOUT if none
+
+        const uint8_t* dmaTx;   //Next chunk to program, 0 sends SPI_FILL
+        uint8_t* dmaRx;         //Next chunk to program, 0 discards
+        volatile uint32_t dmaLeft;  //Frames not yet programmed
+        volatile bool dmaBusy;
+        uint8_t dmaFlags;
+        TransferCallback dmaCb;
+        void* dmaArg;
+
+        static SPIMaster* instances[4];
+
+        inline bool assertValidSSI();
+        inline uint8_t itemSize();
+        uint64_t until(uint64_t);
+        void setDivisors(uint32_t);
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+        static void muxPins(HwReg*, uint8_t, uint8_t);
+        static void unmuxPins(HwReg*, uint8_t);
+        PrintStatus setLanes(uint8_t, bool);
+        void select(uint8_t);
+        void deselect(uint8_t, PrintStatus);
+        PrintStatus exchange(const uint8_t*, uint8_t*, uint16_t, uint64_t);
+        PrintStatus push(const uint8_t*, uint32_t, uint64_t);
+        PrintStatus startAsync(const void*, void*, uint32_t, TransferCallback, void*, uint8_t);
+        void drain();
+        void handleInterrupt();
+        void startDma();
+        void endDma(PrintStatus);
+        static void onDmaError(void*);
+
+        PrintStatus write(uint8_t c, uint8_t flags=0) override;
+        PrintStatus write(const char* txt, int n, uint8_t flags) override;
+};
+
+
+#endif /* PERIPHERALS_SPIMASTER_HPP_ */
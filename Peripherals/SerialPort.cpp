@@ -11,10 +11,36 @@
 #include <../inc/tm4c1294ncpdt.h>
 #include <Peripherals/Board.hpp>
 #include <Peripherals/SerialPort.hpp>
+#include <Peripherals/Pin.hpp>
+#include "../driverlib/sysctl.h"
+#include "../driverlib/rom_map.h"
 
 
-static const uint8_t UART_PORT_OFF[] = {0, 1, 0, 0, 0, 2, 13, 2}; //GPIO Base offset
-static const uint8_t UART_RXIO_B[] = {0, 0, 6, 4, 2, 6, 0, 4}; //RXIO Bit, TX = RXIO + 1
+static const uint8_t UART_IRQ_N[] = {5, 6, 33, 56, 57, 58, 59, 60}; //NVIC interrupt number
+static const uint8_t UART_DMA_RX_CH[] = {8, 22, 0, 16, 18, 6, 10, 20}; //uDMA RX channel, TX = RX + 1
+static const uint8_t UART_DMA_ENC[] = {0, 0, 1, 2, 2, 2, 2, 2}; //uDMA channel map encoding
+
+/**
+ * @return true if every UART Rx, Tx pair has the Port Mux 1 function (see GPIO_PIN_AF)
+ */
+static constexpr bool uartPinsValid(){
+    for(uint8_t i = 0; i < sizeof(UART_PORT_OFF); i++){
+        if(!gpioHasAF(UART_PORT_OFF[i], UART_RXIO_B[i], 1) || !gpioHasAF(UART_PORT_OFF[i], UART_RXIO_B[i] + 1, 1)) return false;
+    }
+    return true;
+}
+static_assert(uartPinsValid(), "UART pin table doesn't match the GPIO alternate functions");
+
+#define UART_IM_RXIM    0x10    //Receive interrupt mask
+#define UART_IM_TXIM    0x20    //Transmit interrupt mask
+#define UART_IM_RTIM    0x40    //Receive time-out interrupt mask
+#define UART_IM_DMARXIM 0x10000 //Receive DMA complete interrupt mask
+#define UART_IM_DMATXIM 0x20000 //Transmit DMA complete interrupt mask
+
+#define UART_DMACTL_RXDMAE  0x01
+#define UART_DMACTL_TXDMAE  0x02
+
+SerialPort* SerialPort::instances[8] = {0};
 
 /**
  * Default SerialPort constructor
@@ -23,6 +49,7 @@ static const uint8_t UART_RXIO_B[] = {0, 0, 6, 4, 2, 6, 0, 4}; //RXIO Bit, TX =
 SerialPort::SerialPort(){
     this->UART = 0;
     this->baud = 9600;
+    resetState();
     open();
 }
 
@@ -35,18 +62,132 @@ SerialPort::SerialPort(){
 SerialPort::SerialPort(uint32_t baudrate, uint8_t uart){
    this->UART = uart;
    this->baud = baudrate;
+   resetState();
    open();
 }
 
+/**
+ * Private: Set TX/RX modes and counters to their defaults (blocking, no errors)
+ */
+void SerialPort::resetState(){
+    txMode = SERIAL_TX_BLOCKING;
+    txOverflow = SERIAL_TX_OVF_BLOCK;
+    txActive = false;
+    txDropCount = 0;
+    rxMode = SERIAL_RX_BLOCKING;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    fifoEnabled = false;
+    fifoLevels = (SERIAL_FIFO_1_2 << 3) | SERIAL_FIFO_1_2; //UARTIFLS reset value
+    lineFsm = 0;
+    lineCount = 0;
+    rxLineCb = 0;   rxLineArg = 0;
+    dmaTxLeft = 0;  dmaTxBusy = false;
+    dmaRxLeft = 0;  dmaRxBusy = false;
+    clearErrorStats();
+}
+
 
 /**
- * Locks the system until selected UART receives a byte
- * @return Returns the read byte as a char type
+ * Locks the system until selected UART receives a byte (or the setTimeout time passes)
+ * @return Returns the read byte as a char type, '\0' if timed out
  */
 char SerialPort::read(){
-    if(!assertValidUART()) return '\0';
-    while(((*UART_FSTAT_R) &  0x40) == 0x00); //Wait until Rx char
-    return (char)((*UART_R) & 0xFF); //Cast to char
+    char c = '\0';
+    read(c, TIMEBASE_FOREVER);
+    return c;
+}
+
+/**
+ * Wait for a received byte until a deadline
+ *
+ * @param c receives the read byte
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return false if the deadline passed first
+ */
+bool SerialPort::read(char& c, uint64_t deadline){
+    if(!assertValidUART()) return false;
+    deadline = until(deadline);
+    while(!tryRead(c)){ //Wait until ISR stores a char, or Rx char
+        if(Timebase::expired(deadline)) return false;
+        BOARD_WAIT();
+    }
+    return true;
+}
+
+/**
+ * Limit the time blocking calls wait for the UART: read, readline and flush without
+ * deadline, and writes (timed out writes return _PRINT_STATUS_TIMEOUT)
+ * The limit applies to each call, from its start
+ *
+ * @param us is the limit in microseconds, TIMEBASE_NO_TIMEOUT (default) to wait forever
+ */
+void SerialPort::setTimeout(uint32_t us){
+    timeoutUs = us;
+}
+
+/**
+ * Private: deadline of a blocking call
+ * @param deadline is the caller deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return the deadline to wait for, Timer1 isn't used without a limit
+ */
+uint64_t SerialPort::until(uint64_t deadline){
+    if(deadline != TIMEBASE_FOREVER || timeoutUs == TIMEBASE_NO_TIMEOUT) return deadline;
+    return Timebase::deadline(timeoutUs);
+}
+
+/**
+ * Read a received byte if there is one, never blocks
+ *
+ * @param c receives the read byte
+ * @return true if a byte was read
+ */
+bool SerialPort::tryRead(char& c){
+    if(!assertValidUART()) return false;
+    if(rxMode == SERIAL_RX_BUFFERED){
+        uint8_t b;
+        if(!rxRing.pop(b)) return false;
+        c = (char)b;
+        return true;
+    }
+    if(((*UART_FSTAT_R) & UART_FR_RXFE) != 0x00) return false; //Nothing received
+    c = (char)receiveByte(*UART_R);
+    return true;
+}
+
+/**
+ * @return the number of received bytes ready to be read
+ */
+uint16_t SerialPort::available(){
+    if(!assertValidUART()) return 0;
+    if(rxMode == SERIAL_RX_BUFFERED){
+        return rxRing.count();
+    }
+    return ((*UART_FSTAT_R) & UART_FR_RXFE) == 0x00 ? 1 : 0; //FIFO count not available
+}
+
+/**
+ * Read up to n bytes, waiting at most timeout milliseconds for them to arrive
+ *
+ * @param buf is the external buffer where the bytes are stored
+ * @param n is the maximum quantity of bytes to read
+ * @param timeout is the maximum time in ms spent waiting for data
+ *      - 0: only take the bytes already received
+ *      - SERIAL_WAIT_FOREVER: wait until n bytes are read
+ * @return the quantity of bytes read
+ */
+int SerialPort::readBytes(char* buf, int n, uint32_t timeout){
+    if(!assertValidUART()) return 0;
+    int count = 0;
+    uint64_t deadline = TIMEBASE_FOREVER;
+    if(timeout != SERIAL_WAIT_FOREVER && timeout != 0) deadline = Timebase::now() + (uint64_t)timeout * 1000;
+    while(count < n){
+        if(tryRead(buf[count])){
+            count++;
+        }else if(timeout != 0 && !Timebase::expired(deadline)){
+            BOARD_WAIT();
+        }else break;
+    }
+    return count;
 }
 
 
@@ -59,35 +200,184 @@ char SerialPort::read(){
  * @param crnl is a boolean value for store the newline characters
  *      - true: Store '\r' and '\n' in the string as long as buffer do not overflows
  *      - false: Ignore '\r' and '\n' in the string
- * @return Returns the input buffer pointer
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return Returns the input buffer pointer, 0 if the deadline passed (out holds the partial line)
  */
-char* SerialPort::readline(char* const out, uint8_t lim, bool crnl){
+char* SerialPort::readline(char* const out, uint8_t lim, bool crnl, uint64_t deadline){
     if(!assertValidUART()) return out;
-    //Start a finite state machine (\variable fsm) for detecting valid carry return '\r' and
-    //new line '\n' characters, \variable count for detect overflow
-    uint8_t fsm = 0, count=0;
-    char* rx_p = out;   //Cast to mutable pointer
+    deadline = until(deadline);
+    lineFsm = 0;    lineCount = 0;  //Discard any partial line from tryReadline
+    char c;
     do{
-        *rx_p = read();
-        count++;
-        if(fsm == 0 && *rx_p == '\r'){
-            fsm = 1;
-        }else if(fsm == 1 && *rx_p == '\n'){
-            fsm = 2;
+        if(!read(c, deadline)){
+            out[lineCount] = '\0';
+            lineFsm = 0;    lineCount = 0;
+            return 0;
         }
-        rx_p++; //Iterate over out buffer
-    }while(fsm != 2 && count != lim); //Exit when endline detected or overflow
+    }while(!lineStep(out, lim, crnl, c)); //Exit when endline detected or overflow
+    return out;
+}
+
+/**
+ * Non-blocking readline, takes every received byte and returns. The partial line is
+ * kept in the out buffer, so call it again with the same buffer until it returns true.
+ *
+ * @param out is the external buffer where the string is stored
+ * @param lim is the maximum length of the buffer (out)
+ * @param crnl is a boolean value for store the newline characters (see readline)
+ * @return true when the line is complete (newline or overflow) and out is terminated
+ */
+bool SerialPort::tryReadline(char* const out, uint8_t lim, bool crnl){
+    if(!assertValidUART()) return false;
+    char c;
+    while(tryRead(c)){
+        if(lineStep(out, lim, crnl, c)) return true;
+    }
+    return false;
+}
 
+/**
+ * Private: Readline finite state machine (\variable lineFsm) for detecting valid carry return '\r' and
+ * new line '\n' characters, \variable lineCount for detect overflow
+ *
+ * @param out is the external buffer where the string is stored
+ * @param lim is the maximum length of the buffer (out)
+ * @param crnl is a boolean value for store the newline characters
+ * @param c is the received char
+ * @return true when the line ended and out was terminated
+ */
+bool SerialPort::lineStep(char* const out, uint8_t lim, bool crnl, char c){
+    out[lineCount++] = c;
+    if(lineFsm == 0 && c == '\r'){
+        lineFsm = 1;
+    }else if(lineFsm == 1 && c == '\n'){
+        lineFsm = 2;
+    }
+    if(lineFsm != 2 && lineCount != lim) return false;
 
     //String end
-    if(fsm != 2){ //No newline detected
-        *(rx_p-1) = '\0';
+    if(lineFsm != 2){ //No newline detected
+        out[lineCount-1] = '\0';
     }else if(crnl){ //Keep CR and NL
-        *(rx_p) = '\0';
+        out[lineCount] = '\0';
     }else{ //Erase CR and NL
-        *(rx_p-2) = '\0';
+        out[lineCount-2] = '\0';
     }
-    return out;
+    lineFsm = 0;    lineCount = 0;
+    return true;
+}
+
+/**
+ * Select how received bytes are collected
+ *
+ * @param mode is the receive mode
+ *      - SERIAL_RX_BLOCKING: bytes are read straight from the UART (default)
+ *      - SERIAL_RX_BUFFERED: RX and receive time-out interrupts store bytes
+ *        in the RX ring buffer, read methods take them from there
+ */
+void SerialPort::setRxMode(uint8_t mode){
+    if(!assertValidUART()) return;
+    *(UART_R + (0x038>>2)) &= ~(UART_IM_RXIM | UART_IM_RTIM);
+    rxMode = mode;
+    if(mode == SERIAL_RX_BUFFERED){
+        *(UART_R + (0x044>>2)) = UART_IM_RXIM | UART_IM_RTIM; //Clear stale RX interrupts
+        *(UART_R + (0x038>>2)) |= UART_IM_RXIM | UART_IM_RTIM;
+    }
+}
+
+/**
+ * Notify the end of received lines in SERIAL_RX_BUFFERED mode, e.g. to post an
+ * event that takes the line with tryReadline instead of waiting in readline
+ *
+ * @param callback is called from the UART interrupt once per interrupt that
+ *      stores one or more '\n' in the RX ring buffer (0 to disable), status is OK
+ * @param arg is passed to the callback
+ */
+void SerialPort::setLineCallback(TransferCallback callback, void* arg){
+    if(!assertValidUART()) return;
+    *(UART_R + (0x038>>2)) &= ~(UART_IM_RXIM | UART_IM_RTIM); //Don't call it half updated
+    rxLineCb = callback;
+    rxLineArg = arg;
+    if(rxMode == SERIAL_RX_BUFFERED && !dmaRxBusy) *(UART_R + (0x038>>2)) |= UART_IM_RXIM | UART_IM_RTIM;
+}
+
+/**
+ * Enable or disable the 16 byte UART hardware FIFOs
+ * With FIFOs disabled the UART works with 1 byte holding registers (default)
+ *
+ * @param enable if true, TX and RX FIFOs are enabled
+ * @param txLevel is the TX interrupt trigger level (SERIAL_FIFO_1_8 ... SERIAL_FIFO_7_8),
+ *      interrupt fires when TX FIFO drains to this level
+ * @param rxLevel is the RX interrupt trigger level (SERIAL_FIFO_1_8 ... SERIAL_FIFO_7_8),
+ *      interrupt fires when RX FIFO fills to this level (receive time-out handles the rest)
+ */
+void SerialPort::setFifo(bool enable, uint8_t txLevel, uint8_t rxLevel){
+    if(!assertValidUART()) return;
+    flush(); //Send pending bytes before FIFO reconfiguration
+
+    fifoEnabled = enable;
+    fifoLevels = ((rxLevel & 0x07) << 3) | (txLevel & 0x07);
+
+    *(UART_R + (0x030>>2)) &= ~0x01; //Disable UART
+    *(UART_R + (0x02C>>2)) = fifoEnabled ? 0x70 : 0x60; //Line Control, FEN as selected
+    *(UART_R + (0x034>>2)) = fifoLevels;
+    *(UART_R + (0x030>>2)) |= 0x01;  //Enable UART
+}
+
+/**
+ * Connect the UART TX output to its own RX input (internal loopback),
+ * so written bytes are received back without external wiring. For self tests
+ *
+ * @param enable selects loopback (true) or normal operation (false)
+ */
+void SerialPort::setLoopback(bool enable){
+    if(!assertValidUART()) return;
+    flush(); //Send pending bytes with the current connection
+
+    *(UART_R + (0x030>>2)) &= ~0x01; //Disable UART
+    if(enable){
+        *(UART_R + (0x030>>2)) |= UART_CTL_LBE;
+    }else{
+        *(UART_R + (0x030>>2)) &= ~UART_CTL_LBE;
+    }
+    *(UART_R + (0x030>>2)) |= 0x01;  //Enable UART
+}
+
+/**
+ * @return a copy of the receive error counters since open (or clearErrorStats)
+ */
+SerialErrorStats SerialPort::errorStats(){
+    SerialErrorStats stats;
+    stats.overrun = rxErrors.overrun;
+    stats.framing = rxErrors.framing;
+    stats.parity = rxErrors.parity;
+    stats.breaks = rxErrors.breaks;
+    stats.dropped = rxErrors.dropped;
+    return stats;
+}
+
+void SerialPort::clearErrorStats(){
+    rxErrors.overrun = 0;
+    rxErrors.framing = 0;
+    rxErrors.parity = 0;
+    rxErrors.breaks = 0;
+    rxErrors.dropped = 0;
+}
+
+/**
+ * Private: Count the error flags of a UARTDR read
+ *
+ * @param dr is the UART data register value
+ * @return the received byte
+ */
+uint8_t SerialPort::receiveByte(uint32_t dr){
+    if(dr & (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE)){
+        if(dr & UART_DR_OE) rxErrors.overrun++;
+        if(dr & UART_DR_BE) rxErrors.breaks++;
+        if(dr & UART_DR_PE) rxErrors.parity++;
+        if(dr & UART_DR_FE) rxErrors.framing++;
+    }
+    return (uint8_t)(dr & 0xFF);
 }
 
 /**
@@ -102,8 +392,8 @@ void SerialPort::open(){
     if(!assertValidUART())  return;
 
     SYSCTL_RCGCUART_R |= (1 << UART); // Enable UART Clock
-    PORT_R = (uint32_t*)(GPIO_PORT_BASE + (UART_PORT_OFF[UART] << 12)); //Set pointer to GPIO Port Base Register
-    UART_R = (uint32_t*)(UART_BASE_REG + (UART << 12)); //Set pointer to base UART Register
+    PORT_R = HWREG_PTR(GPIO_PORT_BASE + (UART_PORT_OFF[UART] << 12)); //Set pointer to GPIO Port Base Register
+    UART_R = HWREG_PTR(UART_BASE_REG + (UART << 12)); //Set pointer to base UART Register
     UART_FSTAT_R = UART_R + (0x18 >> 2);                //Set pointer to Fifo Status UART Base Register
     SYSCTL_RCGCGPIO_R |= (1 << UART_PORT_OFF[UART]);    //Enable GPIO Port for UART Tx, Rx Signals
 
@@ -112,24 +402,368 @@ void SerialPort::open(){
     *(PORT_R + (0x52C>>2)) |= 0x11 <<  (UART_RXIO_B[UART]<<2);   //Port Mux Tx, Rx to UART
     *(PORT_R + (0x51C>>2)) |= 0x03 << UART_RXIO_B[UART];         //Enable Tx,Rx Pins
 
-    /* Calculate Baud-Rate Divisor, integer and fractional parts, according datasheet*/
-    float baudRateDivisor = (float)(CPU_PIOSC_FREQUENCY) / (16.0 * baud);
-    uint32_t iBRD = (uint32_t)baudRateDivisor;
-    uint32_t fBRD = (uint32_t)((baudRateDivisor-iBRD)*64 + 0.5);
-
     *(UART_R + (0x030>>2)) = 0x300;  //Disable UART and set default UART Control configuration.
-    *(UART_R + (0x024>>2)) = iBRD;   //Set Integer baud-rate divisor
-    *(UART_R + (0x028>>2)) = fBRD;   //Set Fractional baud-rate divisor
-    *(UART_R + (0x02C>>2)) = 0x60;   //Line Control 8 bits, 1 byte FIFO, 1 stop bit, no parity
-    *(UART_R + (0xFC8>>2)) = 0x05;   //Select alternative clock as source (PIOSC)
+    setDivisors(altClock() ? CPU_PIOSC_FREQUENCY : systemClock());
+    *(UART_R + (0x02C>>2)) = fifoEnabled ? 0x70 : 0x60; //Line Control 8 bits, FIFO (16 or 1 byte), 1 stop bit, no parity
+    *(UART_R + (0x034>>2)) = fifoLevels; //FIFO interrupt trigger levels
+    *(UART_R + (0xFC8>>2)) = altClock() ? 0x05 : 0x00;   //Select alternative clock (PIOSC) or system clock as source
+    *(UART_R + (0x038>>2)) = 0x00;   //Mask all UART interrupts
     *(UART_R + (0x030>>2)) |= 0x01;  //Enable UART
+    if(rxMode == SERIAL_RX_BUFFERED) setRxMode(rxMode);
+
+    instances[UART] = this;          //Route UARTn interrupt to this instance
+    Clock::subscribe(onClockChange);
+    uint8_t irq = UART_IRQ_N[UART];
+    *(&NVIC_EN0_R + (irq >> 5)) = 1 << (irq & 0x1F); //Enable NVIC UARTn Interrupt
+}
+
+/**
+ * SerialPort destructor, the UARTn interrupt and the clock switches stop using this instance
+ */
+SerialPort::~SerialPort(){
+    if(UART <= 7 && instances[UART] == this) instances[UART] = 0;
 }
 
 void SerialPort::close(){
     if(!assertValidUART())  return;
+    flush();
+    if(dmaTxBusy) endDmaTx(_PRINT_STATUS_ERROR); //Cancel uDMA transfers
+    if(dmaRxBusy) endDmaRx(_PRINT_STATUS_ERROR);
+    *(UART_R + (0x038>>2)) = 0x00;   //Mask all UART interrupts
+    if(instances[UART] == this) instances[UART] = 0;
     SYSCTL_RCGCUART_R &= ~(1<<UART); // Disable UART Clock
 }
 
+/**
+ * Private: UART clock source for the baud rate. PIOSC (ALTCLK) keeps the divisors
+ * valid at any system clock, the system clock is used for the baud rates PIOSC
+ * can't reach (over 1 Mbaud)
+ * @return true if the UART runs from PIOSC
+ */
+inline bool SerialPort::altClock(){
+    return 16 * baud <= CPU_PIOSC_FREQUENCY;
+}
+
+/**
+ * Private: Set the baud-rate divisors, integer and fractional parts, according datasheet
+ * UART must be disabled, they take effect with the next line control (LCRH) write
+ *
+ * @param clock is the UART clock
+ */
+void SerialPort::setDivisors(uint32_t clock){
+    uint32_t divisor = (4 * clock + baud / 2) / baud; //clock / (16 x baud) in 1/64 units, rounded
+    *(UART_R + (0x024>>2)) = divisor >> 6;    //Set Integer baud-rate divisor
+    *(UART_R + (0x028>>2)) = divisor & 0x3F;  //Set Fractional baud-rate divisor
+}
+
+/**
+ * Private: system clock switch listener (see Clock)
+ * UARTs running from the system clock finish the frame in flight before the
+ * switch, holding the TX ring buffer, and get new divisors after it.
+ * Bytes received during the switch may show framing errors.
+ *
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+void SerialPort::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    (void)oldFreq;
+    for(uint8_t i = 0; i < 8; i++){
+        SerialPort* port = instances[i];
+        if(port == 0 || port->altClock()) continue; //PIOSC baud clock, not affected
+        HwReg* uart = port->UART_R;
+        if(phase == CLOCK_PRE_CHANGE){
+            *(uart + (0x038>>2)) &= ~UART_IM_TXIM;  //Hold TX ring buffer bytes
+            while(port->dmaTxBusy || ((*port->UART_FSTAT_R) & UART_FR_BUSY) != 0x00) BOARD_WAIT();
+        }else{
+            uint32_t ctl = *(uart + (0x030>>2));
+            *(uart + (0x030>>2)) = ctl & ~0x01;     //Disable UART
+            port->setDivisors(newFreq);
+            *(uart + (0x02C>>2)) = *(uart + (0x02C>>2)); //Latch divisors
+            *(uart + (0x030>>2)) = ctl;
+            if(port->txActive) *(uart + (0x038>>2)) |= UART_IM_TXIM; //Resume TX ring buffer
+        }
+    }
+}
+
+/**
+ * Select how write methods hand bytes to the UART
+ *
+ * @param mode is the transmit mode
+ *      - SERIAL_TX_BLOCKING: wait for the UART on every byte (default)
+ *      - SERIAL_TX_BUFFERED: copy the byte to the TX ring buffer and return,
+ *        the UART interrupt moves buffered bytes to the hardware
+ * @param overflow is the policy applied when the TX ring buffer is full
+ *      - SERIAL_TX_OVF_BLOCK: wait until there is room
+ *      - SERIAL_TX_OVF_DROP_NEWEST: discard the byte being written (write returns ERROR)
+ *      - SERIAL_TX_OVF_DROP_OLDEST: discard the oldest buffered byte
+ */
+void SerialPort::setTxMode(uint8_t mode, uint8_t overflow){
+    if(!assertValidUART()) return;
+    if(txMode == SERIAL_TX_BUFFERED && mode != SERIAL_TX_BUFFERED){
+        flush(); //Keep byte order, send pending bytes before blocking writes
+    }
+    txOverflow = overflow;
+    txMode = mode;
+}
+
+/**
+ * Locks the system until every buffered byte has been shifted out of the UART
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return false if the deadline passed first
+ */
+bool SerialPort::flush(uint64_t deadline){
+    if(!assertValidUART()) return false;
+    deadline = until(deadline);
+    while(!txRing.isEmpty()){
+        if(Timebase::expired(deadline)) return false;
+        startTx(); //Also drains the buffer if interrupts are globally disabled
+    }
+    while(((*UART_FSTAT_R) & UART_FR_BUSY) != 0x00){ //Wait until last bit sent
+        if(Timebase::expired(deadline)) return false;
+    }
+    return true;
+}
+
+/**
+ * @return the number of bytes waiting in the TX ring buffer
+ */
+uint16_t SerialPort::txPending(){
+    return txRing.count();
+}
+
+/**
+ * @return the number of bytes discarded by the TX overflow policy
+ */
+uint32_t SerialPort::txDropped(){
+    return txDropCount;
+}
+
+/**
+ * Private: Store a byte in the TX ring buffer, applying the overflow policy
+ *
+ * @param c is the byte to send
+ * @param deadline is the blocking policy deadline
+ * @return ERROR if byte was discarded, TIMEOUT if the ring stayed full, else NO ERROR
+ */
+PrintStatus SerialPort::bufferByte(uint8_t c, uint64_t deadline){
+    if(txRing.isFull()){
+        if(txOverflow == SERIAL_TX_OVF_DROP_NEWEST){
+            txDropCount++;
+            return _PRINT_STATUS_ERROR;
+        }else if(txOverflow == SERIAL_TX_OVF_DROP_OLDEST){
+            *(UART_R + (0x038>>2)) &= ~UART_IM_TXIM; //Stop consumer while discarding
+            if(txRing.discard()) txDropCount++;
+            if(txActive) *(UART_R + (0x038>>2)) |= UART_IM_TXIM;
+        }else{
+            while(txRing.isFull()){
+                if(Timebase::expired(deadline)){
+                    txDropCount++;
+                    return _PRINT_STATUS_TIMEOUT;
+                }
+                startTx();
+            }
+        }
+    }
+    txRing.push(c);
+    if(!txActive) startTx(); //Transmitter idle, prime it
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Private: Move buffered bytes to the UART while it has room, and keep the
+ * TX interrupt enabled while bytes remain in the ring buffer
+ */
+void SerialPort::startTx(){
+    *(UART_R + (0x038>>2)) &= ~UART_IM_TXIM; //Mask TX interrupt, this context is the consumer now
+    uint8_t c;
+    while(((*UART_FSTAT_R) & UART_FR_TXFF) == 0x00 && txRing.pop(c)){
+        *UART_R = c;
+    }
+    txActive = !txRing.isEmpty();
+    if(txActive) *(UART_R + (0x038>>2)) |= UART_IM_TXIM; //Remaining bytes sent from ISR
+}
+
+/**
+ * Private: UARTn interrupt service routine for this instance
+ */
+void SerialPort::handleInterrupt(){
+    PROBE_SCOPE(PROBE_SERIAL_ISR);
+    uint32_t mis = *(UART_R + (0x040>>2)); //Masked interrupt status
+    if(mis & UART_IM_DMATXIM){
+        *(UART_R + (0x044>>2)) = UART_IM_DMATXIM; //Clear TX DMA complete
+        if(dmaTxLeft != 0) startDmaTx();
+        else if(dmaTxBusy) endDmaTx(_PRINT_STATUS_OK);
+    }
+    if(mis & UART_IM_DMARXIM){
+        *(UART_R + (0x044>>2)) = UART_IM_DMARXIM; //Clear RX DMA complete
+        if(dmaRxLeft != 0) startDmaRx();
+        else if(dmaRxBusy) endDmaRx(_PRINT_STATUS_OK);
+    }
+    if(mis & (UART_IM_RXIM | UART_IM_RTIM)){
+        *(UART_R + (0x044>>2)) = UART_IM_RXIM | UART_IM_RTIM; //Clear RX interrupts
+        bool line = false;
+        while(((*UART_FSTAT_R) & UART_FR_RXFE) == 0x00){
+            uint8_t b = receiveByte(*UART_R);
+            if(!rxRing.push(b)) rxErrors.dropped++; //Ring full, byte lost
+            else if(b == '\n') line = true;
+        }
+        if(line && rxLineCb != 0) rxLineCb(_PRINT_STATUS_OK, rxLineArg);
+    }
+    if(mis & UART_IM_TXIM){
+        *(UART_R + (0x044>>2)) = UART_IM_TXIM; //Clear TX interrupt
+        uint8_t c;
+        while(((*UART_FSTAT_R) & UART_FR_TXFF) == 0x00 && txRing.pop(c)){
+            *UART_R = c;
+        }
+        if(txRing.isEmpty()){
+            *(UART_R + (0x038>>2)) &= ~UART_IM_TXIM; //Nothing left, stop TX interrupts
+            txActive = false;
+        }
+    }
+}
+
+/**
+ * Send a buffer with the uDMA, returns without waiting
+ * Bytes buffered by previous writes are sent first
+ *
+ * @param buf is the data to send, must stay valid until the transfer completes
+ * @param len is the quantity of bytes to send
+ * @param callback is called from the UART interrupt when the transfer completes (optional)
+ * @param arg is passed to the callback
+ * @return BUSY if a transfer is in progress or the channel is in use, ERROR if not valid UART
+ */
+PrintStatus SerialPort::writeAsync(const void* buf, uint16_t len, TransferCallback callback, void* arg){
+    if(!assertValidUART() || len == 0) return _PRINT_STATUS_ERROR;
+    if(dmaTxBusy) return _PRINT_STATUS_BUSY;
+    if(!UDMA::claim(UART_DMA_RX_CH[UART] + 1, UART_DMA_ENC[UART], this, onDmaError)) return _PRINT_STATUS_BUSY;
+    flush(); //Keep byte order
+
+    dmaTxBuf = (const uint8_t*)buf;
+    dmaTxLeft = len;
+    dmaTxCb = callback;
+    dmaTxArg = arg;
+    dmaTxBusy = true;
+
+    *(UART_R + (0x048>>2)) |= UART_DMACTL_TXDMAE;   //TX FIFO requests uDMA
+    *(UART_R + (0x038>>2)) |= UART_IM_DMATXIM;      //Interrupt on DMA complete
+    startDmaTx();
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Receive a buffer with the uDMA, returns without waiting
+ * RX buffered mode interrupts are paused during the transfer
+ *
+ * @param buf is the destination buffer, must stay valid until the transfer completes
+ * @param len is the quantity of bytes to receive
+ * @param callback is called from the UART interrupt when the transfer completes (optional)
+ * @param arg is passed to the callback
+ * @return BUSY if a transfer is in progress or the channel is in use, ERROR if not valid UART
+ */
+PrintStatus SerialPort::readAsync(void* buf, uint16_t len, TransferCallback callback, void* arg){
+    if(!assertValidUART() || len == 0) return _PRINT_STATUS_ERROR;
+    if(dmaRxBusy) return _PRINT_STATUS_BUSY;
+    if(!UDMA::claim(UART_DMA_RX_CH[UART], UART_DMA_ENC[UART], this, onDmaError)) return _PRINT_STATUS_BUSY;
+
+    dmaRxBuf = (uint8_t*)buf;
+    dmaRxLeft = len;
+    dmaRxCb = callback;
+    dmaRxArg = arg;
+    dmaRxBusy = true;
+
+    *(UART_R + (0x038>>2)) &= ~(UART_IM_RXIM | UART_IM_RTIM); //uDMA takes the received bytes
+    *(UART_R + (0x048>>2)) |= UART_DMACTL_RXDMAE;
+    *(UART_R + (0x038>>2)) |= UART_IM_DMARXIM;
+    startDmaRx();
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * @return true while a writeAsync transfer is in progress
+ */
+bool SerialPort::writeBusy(){
+    return dmaTxBusy;
+}
+
+/**
+ * @return true while a readAsync transfer is in progress
+ */
+bool SerialPort::readBusy(){
+    return dmaRxBusy;
+}
+
+/**
+ * Private: Program the next TX chunk (up to UDMA_MAX_TRANSFER bytes)
+ */
+void SerialPort::startDmaTx(){
+    uint16_t chunk = dmaTxLeft > UDMA_MAX_TRANSFER ? UDMA_MAX_TRANSFER : dmaTxLeft;
+    const uint8_t* src = dmaTxBuf;
+    dmaTxBuf += chunk;
+    dmaTxLeft -= chunk;
+    UDMA::transfer(UART_DMA_RX_CH[UART] + 1, src, UART_R, chunk,
+                   UDMA_CTL_MEM_TO_PERIPH | (fifoEnabled ? UDMA_CTL_ARB_4 : UDMA_CTL_ARB_1));
+}
+
+/**
+ * Private: Program the next RX chunk (up to UDMA_MAX_TRANSFER bytes)
+ */
+void SerialPort::startDmaRx(){
+    uint16_t chunk = dmaRxLeft > UDMA_MAX_TRANSFER ? UDMA_MAX_TRANSFER : dmaRxLeft;
+    uint8_t* dst = dmaRxBuf;
+    dmaRxBuf += chunk;
+    dmaRxLeft -= chunk;
+    UDMA::transfer(UART_DMA_RX_CH[UART], UART_R, dst, chunk, UDMA_CTL_PERIPH_TO_MEM | UDMA_CTL_ARB_1);
+}
+
+/**
+ * Private: Finish writeAsync transfer, release the channel and notify the user
+ * @param status is the transfer result
+ */
+void SerialPort::endDmaTx(PrintStatus status){
+    *(UART_R + (0x038>>2)) &= ~UART_IM_DMATXIM;
+    *(UART_R + (0x048>>2)) &= ~UART_DMACTL_TXDMAE;
+    UDMA::release(UART_DMA_RX_CH[UART] + 1, this);
+    dmaTxLeft = 0;
+    dmaTxBusy = false;
+    if(dmaTxCb) dmaTxCb(status, dmaTxArg);
+}
+
+/**
+ * Private: Finish readAsync transfer, restore RX interrupts and notify the user
+ * @param status is the transfer result
+ */
+void SerialPort::endDmaRx(PrintStatus status){
+    *(UART_R + (0x038>>2)) &= ~UART_IM_DMARXIM;
+    *(UART_R + (0x048>>2)) &= ~UART_DMACTL_RXDMAE;
+    UDMA::release(UART_DMA_RX_CH[UART], this);
+    dmaRxLeft = 0;
+    dmaRxBusy = false;
+    if(rxMode == SERIAL_RX_BUFFERED) setRxMode(rxMode);
+    if(dmaRxCb) dmaRxCb(status, dmaRxArg);
+}
+
+/**
+ * Private: uDMA bus error, abort every transfer of the owner whose channel was stopped
+ * @param owner is the SerialPort instance
+ */
+void SerialPort::onDmaError(void* owner){
+    SerialPort* port = (SerialPort*)owner;
+    if(port->dmaTxBusy && !UDMA::isActive(UART_DMA_RX_CH[port->UART] + 1)) port->endDmaTx(_PRINT_STATUS_ERROR);
+    if(port->dmaRxBusy && !UDMA::isActive(UART_DMA_RX_CH[port->UART])) port->endDmaRx(_PRINT_STATUS_ERROR);
+}
+
+/**
+ * Dispatch a UART interrupt to the SerialPort instance that opened the module
+ *
+ * @param uart is the UART module that raised the interrupt
+ */
+void SerialPort::serviceInterrupt(uint8_t uart){
+    if(uart <= 7 && instances[uart] != 0){
+        instances[uart]->handleInterrupt();
+    }
+}
+
 
 /**
  * TM4C1294 has 8 different UART Modules UART0 - UART7
@@ -147,11 +781,16 @@ inline int SerialPort::assertValidUART(){
  *
  * @param c is the byte to send
  * @param flags not needed
- * @return ERROR if not valid UART, else NO ERROR
+ * @return ERROR if not valid UART or byte dropped (SERIAL_TX_OVF_DROP_NEWEST),
+ *      TIMEOUT if the setTimeout time passed, else NO ERROR
  */
-PrintStatus SerialPort::write(uint8_t c, uint8_t flags){
+PrintStatus SerialPort::write(uint8_t c, uint8_t){
     if(!assertValidUART()) return _PRINT_STATUS_ERROR;
-    while(((*UART_FSTAT_R) & 0x20) != 0x00); //Wait until last Tx char send
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    if(txMode == SERIAL_TX_BUFFERED) return bufferByte(c, deadline);
+    while(((*UART_FSTAT_R) & 0x20) != 0x00){ //Wait until last Tx char send
+        if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+    }
     *UART_R = c;
     return _PRINT_STATUS_OK;
 }
@@ -160,22 +799,40 @@ PrintStatus SerialPort::write(uint8_t c, uint8_t flags){
  * Overrides Print class write method
  *
  * @param txt is the character string to send
- * @param n is the length of the string
+ * With FIFOs enabled, up to 16 bytes are written per TX FIFO status check
+ *
+ * @param n is the number of bytes to send (may include '\0' bytes)
  *      if n < 0, print all the string
  * @param flags not needed
- * @return ERROR if not valid UART, else NO ERROR
+ * @return ERROR if not valid UART or byte dropped, TIMEOUT if the setTimeout time
+ *      passed (bytes before were sent), else NO ERROR
  */
-PrintStatus SerialPort::write(const char* txt, int n, uint8_t flags){
+PrintStatus SerialPort::write(const char* txt, int n, uint8_t){
+    PROBE_SCOPE(PROBE_SERIAL_WRITE);
     if(!assertValidUART()) return _PRINT_STATUS_ERROR;
 
-    uint8_t count = 0;
-    while(*txt && (n<0 || count<n)){
-        if(count == 0 && !(*(txt+1))){  //Unique byte
-            return write(*txt);
-        }else{                          //Intermediate byte
-           write(*txt);
+    int count = 0;
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    if(txMode == SERIAL_TX_BUFFERED){
+        while(n<0 ? *txt != 0 : count<n){
+            PrintStatus status = bufferByte(*(txt++), deadline);
+            if(status != _PRINT_STATUS_OK) return status;
+            count++;
+        }
+        return _PRINT_STATUS_OK;
+    }
+
+    uint8_t depth = fifoEnabled ? 16 : 1;
+    while(n<0 ? *txt != 0 : count<n){
+        while(((*UART_FSTAT_R) & UART_FR_TXFF) != 0x00){ //Wait until room for a byte
+            if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+        }
+        //Empty FIFO takes a whole burst without checking status again
+        uint8_t room = ((*UART_FSTAT_R) & UART_FR_TXFE) != 0x00 ? depth : 1;
+        while(room-- && (n<0 ? *txt != 0 : count<n)){
+            *UART_R = *(txt++);
+            count++;
         }
-        txt++;  count++;
     }
     return _PRINT_STATUS_OK;
 }
@@ -184,14 +841,14 @@ PrintStatus SerialPort::write(const char* txt, int n, uint8_t flags){
 #ifdef __cplusplus
 extern "C"{
 #endif
-void SerialPort_UART0_Interrupt(){}
-void SerialPort_UART1_Interrupt(){}
-void SerialPort_UART2_Interrupt(){}
-void SerialPort_UART3_Interrupt(){}
-void SerialPort_UART4_Interrupt(){}
-void SerialPort_UART5_Interrupt(){}
-void SerialPort_UART6_Interrupt(){}
-void SerialPort_UART7_Interrupt(){}
+void SerialPort_UART0_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART0); }
+void SerialPort_UART1_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART1); }
+void SerialPort_UART2_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART2); }
+void SerialPort_UART3_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART3); }
+void SerialPort_UART4_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART4); }
+void SerialPort_UART5_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART5); }
+void SerialPort_UART6_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART6); }
+void SerialPort_UART7_Interrupt(){ SerialPort::serviceInterrupt(SERIALPORT_UART7); }
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,12 @@
 #define PERIPHERALS_SERIALPORT_HPP_
 
 #include <Util/Print.hpp>
+#include <Util/RingBuffer.hpp>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/UDMA.hpp>
+#include <Peripherals/Clock.hpp>
+#include <Peripherals/Timebase.hpp>
+#include <Peripherals/Pin.hpp>
 #include <stdint.h>
 #include <stdarg.h>
 
@@ -29,25 +35,154 @@
 #define SERIALPORT_UART6    6
 #define SERIALPORT_UART7    7
 
+// UART pins, checked against GPIO_PIN_AF in SerialPort.cpp
+static constexpr uint8_t UART_PORT_OFF[] = {0, 1, 0, 0, 0, 2, 13, 2}; //GPIO Base offset
+static constexpr uint8_t UART_RXIO_B[] = {0, 0, 6, 4, 2, 6, 0, 4}; //RXIO Bit, TX = RXIO + 1
+
+#define UART_FR_TXFE    0x80    //Transmit FIFO (holding register) empty
+#define UART_FR_TXFF    0x20    //Transmit FIFO (holding register) full
+#define UART_FR_RXFE    0x10    //Receive FIFO (holding register) empty
+#define UART_FR_BUSY    0x08    //UART busy transmitting
+#define UART_CTL_LBE    0x80    //Loopback enable (TX internally connected to RX)
+
+#define UART_DR_FE      0x100   //Framing error
+#define UART_DR_PE      0x200   //Parity error
+#define UART_DR_BE      0x400   //Break error
+#define UART_DR_OE      0x800   //Overrun error
+
+// TX MODE
+//      BLOCKING    - write waits until UART can accept the byte
+//      BUFFERED    - write stores the byte in a ring buffer drained by the UART interrupt
+#define SERIAL_TX_BLOCKING      0x00
+#define SERIAL_TX_BUFFERED      0x01
+
+// TX BUFFER OVERFLOW POLICY (BUFFERED mode only)
+#define SERIAL_TX_OVF_BLOCK         0x00    //Wait until buffer has room
+#define SERIAL_TX_OVF_DROP_NEWEST   0x01    //Discard the byte being written
+#define SERIAL_TX_OVF_DROP_OLDEST   0x02    //Discard the oldest buffered byte
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE   128         //Must be a power of 2
+#endif
+
+// RX MODE
+//      BLOCKING    - read methods take bytes straight from the UART
+//      BUFFERED    - UART interrupt stores received bytes in a ring buffer
+#define SERIAL_RX_BLOCKING      0x00
+#define SERIAL_RX_BUFFERED      0x01
+
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE   128         //Must be a power of 2
+#endif
+
+#define SERIAL_WAIT_FOREVER     0xFFFFFFFF
+
+// FIFO INTERRUPT TRIGGER LEVELS (UARTIFLS)
+#define SERIAL_FIFO_1_8     0x00    //2 bytes
+#define SERIAL_FIFO_1_4     0x01    //4 bytes
+#define SERIAL_FIFO_1_2     0x02    //8 bytes
+#define SERIAL_FIFO_3_4     0x03    //12 bytes
+#define SERIAL_FIFO_7_8     0x04    //14 bytes
+
+// Receive error counters
+typedef struct{
+    uint32_t overrun;   //UART FIFO overrun, bytes lost before being read
+    uint32_t framing;   //Missing stop bit
+    uint32_t parity;
+    uint32_t breaks;    //Break condition received
+    uint32_t dropped;   //RX ring buffer full, bytes lost
+} SerialErrorStats;
+
 class SerialPort:public Print{
     public:
         SerialPort();
         SerialPort(uint32_t, uint8_t=0);
+        ~SerialPort();
 
         void open();
         void close();
 
         char read();
-        char* readline(char* const, uint8_t = 20, bool = true);
+        bool read(char&, uint64_t);
+        char* readline(char* const, uint8_t = 20, bool = true, uint64_t = TIMEBASE_FOREVER);
+        void setTimeout(uint32_t);
+
+        void setFifo(bool, uint8_t = SERIAL_FIFO_1_8, uint8_t = SERIAL_FIFO_1_2);
+        void setLoopback(bool);
+        void setRxMode(uint8_t);
+        void setLineCallback(TransferCallback, void* = 0);
+        uint16_t available();
+        bool tryRead(char&);
+        int readBytes(char*, int, uint32_t = SERIAL_WAIT_FOREVER);
+        bool tryReadline(char* const, uint8_t = 20, bool = true);
+        SerialErrorStats errorStats();
+        void clearErrorStats();
+
+        PrintStatus writeAsync(const void*, uint16_t, TransferCallback = 0, void* = 0);
+        PrintStatus readAsync(void*, uint16_t, TransferCallback = 0, void* = 0);
+        bool writeBusy();
+        bool readBusy();
+
+        void setTxMode(uint8_t, uint8_t = SERIAL_TX_OVF_BLOCK);
+        bool flush(uint64_t = TIMEBASE_FOREVER);
+        uint16_t txPending();
+        uint32_t txDropped();
+
+        static void serviceInterrupt(uint8_t);
 
     private:
         uint8_t UART;
-        uint32_t* PORT_R;
-        uint32_t* UART_R;
-        uint32_t* UART_FSTAT_R;
+        HwReg* PORT_R;
+        HwReg* UART_R;
+        HwReg* UART_FSTAT_R;
         uint32_t baud;
+        uint32_t timeoutUs;             //Blocking calls limit, TIMEBASE_NO_TIMEOUT if none
+
+        uint8_t txMode;
+        uint8_t txOverflow;
+        volatile bool txActive;
+        volatile uint32_t txDropCount;
+        RingBuffer<uint8_t, SERIAL_TX_BUFFER_SIZE> txRing;
+
+        uint8_t rxMode;
+        bool fifoEnabled;
+        uint8_t fifoLevels;
+        uint8_t lineFsm;
+        uint8_t lineCount;
+        volatile SerialErrorStats rxErrors; //Counted by the UART interrupt
+        RingBuffer<uint8_t, SERIAL_RX_BUFFER_SIZE> rxRing;
+        TransferCallback rxLineCb;      //Newline stored in rxRing
+        void* rxLineArg;
+
+        const uint8_t* dmaTxBuf;        //Next chunk to program
+        volatile uint16_t dmaTxLeft;    //Bytes not yet programmed
+        volatile bool dmaTxBusy;
+        TransferCallback dmaTxCb;
+        void* dmaTxArg;
+        uint8_t* dmaRxBuf;
+        volatile uint16_t dmaRxLeft;
+        volatile bool dmaRxBusy;
+        TransferCallback dmaRxCb;
+        void* dmaRxArg;
+
+        static SerialPort* instances[8];
 
         inline int assertValidUART();
+        inline bool altClock();
+        void setDivisors(uint32_t);
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+        void resetState();
+        uint64_t until(uint64_t);
+        uint8_t receiveByte(uint32_t);
+        bool lineStep(char* const, uint8_t, bool, char);
+        PrintStatus bufferByte(uint8_t, uint64_t);
+        void startTx();
+        void handleInterrupt();
+        void startDmaTx();
+        void startDmaRx();
+        void endDmaTx(PrintStatus);
+        void endDmaRx(PrintStatus);
+        static void onDmaError(void*);
 
         PrintStatus write(uint8_t c, uint8_t flags=0) override;
         PrintStatus write(const char* txt, int n, uint8_t flags)override;
@@ -0,0 +1,352 @@
+/*
+ * SerialPortT.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_SERIALPORTT_HPP_
+#define PERIPHERALS_SERIALPORTT_HPP_
+
+#include <stdint.h>
+#include <../inc/tm4c1294ncpdt.h>
+#include <Util/PrintT.hpp>
+#include <Peripherals/SerialPort.hpp>
+#include <Peripherals/Pin.hpp>
+
+// Compile-time UART driver: the module is a template argument, so register
+// addresses and pins are constants, an invalid module doesn't compile, and
+// print/printf call the writes directly (PrintT). Blocking (polled) TX and RX
+// only, 8N1, same baud clock selection as SerialPort (PIOSC up to 1 Mbaud,
+// system clock above, reprogrammed on Clock::set switches).
+// SerialPort stays for code that needs Print& (runtime module), the ring
+// buffers, the uDMA or the interrupts. Don't open both on the same UART.
+//
+//   SerialPortT<SERIALPORT_UART0> console(115200);
+//   console.printf("T=%2f\r\n", t);
+
+template<uint8_t UART>
+class SerialPortT:public PrintT<SerialPortT<UART>>{
+    static_assert(UART <= SERIALPORT_UART7, "SerialPortT UART must be SERIALPORT_UART0 to SERIALPORT_UART7");
+    friend class PrintT<SerialPortT<UART>>;
+
+    public:
+        typedef Pin<UART_PORT_OFF[UART], UART_RXIO_B[UART]> Rx;
+        typedef Pin<UART_PORT_OFF[UART], UART_RXIO_B[UART] + 1> Tx;
+        static constexpr uint32_t BASE = UART_MODULE_BASE + ((uint32_t)UART << 12);  //UART registers
+
+        SerialPortT(uint32_t = 9600);
+        ~SerialPortT();
+
+        void open();
+        void close();
+
+        char read();
+        bool read(char&, uint64_t);
+        bool tryRead(char&);
+        uint16_t available();
+        void setTimeout(uint32_t);
+        bool flush(uint64_t = TIMEBASE_FOREVER);
+
+        void setFifo(bool);
+        void setLoopback(bool);
+        const SerialErrorStats& errorStats();
+
+    private:
+        uint32_t baud;
+        uint32_t timeoutUs;         //Blocking calls limit, TIMEBASE_NO_TIMEOUT if none
+        bool fifoEnabled;
+        SerialErrorStats rxErrors;
+
+        static SerialPortT* instance;   //Opened port, for the clock switches
+
+        inline bool altClock();
+        void setDivisors(uint32_t);
+        static void onClockChange(uint8_t, uint32_t, uint32_t);
+        inline uint64_t until(uint64_t);
+
+        inline PrintStatus write(uint8_t, uint8_t = 0);
+        PrintStatus write(const char*, int, uint8_t);
+};
+
+template<uint8_t UART>
+SerialPortT<UART>* SerialPortT<UART>::instance = 0;
+
+/**
+ * SerialPortT Constructor, opens the UART
+ * @param baudrate is the speed at which UART will work
+ */
+template<uint8_t UART>
+SerialPortT<UART>::SerialPortT(uint32_t baudrate){
+    baud = baudrate;
+    timeoutUs = TIMEBASE_NO_TIMEOUT;
+    fifoEnabled = false;
+    rxErrors = {0, 0, 0, 0, 0};
+    open();
+}
+
+/**
+ * SerialPortT destructor, clock switches stop using this instance
+ */
+template<uint8_t UART>
+SerialPortT<UART>::~SerialPortT(){
+    if(instance == this){
+        instance = 0;
+        Clock::unsubscribe(onClockChange);
+    }
+}
+
+/**
+ * Enable the UART and its pins, 8N1, interrupts masked
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::open(){
+    SYSCTL_RCGCUART_R |= 1 << UART;     //Enable UART Clock
+    Rx::enable();
+    Rx::template alternate<1>();
+    Tx::template alternate<1>();
+    while((SYSCTL_PRUART_R & (1 << UART)) == 0);
+
+    TIVA_HWREG(BASE + 0x030) = 0x300;   //Disable UART and set default UART Control configuration.
+    setDivisors(altClock() ? CPU_PIOSC_FREQUENCY : systemClock());
+    TIVA_HWREG(BASE + 0x02C) = fifoEnabled ? 0x70 : 0x60;   //Line Control 8 bits, FIFO (16 or 1 byte), 1 stop bit, no parity
+    TIVA_HWREG(BASE + 0xFC8) = altClock() ? 0x05 : 0x00;    //Select alternative clock (PIOSC) or system clock as source
+    TIVA_HWREG(BASE + 0x038) = 0x00;    //Mask all UART interrupts
+    TIVA_HWREG(BASE + 0x030) |= 0x01;   //Enable UART
+
+    instance = this;
+    Clock::subscribe(onClockChange);
+}
+
+/**
+ * Send the pending bytes and disable the UART
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::close(){
+    flush();
+    if(instance == this){
+        instance = 0;
+        Clock::unsubscribe(onClockChange);
+    }
+    SYSCTL_RCGCUART_R &= ~(1 << UART);  //Disable UART Clock
+}
+
+/**
+ * Locks the system until the UART receives a byte (or the setTimeout time passes)
+ * @return Returns the read byte as a char type, '\0' if timed out
+ */
+template<uint8_t UART>
+char SerialPortT<UART>::read(){
+    char c = '\0';
+    read(c, TIMEBASE_FOREVER);
+    return c;
+}
+
+/**
+ * Wait for a received byte until a deadline
+ *
+ * @param c receives the read byte
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return false if the deadline passed first
+ */
+template<uint8_t UART>
+bool SerialPortT<UART>::read(char& c, uint64_t deadline){
+    deadline = until(deadline);
+    while(!tryRead(c)){
+        if(Timebase::expired(deadline)) return false;
+        BOARD_WAIT();
+    }
+    return true;
+}
+
+/**
+ * Read a received byte if there is one, never blocks
+ *
+ * @param c receives the read byte
+ * @return true if a byte was read
+ */
+template<uint8_t UART>
+bool SerialPortT<UART>::tryRead(char& c){
+    if(TIVA_HWREG(BASE + 0x018) & UART_FR_RXFE) return false;   //Nothing received
+    uint32_t dr = TIVA_HWREG(BASE);
+    if(dr & (UART_DR_OE | UART_DR_BE | UART_DR_PE | UART_DR_FE)){
+        if(dr & UART_DR_OE) rxErrors.overrun++;
+        if(dr & UART_DR_BE) rxErrors.breaks++;
+        if(dr & UART_DR_PE) rxErrors.parity++;
+        if(dr & UART_DR_FE) rxErrors.framing++;
+    }
+    c = (char)dr;
+    return true;
+}
+
+/**
+ * @return 1 if a received byte is ready to be read, else 0 (FIFO count not available)
+ */
+template<uint8_t UART>
+uint16_t SerialPortT<UART>::available(){
+    return (TIVA_HWREG(BASE + 0x018) & UART_FR_RXFE) == 0x00 ? 1 : 0;
+}
+
+/**
+ * Limit the time blocking calls wait for the UART (see SerialPort::setTimeout)
+ * @param us is the limit in microseconds, TIMEBASE_NO_TIMEOUT (default) to wait forever
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::setTimeout(uint32_t us){
+    timeoutUs = us;
+}
+
+/**
+ * Wait until the last byte is sent
+ * @param deadline is the Timebase deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return false if the deadline passed first
+ */
+template<uint8_t UART>
+bool SerialPortT<UART>::flush(uint64_t deadline){
+    deadline = until(deadline);
+    while(TIVA_HWREG(BASE + 0x018) & UART_FR_BUSY){
+        if(Timebase::expired(deadline)) return false;
+    }
+    return true;
+}
+
+/**
+ * Enable or disable the 16 byte UART hardware FIFOs (disabled by default)
+ * @param enable if true, TX and RX FIFOs are enabled
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::setFifo(bool enable){
+    flush();
+    fifoEnabled = enable;
+    TIVA_HWREG(BASE + 0x030) &= ~0x01;  //Disable UART
+    TIVA_HWREG(BASE + 0x02C) = fifoEnabled ? 0x70 : 0x60;
+    TIVA_HWREG(BASE + 0x030) |= 0x01;   //Enable UART
+}
+
+/**
+ * Connect TX to RX internally (UART loopback), for self tests
+ * @param enable if true, transmitted bytes are received back instead of going to the TX pin
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::setLoopback(bool enable){
+    flush();
+    TIVA_HWREG(BASE + 0x030) &= ~0x01;  //Disable UART
+    if(enable){
+        TIVA_HWREG(BASE + 0x030) |= UART_CTL_LBE;
+    }else{
+        TIVA_HWREG(BASE + 0x030) &= ~UART_CTL_LBE;
+    }
+    TIVA_HWREG(BASE + 0x030) |= 0x01;   //Enable UART
+}
+
+/**
+ * @return receive error counters
+ */
+template<uint8_t UART>
+const SerialErrorStats& SerialPortT<UART>::errorStats(){
+    return rxErrors;
+}
+
+/**
+ * Private: true if the baud clock is PIOSC (see SerialPort)
+ */
+template<uint8_t UART>
+inline bool SerialPortT<UART>::altClock(){
+    return 16 * baud <= CPU_PIOSC_FREQUENCY;
+}
+
+/**
+ * Private: program the baud rate divisors
+ * @param clock is the UART clock
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::setDivisors(uint32_t clock){
+    uint32_t divisor = (4 * clock + baud / 2) / baud;   //clock / (16 x baud) in 1/64 units, rounded
+    TIVA_HWREG(BASE + 0x024) = divisor >> 6;            //Set Integer baud-rate divisor
+    TIVA_HWREG(BASE + 0x028) = divisor & 0x3F;          //Set Fractional baud-rate divisor
+}
+
+/**
+ * Private: system clock switch listener (see SerialPort::onClockChange)
+ *
+ * @param phase is CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+ * @param oldFreq is the system clock before the switch
+ * @param newFreq is the requested clock (PRE) or the running clock (POST)
+ */
+template<uint8_t UART>
+void SerialPortT<UART>::onClockChange(uint8_t phase, uint32_t oldFreq, uint32_t newFreq){
+    (void)oldFreq;
+    SerialPortT* port = instance;
+    if(port == 0 || port->altClock()) return;   //PIOSC baud clock, not affected
+    if(phase == CLOCK_PRE_CHANGE){
+        while(TIVA_HWREG(BASE + 0x018) & UART_FR_BUSY) BOARD_WAIT();
+    }else{
+        uint32_t ctl = TIVA_HWREG(BASE + 0x030);
+        TIVA_HWREG(BASE + 0x030) = ctl & ~0x01;                 //Disable UART
+        port->setDivisors(newFreq);
+        TIVA_HWREG(BASE + 0x02C) = TIVA_HWREG(BASE + 0x02C);    //Latch divisors
+        TIVA_HWREG(BASE + 0x030) = ctl;
+    }
+}
+
+/**
+ * Private: deadline of a blocking call
+ * @param deadline is the caller deadline, TIMEBASE_FOREVER for the setTimeout one
+ * @return the deadline to wait for, Timer1 isn't used without a limit
+ */
+template<uint8_t UART>
+inline uint64_t SerialPortT<UART>::until(uint64_t deadline){
+    if(deadline != TIMEBASE_FOREVER || timeoutUs == TIMEBASE_NO_TIMEOUT) return deadline;
+    return Timebase::deadline(timeoutUs);
+}
+
+/**
+ * Private: PrintT writer, send a byte
+ *
+ * @param c is the byte to send
+ * @param flags are ignored (no transactions on a UART)
+ * @return OK, TIMEOUT if the setTimeout time passed
+ */
+template<uint8_t UART>
+inline PrintStatus SerialPortT<UART>::write(uint8_t c, uint8_t flags){
+    (void)flags;
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    while(TIVA_HWREG(BASE + 0x018) & UART_FR_TXFF){     //Wait until room for a byte
+        if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+    }
+    TIVA_HWREG(BASE) = c;
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Private: PrintT writer, send n bytes of a string
+ *
+ * @param txt is the string to send
+ * @param n is the number of bytes, if n < 0 send until '\0'
+ * @param flags are ignored (no transactions on a UART)
+ * @return OK, TIMEOUT if the setTimeout time passed
+ */
+template<uint8_t UART>
+PrintStatus SerialPortT<UART>::write(const char* txt, int n, uint8_t flags){
+    (void)flags;
+    PROBE_SCOPE(PROBE_SERIAL_WRITE);
+    int count = 0;
+    uint64_t deadline = until(TIMEBASE_FOREVER);
+    uint8_t depth = fifoEnabled ? 16 : 1;
+    while(n<0 ? *txt != 0 : count<n){
+        while(TIVA_HWREG(BASE + 0x018) & UART_FR_TXFF){ //Wait until room for a byte
+            if(Timebase::expired(deadline)) return _PRINT_STATUS_TIMEOUT;
+        }
+        //Empty FIFO takes a whole burst without checking status again
+        uint8_t room = (TIVA_HWREG(BASE + 0x018) & UART_FR_TXFE) ? depth : 1;
+        while(room-- && (n<0 ? *txt != 0 : count<n)){
+            TIVA_HWREG(BASE) = *(txt++);
+            count++;
+        }
+    }
+    return _PRINT_STATUS_OK;
+}
+
+
+#endif /* PERIPHERALS_SERIALPORTT_HPP_ */
@@ -0,0 +1,187 @@
+/*
+ * Task.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Peripherals/Task.hpp>
+
+// Resume event data
+#define TASK_WAKE_RUN   0   //Run the body if the awaited operation completed
+#define TASK_WAKE_TIMER 1   //Sleep done
+#define TASK_WAKE_LINE  2   //Serial line callback: take the line first
+
+Task::Task(){
+    resumeAt = TASK_DONE;
+    pending = false;
+    status = _PRINT_STATUS_OK;
+    linePort = 0;
+}
+
+/**
+ * Run the task from the beginning, its first step runs from the event loop
+ * @return false if it is already running or the event queue is full
+ */
+bool Task::start(){
+    if(resumeAt != TASK_DONE) return false;
+    resumeAt = 0;
+    pending = false;
+    status = _PRINT_STATUS_OK;
+    if(wake()) return true;
+    resumeAt = TASK_DONE;
+    return false;
+}
+
+/**
+ * @return true if run() reached TASK_END (or TASK_EXIT), or the task wasn't started
+ */
+bool Task::done(){
+    return resumeAt == TASK_DONE;
+}
+
+/**
+ * Awaitable: read device registers (START, reg, repeated START, rx bytes, STOP)
+ *
+ * @param bus is an opened I2CMaster
+ * @param address is the 7-bit slave address
+ * @param reg is the first register
+ * @param buf is the destination, len bytes
+ * @param len is the quantity of bytes to read
+ * @return OK if queued, BUSY if the bus queue is full, ERROR if bus not opened
+ */
+PrintStatus Task::readFrom(I2CMaster& bus, uint8_t address, uint8_t reg, void* buf, uint16_t len){
+    I2CTransaction t = {address, I2C_TRXN_REG, reg, I2C_PRIORITY_NORMAL,
+                        0, 0, (uint8_t*)buf, len, 0, 0, I2C_BUSY, 0};
+    trxn = t;
+    return transfer(bus, &trxn);
+}
+
+/**
+ * Awaitable: write device registers (START, reg, tx bytes, STOP)
+ *
+ * @param bus is an opened I2CMaster
+ * @param address is the 7-bit slave address
+ * @param reg is the first register
+ * @param buf are the bytes to write, must stay valid until the await ends
+ * @param len is the quantity of bytes to write
+ * @return OK if queued, BUSY if the bus queue is full, ERROR if bus not opened
+ */
+PrintStatus Task::writeTo(I2CMaster& bus, uint8_t address, uint8_t reg, const void* buf, uint16_t len){
+    I2CTransaction t = {address, I2C_TRXN_REG, reg, I2C_PRIORITY_NORMAL,
+                        (const uint8_t*)buf, len, 0, 0, 0, 0, I2C_BUSY, 0};
+    trxn = t;
+    return transfer(bus, &trxn);
+}
+
+/**
+ * Awaitable: any I2C transaction, its callback is taken by the task
+ *
+ * @param bus is an opened I2CMaster
+ * @param t is the transaction, must stay valid until the await ends
+ * @return I2CMaster::submit result, status is the transaction status after the await
+ */
+PrintStatus Task::transfer(I2CMaster& bus, I2CTransaction* t){
+    t->callback = onTransfer;
+    t->arg = this;
+    pending = true;
+    PrintStatus s = bus.submit(t);
+    if(s != _PRINT_STATUS_OK) pending = false;
+    return s;
+}
+
+/**
+ * Awaitable: receive a line (see SerialPort::tryReadline), the port must be in
+ * SERIAL_RX_BUFFERED mode. The port line callback is taken while waiting
+ *
+ * @param port is the SerialPort
+ * @param out is the external buffer where the string is stored
+ * @param lim is the maximum length of the buffer (out)
+ * @param crnl is a boolean value for store the newline characters
+ * @return OK
+ */
+PrintStatus Task::readline(SerialPort& port, char* const out, uint8_t lim, bool crnl){
+    lineBuf = out;
+    lineLim = lim;
+    lineCrnl = crnl;
+    linePort = &port;
+    pending = true;
+    port.setLineCallback(onLine, this); //Before the first try, a line can't be missed
+    lineDone();
+    return _PRINT_STATUS_OK;
+}
+
+/**
+ * Awaitable: let ms milliseconds pass, other events run meanwhile
+ * @param ms is the delay in milliseconds
+ * @return OK, BUSY if there is no free event loop timer
+ */
+PrintStatus Task::sleep(uint32_t ms){
+    pending = true;
+    if(EventLoop::after(ms, onTimer, this) != EVENT_NO_TIMER) return _PRINT_STATUS_OK;
+    pending = false;
+    return _PRINT_STATUS_BUSY;
+}
+
+/**
+ * Post a resume event of this task
+ * @return false if the event queue is full
+ */
+bool Task::wake(){
+    return EventLoop::post(resume, this, TASK_WAKE_RUN);
+}
+
+/**
+ * Private: take the awaited line if it is complete
+ * @return true if the line await ended
+ */
+bool Task::lineDone(){
+    if(!linePort->tryReadline(lineBuf, lineLim, lineCrnl)) return false;
+    linePort->setLineCallback(0);
+    linePort = 0;
+    status = _PRINT_STATUS_OK;
+    pending = false;
+    return true;
+}
+
+/**
+ * Private: resume event, continue run() from its suspension point if the awaited
+ * operation completed (an extra resume of a waiting task does nothing)
+ */
+void Task::resume(uint32_t data, void* arg){
+    Task* task = (Task*)arg;
+    if(task->resumeAt == TASK_DONE) return;
+    if(data == TASK_WAKE_TIMER){
+        task->status = _PRINT_STATUS_OK;
+        task->pending = false;
+    }else if(data == TASK_WAKE_LINE){
+        if(task->linePort == 0 || !task->lineDone()) return;
+    }
+    if(task->pending) return;
+    task->run();
+}
+
+/**
+ * Private: event loop timer of sleep
+ */
+void Task::onTimer(uint32_t, void* arg){
+    resume(TASK_WAKE_TIMER, arg);
+}
+
+/**
+ * Private: I2C transaction callback, called from the I2C interrupt
+ */
+void Task::onTransfer(PrintStatus status, void* arg){
+    Task* task = (Task*)arg;
+    task->status = status;
+    task->pending = false;
+    EventLoop::post(resume, task, TASK_WAKE_RUN);
+}
+
+/**
+ * Private: SerialPort line callback, called from the UART interrupt
+ */
+void Task::onLine(PrintStatus, void* arg){
+    EventLoop::post(resume, arg, TASK_WAKE_LINE);
+}
@@ -0,0 +1,93 @@
+/*
+ * Task.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_TASK_HPP_
+#define PERIPHERALS_TASK_HPP_
+
+#include <stdint.h>
+#include <Peripherals/EventLoop.hpp>
+#include <Peripherals/I2CMaster.hpp>
+#include <Peripherals/SerialPort.hpp>
+
+// Stackless coroutines on the event loop (switch based, no allocation)
+// A task is a class derived from Task, its run() body is written between
+// TASK_BEGIN() and TASK_END() and suspends on TASK_AWAIT(operation):
+//
+//   class Sensor:public Task{
+//       I2CMaster& bus;  uint8_t data[6];   //State kept across awaits: members
+//       void run() override{
+//           TASK_BEGIN();
+//           while(1){
+//               TASK_AWAIT(readFrom(bus, 0x68, 0x3B, data, 6));
+//               if(status != I2C_READ_OK) ...
+//               TASK_AWAIT(sleep(10));
+//           }
+//           TASK_END();
+//       }
+//   };
+//
+// The operation is started, the task returns to the event loop and run() is
+// called again at the same point when the interrupt driven completion fires.
+// Local variables don't survive an await (use members), switch statements
+// can't contain awaits and a line can't hold more than one (__LINE__ labels).
+// Any number of tasks run interleaved, one operation in flight per task: size
+// EVENT_QUEUE_SIZE (one resume event per task) and EVENT_MAX_TIMERS (sleeping
+// tasks) for them.
+
+#define TASK_DONE       0xFFFF  //resumeAt of a finished (or not started) task
+
+#define TASK_BEGIN()    switch(resumeAt){ case 0:
+#define TASK_END()      } resumeAt = TASK_DONE; return
+
+// Start op (a PrintStatus awaitable method), suspend until it completes, status holds the result
+#define TASK_AWAIT(op)  do{ status = (op); resumeAt = __LINE__; if(0){ case __LINE__:; } if(pending) return; }while(0)
+// Let the other events run, continue after them
+#define TASK_YIELD()    do{ resumeAt = __LINE__; wake(); return; case __LINE__:; }while(0)
+#define TASK_EXIT()     do{ resumeAt = TASK_DONE; return; }while(0)
+
+class Task{
+    public:
+        Task();
+        virtual ~Task(){}
+
+        bool start();
+        bool done();
+
+    protected:
+        virtual void run() = 0;
+
+        //Awaitable operations, start the operation and return:
+        // OK if started (or done at once), an error code if it couldn't start
+        PrintStatus readFrom(I2CMaster&, uint8_t, uint8_t, void*, uint16_t);
+        PrintStatus writeTo(I2CMaster&, uint8_t, uint8_t, const void*, uint16_t);
+        PrintStatus transfer(I2CMaster&, I2CTransaction*);
+        PrintStatus readline(SerialPort&, char* const, uint8_t = 20, bool = true);
+        PrintStatus sleep(uint32_t);
+
+        bool wake();
+
+        uint16_t resumeAt;      //Line of the suspension point, 0 to start
+        volatile bool pending;  //Awaited operation not completed
+        PrintStatus status;     //Result of the last awaited operation
+
+    private:
+        I2CTransaction trxn;
+        SerialPort* linePort;   //Line being awaited
+        char* lineBuf;
+        uint8_t lineLim;
+        bool lineCrnl;
+
+        bool lineDone();
+        static void resume(uint32_t, void*);
+        static void onTimer(uint32_t, void*);
+        static void onTransfer(PrintStatus, void*);
+        static void onLine(PrintStatus, void*);
+};
+
+
+#endif /* PERIPHERALS_TASK_HPP_ */
@@ -0,0 +1,123 @@
+/*
+ * Timebase.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <../inc/tm4c1294ncpdt.h>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/Timebase.hpp>
+#include "../driverlib/interrupt.h"
+#include "../driverlib/rom_map.h"
+
+#define TIMEBASE_IRQ        21      //Timer1 subtimer A
+#define TIMEBASE_TATO       0x01    //Timer A time-out interrupt
+#define TIMEBASE_TAMIM      0x10    //Timer A match interrupt
+
+volatile uint32_t Timebase::high = 0;
+bool Timebase::running = false;
+
+/**
+ * Start Timer1 as a 32-bit up counter clocked from PIOSC, and its time-out
+ * interrupt (count extension). Called by the first now() if not called before
+ */
+void Timebase::init(){
+    high = 0;
+    SYSCTL_RCGCTIMER_R |= 0x02;                 //Enable Timer 1
+    while((SYSCTL_RCGCTIMER_R & 0x02) == 0x00); //Wait for timer1 clock enable
+    TIMER1_CTL_R = 0x00;                        //Disable Timer A and B
+    TIMER1_CFG_R = 0x00;                        //Configure as 32 bit timer
+    TIMER1_CC_R = 0x01;                         //Alternate clock, ALTCLKCFG reset value is PIOSC
+    TIMER1_TAMR_R = 0x32;                       //Periodic, count up, match interrupt enable
+    TIMER1_TAILR_R = 0xFFFFFFFF;
+    TIMER1_ICR_R = TIMEBASE_TATO | TIMEBASE_TAMIM;
+    TIMER1_IMR_R = TIMEBASE_TATO;               //Match interrupt only while delayUs sleeps
+    NVIC_EN0_R = 1 << TIMEBASE_IRQ;             //Enable NVIC Timer1 Interrupt
+    running = true;
+    TIMER1_CTL_R |= 0x01;                       //Enable Timer1
+}
+
+/**
+ * @return microseconds since init
+ */
+uint64_t Timebase::now(){
+    return ticks() / TIMEBASE_TICKS_US;
+}
+
+/**
+ * Lock-free 64-bit count: an extension not serviced yet (time-out pending,
+ * interrupts disabled or a higher priority handler) is added here
+ * @return Timer1 clocks since init
+ */
+uint64_t Timebase::ticks(){
+    if(!running) init();
+    uint32_t hi, lo;
+    bool wrapped;
+    do{
+        hi = high;
+        lo = TIMER1_TAV_R;
+        wrapped = (TIMER1_RIS_R & TIMEBASE_TATO) != 0;
+    }while(hi != high); //Extended meanwhile, read again
+    if(wrapped && lo < 0x80000000) hi++;    //lo read after the time-out
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * @param us is the time from now in microseconds
+ * @return the absolute deadline, TIMEBASE_FOREVER if us is TIMEBASE_NO_TIMEOUT
+ */
+uint64_t Timebase::deadline(uint32_t us){
+    if(us == TIMEBASE_NO_TIMEOUT) return TIMEBASE_FOREVER;
+    return now() + us;
+}
+
+/**
+ * Wait us microseconds. From thread context the CPU sleeps (WFI) until the
+ * Timer1 match, other interrupts run meanwhile. Short delays, interrupt
+ * handlers and code with interrupts disabled busy wait
+ *
+ * @param us is the delay in microseconds
+ */
+void Timebase::delayUs(uint32_t us){
+    uint64_t end = now() + us;
+    bool masked = MAP_IntMasterDisable();
+    if(!masked) MAP_IntMasterEnable();
+    if(masked || us < TIMEBASE_SLEEP_MIN_US || (NVIC_INT_CTRL_R & NVIC_INT_CTRL_VEC_ACT_M) != 0){
+        while(now() < end) BOARD_WAIT();
+        return;
+    }
+
+    TIMER1_TAMATCHR_R = (uint32_t)(end * TIMEBASE_TICKS_US);    //Low word, an earlier match wakes too early only
+    TIMER1_ICR_R = TIMEBASE_TAMIM;
+    TIMER1_IMR_R |= TIMEBASE_TAMIM;
+    while(1){
+        MAP_IntMasterDisable();         //A match after the check wakes WFI
+        if(now() >= end) break;
+        BOARD_SLEEP();
+        MAP_IntMasterEnable();
+    }
+    TIMER1_IMR_R &= ~TIMEBASE_TAMIM;
+    MAP_IntMasterEnable();
+}
+
+/**
+ * Timer1A interrupt: extend the count, the match interrupt only wakes delayUs
+ */
+void Timebase::serviceInterrupt(){
+    uint32_t mis = TIMER1_MIS_R;
+    bool masked = MAP_IntMasterDisable();   //Extension and flag clear seen at once by higher priority readers
+    if(mis & TIMEBASE_TATO) high++;
+    TIMER1_ICR_R = mis;
+    (void)TIMER1_RIS_R;                     //Clear done before unmasking
+    if(!masked) MAP_IntMasterEnable();
+}
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void Timebase_Timer1A_Interrupt(){ Timebase::serviceInterrupt(); }
+#ifdef __cplusplus
+}
+#endif
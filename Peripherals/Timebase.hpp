@@ -0,0 +1,60 @@
+/*
+ * Timebase.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_TIMEBASE_HPP_
+#define PERIPHERALS_TIMEBASE_HPP_
+
+#include <stdint.h>
+
+// Free running 64-bit microsecond timebase and deadlines
+// Timer1 counts up from PIOSC (16 MHz, GPTM alternate clock), so the timebase
+// keeps its rate across system clock switches. Its time-out interrupt
+// (Timebase_Timer1A_Interrupt) extends the 32-bit count, now() is lock-free
+// from thread and interrupt context, even with interrupts disabled.
+// Timer1 and its interrupt belong to the timebase.
+//
+// A deadline is an absolute now() value, drivers take them to bound blocking calls:
+//   uint64_t d = Timebase::deadline(5000);  //5 ms from now
+//   if(Serial.readline(buf, 30, false, d) == 0) ... //Timed out
+
+#define TIMEBASE_TICKS_US       16      //Timer1 clocks per microsecond (PIOSC)
+#define TIMEBASE_FOREVER        0xFFFFFFFFFFFFFFFFULL   //Deadline that never passes
+#define TIMEBASE_NO_TIMEOUT     0xFFFFFFFF              //Timeout (us) that never passes
+
+#ifndef TIMEBASE_SLEEP_MIN_US
+#define TIMEBASE_SLEEP_MIN_US   20      //Shorter delays busy wait instead of sleeping
+#endif
+
+class Timebase{
+    public:
+        static void init();
+
+        static uint64_t now();
+        static uint64_t ticks();
+        static uint64_t deadline(uint32_t);
+        static inline bool expired(uint64_t);
+
+        static void delayUs(uint32_t);
+
+        static void serviceInterrupt();
+
+    private:
+        static volatile uint32_t high;  //Timer1 time-outs, upper 32 bits of ticks()
+        static bool running;
+};
+
+/**
+ * @param deadline is an absolute time (now() scale) or TIMEBASE_FOREVER
+ * @return true if the deadline passed, Timer1 isn't read for TIMEBASE_FOREVER
+ */
+inline bool Timebase::expired(uint64_t deadline){
+    return deadline != TIMEBASE_FOREVER && now() >= deadline;
+}
+
+
+#endif /* PERIPHERALS_TIMEBASE_HPP_ */
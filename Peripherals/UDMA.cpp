@@ -0,0 +1,163 @@
+/*
+ * UDMA.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <stdint.h>
+#include <../inc/tm4c1294ncpdt.h>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/UDMA.hpp>
+#include "../driverlib/interrupt.h"
+#include "../driverlib/rom_map.h"
+
+#define UDMA_CTL_MODE_M     0x07    //Control word transfer mode field
+
+//Primary control structures only (basic mode), table must be 1024 byte aligned
+//The controller (and the simulator model) writes the control words back
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(1024)
+UDMAControl UDMA_ControlTable[UDMA_CHANNELS];
+#else
+UDMAControl UDMA_ControlTable[UDMA_CHANNELS] __attribute__((aligned(1024)));
+#endif
+
+bool UDMA::initialized = false;
+volatile uint32_t UDMA::errors = 0;
+void* UDMA::owners[UDMA_CHANNELS] = {0};
+UDMAErrorHandler UDMA::errorHandlers[UDMA_CHANNELS] = {0};
+
+/**
+ * Power on the uDMA controller and set the channel control table
+ * Called by claim, so drivers don't need to call it
+ */
+void UDMA::init(){
+    if(initialized) return;
+    SYSCTL_RCGCDMA_R |= 0x01;                   //Enable uDMA clock
+    while((SYSCTL_PRDMA_R & 0x01) == 0x00);     //Wait until uDMA ready
+    UDMA_CFG_R = 0x01;                          //Master enable
+    UDMA_CTLBASE_R = (uint32_t)(uintptr_t)UDMA_ControlTable; //Channel control table base
+    NVIC_EN1_R = 1 << (45 - 32);                //Enable NVIC uDMA Error Interrupt
+    initialized = true;
+}
+
+/**
+ * Reserve a channel and map it to a peripheral
+ *
+ * @param channel is the uDMA channel (0 to 31)
+ * @param encoding is the peripheral assignment for the channel (DMACHMAPn value, 0 to 8)
+ * @param owner identifies the driver that uses the channel
+ * @param onError is called from the uDMA error interrupt while the channel is claimed
+ * @return false if channel is claimed by another owner
+ */
+bool UDMA::claim(uint8_t channel, uint8_t encoding, void* owner, UDMAErrorHandler onError){
+    if(channel >= UDMA_CHANNELS) return false;
+    init();
+
+    bool wasDisabled = MAP_IntMasterDisable();
+    bool granted = owners[channel] == 0 || owners[channel] == owner;
+    if(granted){
+        owners[channel] = owner;
+        errorHandlers[channel] = onError;
+    }
+    if(!wasDisabled) MAP_IntMasterEnable();
+    if(!granted) return false;
+
+    HwReg* map = &UDMA_CHMAP0_R + (channel >> 3);
+    *map = (*map & ~(0x0F << ((channel & 0x07) << 2))) | ((encoding & 0x0F) << ((channel & 0x07) << 2));
+    UDMA_USEBURSTCLR_R = 1 << channel;  //Accept single and burst requests
+    UDMA_ALTCLR_R = 1 << channel;       //Use primary control structure
+    UDMA_PRIOCLR_R = 1 << channel;      //Default priority
+    UDMA_REQMASKCLR_R = 1 << channel;   //Listen to peripheral requests
+    return true;
+}
+
+/**
+ * Free a channel claimed by owner, stopping any transfer on it
+ *
+ * @param channel is the uDMA channel (0 to 31)
+ * @param owner is the object that claimed the channel
+ */
+void UDMA::release(uint8_t channel, void* owner){
+    if(channel >= UDMA_CHANNELS || owners[channel] != owner) return;
+    stop(channel);
+    errorHandlers[channel] = 0;
+    owners[channel] = 0;
+}
+
+/**
+ * Program and enable a basic mode transfer
+ *
+ * @param channel is the claimed uDMA channel
+ * @param src is the source start address
+ * @param dst is the destination start address
+ * @param count is the quantity of items to move (1 to UDMA_MAX_TRANSFER)
+ * @param ctl are the UDMA_CTL_xx increment, size and arbitration flags
+ */
+void UDMA::transfer(uint8_t channel, const volatile void* src, volatile void* dst, uint16_t count, uint32_t ctl){
+    if(channel >= UDMA_CHANNELS || count == 0 || count > UDMA_MAX_TRANSFER) return;
+    uint32_t srcEnd = (uint32_t)(uintptr_t)src;
+    uint32_t dstEnd = (uint32_t)(uintptr_t)dst;
+    uint8_t srcInc = (ctl >> 26) & 0x03;    //Increment as a power of 2 of bytes, 3 = none
+    uint8_t dstInc = (ctl >> 30) & 0x03;
+    if(srcInc != 0x03) srcEnd += (uint32_t)(count - 1) << srcInc;
+    if(dstInc != 0x03) dstEnd += (uint32_t)(count - 1) << dstInc;
+
+    UDMA_ControlTable[channel].srcEnd = srcEnd;
+    UDMA_ControlTable[channel].dstEnd = dstEnd;
+    UDMA_ControlTable[channel].control = (ctl & 0xFFFFC000) | ((uint32_t)(count - 1) << 4) | UDMA_CTL_MODE_BASIC;
+    UDMA_ENASET_R = 1 << channel;
+}
+
+/**
+ * Disable a channel, cancelling the pending part of its transfer
+ * @param channel is the uDMA channel
+ */
+void UDMA::stop(uint8_t channel){
+    if(channel >= UDMA_CHANNELS) return;
+    UDMA_ENACLR_R = 1 << channel;
+    UDMA_ControlTable[channel].control &= ~UDMA_CTL_MODE_M; //STOP mode, nothing left to fail
+}
+
+/**
+ * @param channel is the uDMA channel
+ * @return true while the channel transfer is not complete
+ */
+bool UDMA::isActive(uint8_t channel){
+    if(channel >= UDMA_CHANNELS) return false;
+    return (UDMA_ENASET_R & (1 << channel)) != 0;
+}
+
+/**
+ * @return the number of uDMA bus errors since reset
+ */
+uint32_t UDMA::errorCount(){
+    return errors;
+}
+
+/**
+ * uDMA error interrupt service, the controller disabled the failing channel.
+ * A disabled channel whose control word didn't reach the STOP mode stopped
+ * before its end: its owner is told so it can abort the transfer
+ */
+void UDMA::serviceError(){
+    UDMA_ERRCLR_R = 0x01; //Clear bus error
+    errors++;
+    for(uint8_t ch = 0; ch < UDMA_CHANNELS; ch++){
+        if(owners[ch] != 0 && errorHandlers[ch] != 0 && !isActive(ch)
+                && (UDMA_ControlTable[ch].control & UDMA_CTL_MODE_M) != UDMA_CTL_MODE_STOP){
+            errorHandlers[ch](owners[ch]);
+        }
+    }
+}
+
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void UDMA_Error_Interrupt(){ UDMA::serviceError(); }
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+/*
+ * UDMA.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef PERIPHERALS_UDMA_HPP_
+#define PERIPHERALS_UDMA_HPP_
+
+#include <stdint.h>
+#include <Util/Print.hpp>
+
+#define UDMA_CHANNELS       32
+#define UDMA_MAX_TRANSFER   1024    //Items per basic mode transfer
+#define UDMA_NO_CHANNEL     0xFF
+
+// CHANNEL CONTROL WORD (DMACHCTL)
+#define UDMA_CTL_DST_INC_8      0x00000000  //Destination address increment, byte
+#define UDMA_CTL_DST_INC_16     0x40000000  //Destination address increment, half-word
+#define UDMA_CTL_DST_INC_NONE   0xC0000000  //Destination fixed (peripheral register)
+#define UDMA_CTL_DST_SIZE_8     0x00000000
+#define UDMA_CTL_DST_SIZE_16    0x10000000
+#define UDMA_CTL_SRC_INC_8      0x00000000  //Source address increment, byte
+#define UDMA_CTL_SRC_INC_16     0x04000000  //Source address increment, half-word
+#define UDMA_CTL_SRC_INC_NONE   0x0C000000  //Source fixed (peripheral register)
+#define UDMA_CTL_SRC_SIZE_8     0x00000000
+#define UDMA_CTL_SRC_SIZE_16    0x01000000
+#define UDMA_CTL_ARB_1          0x00000000  //Re-arbitrate after 1 item
+#define UDMA_CTL_ARB_4          0x00008000
+#define UDMA_CTL_ARB_8          0x0000C000
+#define UDMA_CTL_MODE_STOP      0x00000000
+#define UDMA_CTL_MODE_BASIC     0x00000001
+
+#define UDMA_CTL_MEM_TO_PERIPH  (UDMA_CTL_DST_INC_NONE | UDMA_CTL_DST_SIZE_8 | UDMA_CTL_SRC_INC_8 | UDMA_CTL_SRC_SIZE_8)
+#define UDMA_CTL_PERIPH_TO_MEM  (UDMA_CTL_DST_INC_8 | UDMA_CTL_DST_SIZE_8 | UDMA_CTL_SRC_INC_NONE | UDMA_CTL_SRC_SIZE_8)
+#define UDMA_CTL_MEM_TO_PERIPH_16   (UDMA_CTL_DST_INC_NONE | UDMA_CTL_DST_SIZE_16 | UDMA_CTL_SRC_INC_16 | UDMA_CTL_SRC_SIZE_16)
+#define UDMA_CTL_PERIPH_TO_MEM_16   (UDMA_CTL_DST_INC_16 | UDMA_CTL_DST_SIZE_16 | UDMA_CTL_SRC_INC_NONE | UDMA_CTL_SRC_SIZE_16)
+
+/**
+ * Completion callback for asynchronous transfers
+ * @param status is the transfer result (OK, ERROR)
+ * @param arg is the user argument given when the transfer was started
+ */
+typedef void (*TransferCallback)(PrintStatus status, void* arg);
+
+/**
+ * Called from the uDMA error interrupt for every claimed channel
+ * @param owner is the object that claimed the channel
+ */
+typedef void (*UDMAErrorHandler)(void* owner);
+
+// Channel control structure, one per channel in the control table
+typedef struct{
+    volatile uint32_t srcEnd;   //Source end pointer (last item address)
+    volatile uint32_t dstEnd;   //Destination end pointer (last item address)
+    volatile uint32_t control;  //Control word
+    volatile uint32_t spare;
+} UDMAControl;
+
+extern UDMAControl UDMA_ControlTable[UDMA_CHANNELS];  //Primary control structures
+
+class UDMA{
+    public:
+        static void init();
+
+        static bool claim(uint8_t, uint8_t, void*, UDMAErrorHandler = 0);
+        static void release(uint8_t, void*);
+
+        static void transfer(uint8_t, const volatile void*, volatile void*, uint16_t, uint32_t);
+        static void stop(uint8_t);
+        static bool isActive(uint8_t);
+        static uint32_t errorCount();
+
+        static void serviceError();
+
+    private:
+        static bool initialized;
+        static volatile uint32_t errors;
+        static void* owners[UDMA_CHANNELS];
+        static UDMAErrorHandler errorHandlers[UDMA_CHANNELS];
+};
+
+
+#endif /* PERIPHERALS_UDMA_HPP_ */
@@ -0,0 +1,356 @@
+/*
+ * Sim.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Sim/Sim.hpp>
+#include <Sim/SimModels.hpp>
+
+#define SIM_PPB_BASE        0xE0000000U
+#define SIM_PPB_SIZE        0x00010000U
+#define SIM_ALIAS_BASE      0x42000000U                 //Peripheral bit-band alias
+#define SIM_ALIAS_SIZE      (SIM_PERIPH_SIZE << 5)      //A word per peripheral bit
+
+#define SIM_NVIC_EN0        0xE000E100U
+#define SIM_NVIC_DIS0       0xE000E180U
+#define SIM_NVIC_INT_CTRL   0xE000ED04U
+#define SIM_SCB_SCR         0xE000ED10U
+#define SIM_DWT_CYCCNT      0xE0001004U
+
+#define SIM_MAX_MODELS      64
+#define SIM_MAX_DISPATCH    1000    //ISR calls per dispatch before giving up (ISR not clearing its source)
+
+extern void (*simVector(uint8_t irq))();
+extern void simCreateModels();
+
+static SimReg periph[SIM_PERIPH_SIZE >> 2];
+static SimReg ppb[SIM_PPB_SIZE >> 2];
+static SimReg alias[SIM_ALIAS_SIZE >> 2];   //Placeholders, values live in periph
+static SimReg unmapped;
+static SimPeripheral* pages[SIM_PERIPH_SIZE >> 12];    //Model of each 4 KB register block
+static SimPeripheral* models[SIM_MAX_MODELS];
+static uint8_t modelCount = 0;
+
+static bool initialized = false;
+static uint64_t clock = 0;
+static bool primask = false;
+static bool inIsr = false;
+static uint8_t activeVector = 0;
+static uint32_t handled = 0;        //Interrupt handler calls, wakes WFI
+static uint32_t nvicEnabled[4];
+static uint32_t faultCount = 0;
+static uint32_t faultAddress = 0;
+
+static void init(){
+    if(initialized) return;
+    initialized = true;
+    simCreateModels();
+}
+
+static void fault(uint32_t address){
+    faultCount++;
+    faultAddress = address;
+}
+
+/**
+ * Count a fault detected by a model (invalid configuration)
+ * @param address is the register address of the fault
+ */
+void simFault(uint32_t address){
+    fault(address);
+}
+
+/**
+ * Add a model to the register map
+ *
+ * @param p is the model
+ * @param base is the register block address
+ * @param size is the register block size (multiple of 4 KB)
+ */
+void simRegister(SimPeripheral* p, uint32_t base, uint32_t size){
+    if(modelCount == SIM_MAX_MODELS){
+        fault(base);    //Model table full, the block stays plain registers
+        return;
+    }
+    p->base = base;
+    models[modelCount++] = p;
+    for(uint32_t a = base; a < base + size; a += 0x1000){
+        pages[(a - SIM_PERIPH_BASE) >> 12] = p;
+    }
+    p->reset();
+}
+
+/**
+ * @return true if the SYSCTL RCGCx bit of the model is set
+ */
+bool SimPeripheral::clocked(){
+    if(gate == 0) return true;
+    return (periph[(SIM_SYSCTL_BASE + gate - SIM_PERIPH_BASE) >> 2].value & (1 << gateBit)) != 0;
+}
+
+/**
+ * @return the lowest enabled interrupt number with its line asserted, -1 if none
+ */
+static int16_t pendingIrq(){
+    int16_t irq = -1;
+    for(uint8_t i = 0; i < modelCount; i++){
+        int16_t n = models[i]->irqN;
+        if(n < 0 || (nvicEnabled[n >> 5] & (1 << (n & 0x1F))) == 0) continue;
+        if((irq < 0 || n < irq) && models[i]->irq()) irq = n;
+    }
+    return irq;
+}
+
+/**
+ * Run the pending interrupt handlers, lowest interrupt number first
+ */
+static void dispatch(){
+    if(primask || inIsr) return;
+
+    for(uint16_t calls = 0; calls < SIM_MAX_DISPATCH; calls++){
+        int16_t irq = pendingIrq();
+        if(irq < 0) return;
+
+        void (*handler)() = simVector((uint8_t)irq);
+        if(handler == 0){
+            fault(SIM_NVIC_EN0 + ((irq >> 5) << 2)); //Enabled interrupt without handler
+            nvicEnabled[irq >> 5] &= ~(1 << (irq & 0x1F));
+            continue;
+        }
+        inIsr = true;
+        activeVector = (uint8_t)(irq + 16);
+        handled++;
+        handler();
+        activeVector = 0;
+        inIsr = false;
+    }
+}
+
+/**
+ * @param addr is a bit-band alias address
+ * @return the peripheral register of the aliased bit, bit (addr >> 2) & 31
+ */
+static SimReg& aliasWord(uint32_t addr){
+    return periph[(addr - SIM_ALIAS_BASE) >> 7];
+}
+
+static uint32_t ppbRead(uint32_t addr, const SimReg* r){
+    if(addr >= SIM_NVIC_EN0 && addr < SIM_NVIC_EN0 + 16) return nvicEnabled[(addr - SIM_NVIC_EN0) >> 2];
+    if(addr >= SIM_NVIC_DIS0 && addr < SIM_NVIC_DIS0 + 16) return nvicEnabled[(addr - SIM_NVIC_DIS0) >> 2];
+    if(addr == SIM_NVIC_INT_CTRL) return activeVector;
+    if(addr == SIM_DWT_CYCCNT) return (uint32_t)clock;
+    return r->value;
+}
+
+static void ppbWrite(uint32_t addr, uint32_t v, SimReg* r){
+    if(addr >= SIM_NVIC_EN0 && addr < SIM_NVIC_EN0 + 16){
+        nvicEnabled[(addr - SIM_NVIC_EN0) >> 2] |= v;
+        dispatch();
+    }else if(addr >= SIM_NVIC_DIS0 && addr < SIM_NVIC_DIS0 + 16){
+        nvicEnabled[(addr - SIM_NVIC_DIS0) >> 2] &= ~v;
+    }else{
+        r->value = v;
+    }
+}
+
+/**
+ * Register read: advance the clock and let the model compute the value
+ */
+SimReg::operator uint32_t() const{
+    uint32_t addr = Sim::address(this);
+    if(addr - SIM_ALIAS_BASE < SIM_ALIAS_SIZE){     //Bit-band read: word read
+        return ((uint32_t)aliasWord(addr) >> ((addr >> 2) & 0x1F)) & 0x01;
+    }
+    Sim::advance(SIM_ACCESS_CYCLES);
+    if(addr - SIM_PPB_BASE < SIM_PPB_SIZE) return ppbRead(addr, this);
+    if(addr - SIM_PERIPH_BASE >= SIM_PERIPH_SIZE) return 0;
+
+    SimPeripheral* p = pages[(addr - SIM_PERIPH_BASE) >> 12];
+    if(p == 0) return value;
+    if(!p->clocked()){
+        fault(addr);    //Bus fault on target
+        return 0;
+    }
+    return p->read(addr - p->base, *const_cast<SimReg*>(this));
+}
+
+/**
+ * Register write: advance the clock and let the model apply the value
+ */
+SimReg& SimReg::operator=(uint32_t v){
+    uint32_t addr = Sim::address(this);
+    if(addr - SIM_ALIAS_BASE < SIM_ALIAS_SIZE){     //Bit-band write: locked word read and write
+        SimReg& word = aliasWord(addr);
+        uint32_t bit = 1U << ((addr >> 2) & 0x1F);
+        uint32_t w = word;
+        word = (v & 0x01) ? (w | bit) : (w & ~bit);
+        return *this;
+    }
+    Sim::advance(SIM_ACCESS_CYCLES);
+    if(addr - SIM_PPB_BASE < SIM_PPB_SIZE){
+        ppbWrite(addr, v, this);
+        return *this;
+    }
+    if(addr - SIM_PERIPH_BASE >= SIM_PERIPH_SIZE) return *this;
+
+    SimPeripheral* p = pages[(addr - SIM_PERIPH_BASE) >> 12];
+    if(p == 0){
+        value = v;
+    }else if(!p->clocked()){
+        fault(addr);
+    }else{
+        p->write(addr - p->base, v, *this);
+        Sim::advance(0);    //Take interrupts raised by the write
+    }
+    return *this;
+}
+
+namespace Sim{
+    /**
+     * @param address is a TM4C1294 register address
+     * @return the simulated register at address
+     */
+    SimReg* reg(uint32_t address){
+        init();
+        if(address - SIM_PERIPH_BASE < SIM_PERIPH_SIZE) return &periph[(address - SIM_PERIPH_BASE) >> 2];
+        if(address - SIM_PPB_BASE < SIM_PPB_SIZE) return &ppb[(address - SIM_PPB_BASE) >> 2];
+        if(address - SIM_ALIAS_BASE < SIM_ALIAS_SIZE) return &alias[(address - SIM_ALIAS_BASE) >> 2];
+        fault(address);
+        return &unmapped;
+    }
+
+    /**
+     * @param r is a simulated register
+     * @return the TM4C1294 address of the register
+     */
+    uint32_t address(const SimReg* r){
+        if(r >= periph && r < periph + (SIM_PERIPH_SIZE >> 2)) return SIM_PERIPH_BASE + (uint32_t)(r - periph) * 4;
+        if(r >= ppb && r < ppb + (SIM_PPB_SIZE >> 2)) return SIM_PPB_BASE + (uint32_t)(r - ppb) * 4;
+        if(r >= alias && r < alias + (SIM_ALIAS_SIZE >> 2)) return SIM_ALIAS_BASE + (uint32_t)(r - alias) * 4;
+        return 0;
+    }
+
+    /**
+     * Power on reset: registers, models, clock and interrupt state
+     */
+    void reset(){
+        init();
+        for(uint32_t i = 0; i < (SIM_PERIPH_SIZE >> 2); i++) periph[i].value = 0;
+        for(uint32_t i = 0; i < (SIM_PPB_SIZE >> 2); i++) ppb[i].value = 0;
+        for(uint8_t i = 0; i < 4; i++) nvicEnabled[i] = 0;
+        for(uint8_t i = 0; i < modelCount; i++) models[i]->reset();
+        clock = 0;
+        primask = false;
+        inIsr = false;
+        activeVector = 0;
+        faultCount = 0;
+        faultAddress = 0;
+    }
+
+    /**
+     * @return the virtual clock, CPU cycles since reset
+     */
+    uint64_t now(){
+        return clock;
+    }
+
+    /**
+     * Advance the virtual clock, running model events and interrupt handlers
+     * in time order
+     * @param cycles is the quantity of CPU cycles to advance
+     */
+    void advance(uint32_t cycles){
+        init();
+        uint64_t target = clock + cycles;
+        do{
+            uint64_t next = target;
+            for(uint8_t i = 0; i < modelCount; i++){
+                uint64_t t = models[i]->nextEvent();
+                if(t < next) next = t;
+            }
+            if(next > clock) clock = next;
+            for(uint8_t i = 0; i < modelCount; i++){
+                models[i]->advance(clock);
+            }
+            dispatch();
+        }while(clock < target);
+    }
+
+    /**
+     * Busy wait iteration (BOARD_WAIT)
+     */
+    void idle(){
+        advance(SIM_WAIT_CYCLES);
+    }
+
+    /**
+     * WFI (BOARD_SLEEP): run the virtual clock to the next model event until an
+     * enabled interrupt is pending (PRIMASK set) or its handler ran (PRIMASK clear).
+     * Sleeping with no model event ahead never wakes on target, it is counted as a fault
+     */
+    void sleep(){
+        init();
+        uint32_t calls = handled;
+        while(pendingIrq() < 0 && handled == calls){
+            uint64_t next = SIM_NEVER;
+            for(uint8_t i = 0; i < modelCount; i++){
+                uint64_t t = models[i]->nextEvent();
+                if(t < next) next = t;
+            }
+            if(next == SIM_NEVER){
+                fault(SIM_SCB_SCR);
+                return;
+            }
+            uint64_t cycles = next > clock ? next - clock : 1;
+            advance(cycles > 0xFFFFFFFFU ? 0xFFFFFFFFU : (uint32_t)cycles);
+        }
+    }
+
+    /**
+     * @return true if interrupts were already disabled
+     */
+    bool masterDisable(){
+        bool was = primask;
+        primask = true;
+        return was;
+    }
+
+    /**
+     * @return true if interrupts were disabled
+     */
+    bool masterEnable(){
+        bool was = primask;
+        primask = false;
+        dispatch();
+        return was;
+    }
+
+    /**
+     * @return accesses to unmapped addresses or clock gated modules since reset
+     */
+    uint32_t faults(){
+        return faultCount;
+    }
+
+    /**
+     * @return address of the last fault
+     */
+    uint32_t lastFault(){
+        return faultAddress;
+    }
+}
+
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+// driverlib replacements
+void SysCtlDelay(uint32_t count){ Sim::advance(3 * count); } //3 cycles per loop
+bool IntMasterEnable(void){ return Sim::masterEnable(); }
+bool IntMasterDisable(void){ return Sim::masterDisable(); }
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Sim.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_SIM_HPP_
+#define SIM_SIM_HPP_
+
+// Host register level simulator of the TM4C1294NCPDT peripherals used by the library.
+//
+// Build the drivers for Linux with TIVA_SIM defined and the Sim shim headers first
+// in the include path, they replace TivaWare inc/ and driverlib/:
+//
+//   g++ -std=c++14 -DTIVA_SIM -I. -ISim -ISim/driverlib -c app.cpp Sim/*.cpp Peripherals/*.cpp Util/*.cpp
+//   gcc -std=c99 -DTIVA_SIM -I. -c Util/Format.c
+//
+// Every register is a SimReg in a simulated register file. Reads and writes go
+// through the peripheral models and advance a virtual CPU cycle clock:
+//  - SYSCTL: RCGCx clock gating (access to a gated module is counted as a fault), PRx ready,
+//      MOSC, PLL and system clock switch, checked against the flash wait states
+//  - UART: TX/RX FIFOs, FR flags, trigger level interrupts, baud rate timing, loopback
+//  - I2C master: MCS state machine, byte and FIFO burst commands, slave models,
+//      NACK, arbitration lost, clock timeout and stuck SDA injection
+//  - SSI: Freescale SPI master, 8 frame TX/RX FIFOs, bit rate timing, bi and quad
+//      modes (frame time / lanes, half-duplex), slave models selected by the FSS pin
+//      (driven as a GPIO), SPI-NOR flash model, loopback, end of transmission interrupt
+//  - GPIO: GPIODATA masking and pin levels, I2C pins driven as GPIOs (bus recovery)
+//  - Timer0-3: timer A as a 32-bit periodic or one shot, up or down counter, system
+//      clock or PIOSC, TAV, time-out and match interrupts (event loop tick, timebase)
+//  - Peripheral bit-band alias (0x42000000): a bit access is a read and a write of its word
+//  - NVIC enables, VECTACTIVE and interrupt dispatch, DWT CYCCNT = virtual clock,
+//      WFI (BOARD_SLEEP) runs the clock to the next model event
+//  - uDMA: channel enables, bus error injection (the channel stops, ERRCLR and error
+//      interrupt), completion (STOP mode written back to the control table); no DMA
+//      transfers are made, enabled channels stay active until completed
+// Timer4-7 and the other modules are plain registers.
+// Interrupt handlers are the startup vector table ones (SerialPort_UARTn_Interrupt, ...).
+//
+// Call Sim::reset() at the start of every scenario, then attach slaves, inject
+// bytes or faults, run the driver code and check the results (uartOutput, ...).
+//
+// The virtual clock counts system clock cycles, at the frequency selected in
+// RSCLKCFG (Sim::systemClock(), PIOSC after reset). Sim::reset() goes back to
+// PIOSC: call initSystemClock() again in every scenario that uses the PLL.
+// It counts modeled time only: SIM_ACCESS_CYCLES per register access,
+// SysCtlDelay loops, busy waits (BOARD_WAIT) and bus transfer times.
+// Instructions between register accesses are not counted.
+
+#include <stdint.h>
+
+#define SIM_ACCESS_CYCLES   2   //Cycles per peripheral register access
+#define SIM_WAIT_CYCLES     4   //Cycles per BOARD_WAIT() busy wait iteration
+
+/**
+ * Simulated 32-bit memory mapped register
+ * Same layout as a uint32_t, so register pointer arithmetic works unchanged
+ */
+class SimReg{
+    public:
+        operator uint32_t() const;
+        SimReg& operator=(uint32_t);
+        SimReg& operator=(const SimReg& r){ return *this = (uint32_t)r; }
+        SimReg& operator|=(uint32_t v){ return *this = (uint32_t)*this | v; }
+        SimReg& operator&=(uint32_t v){ return *this = (uint32_t)*this & v; }
+        SimReg& operator^=(uint32_t v){ return *this = (uint32_t)*this ^ v; }
+
+        uint32_t value; //Stored value, as seen by the models
+};
+
+/**
+ * I2C slave device model, attached to a simulated I2C bus
+ */
+class SimI2CSlave{
+    public:
+        virtual ~SimI2CSlave(){}
+        /**
+         * START (or repeated START) with this slave address
+         * @param read is the R/S bit
+         * @return true to ACK the address
+         */
+        virtual bool start(bool read){ (void)read; return true; }
+        /**
+         * @param data is the byte sent by the master
+         * @return true to ACK the byte
+         */
+        virtual bool write(uint8_t data){ (void)data; return true; }
+        /**
+         * @param ack is false for the last byte the master reads (NACK)
+         * @return the byte to send to the master
+         */
+        virtual uint8_t read(bool ack){ (void)ack; return 0xFF; }
+        virtual void stop(){}
+};
+
+/**
+ * Register pointer memory slave (EEPROM/sensor style): the first byte written
+ * after START selects the register, next writes store and reads return
+ * consecutive registers
+ */
+class SimI2CMemory:public SimI2CSlave{
+    public:
+        SimI2CMemory();
+        bool start(bool) override;
+        bool write(uint8_t) override;
+        uint8_t read(bool) override;
+
+        uint8_t mem[256];
+        uint8_t pointer;
+        int16_t nackAfter;  //NACK the data byte after this many written bytes (-1 never)
+
+    private:
+        bool first;
+        int16_t written;
+};
+
+/**
+ * SPI slave device model, attached to a simulated SSI bus
+ */
+class SimSPISlave{
+    public:
+        virtual ~SimSPISlave(){}
+        /**
+         * Chip select (FSS pin) asserted
+         */
+        virtual void select(){}
+        /**
+         * @param mosi is the frame sent by the master (meaningless in bi and quad receive frames)
+         * @param bits is the frame size
+         * @param lanes is 1 (legacy), 2 (bi) or 4 (quad)
+         * @return the frame sent to the master (ignored in bi and quad send frames)
+         */
+        virtual uint16_t exchange(uint16_t mosi, uint8_t bits, uint8_t lanes){ (void)mosi; (void)bits; (void)lanes; return 0xFFFF; }
+        /**
+         * Chip select deasserted
+         */
+        virtual void deselect(){}
+};
+
+#define SIM_FLASH_SIZE  0x10000     //SimSPIFlash bytes, addresses wrap
+
+/**
+ * SPI-NOR flash slave: JEDEC ID, status, write enable, fast read on 1, 2 and
+ * 4 lanes (8 dummy clocks), page program on 1 and 4 lanes, 4 KB sector erase.
+ * Frames on other lanes than the command expects are counted in laneErrors
+ */
+class SimSPIFlash:public SimSPISlave{
+    public:
+        SimSPIFlash();
+        void select() override;
+        uint16_t exchange(uint16_t, uint8_t, uint8_t) override;
+        void deselect() override;
+
+        uint8_t mem[SIM_FLASH_SIZE];    //Erased (0xFF) at construction
+        uint32_t jedecId;       //Manufacturer, type and capacity bytes
+        uint16_t busyPolls;     //Status reads with WIP set after a program or erase
+        uint32_t laneErrors;
+
+    private:
+        uint8_t cmd;
+        uint32_t count;         //Frames since select
+        uint32_t address;
+        uint8_t dummyClocks;
+        bool wel;               //Write enable latch
+        bool written;           //Program or erase to finish at deselect
+        uint16_t busy;          //Status reads left with WIP set
+};
+
+namespace Sim{
+    SimReg* reg(uint32_t address);
+    uint32_t address(const SimReg* r);
+
+    void reset();
+    uint64_t now();
+    void advance(uint32_t cycles);
+    void idle();
+    void sleep();
+
+    bool masterDisable();
+    bool masterEnable();
+
+    uint32_t faults();
+    uint32_t lastFault();
+    uint32_t systemClock();
+
+    void uartInject(uint8_t uart, const char* data, int n = -1);
+    const char* uartOutput(uint8_t uart);
+    uint32_t uartOutputLength(uint8_t uart);
+    void uartClearOutput(uint8_t uart);
+    uint32_t uartStatusReads(uint8_t uart);
+
+    void i2cAttach(uint8_t i2cx, uint8_t address, SimI2CSlave* slave);
+    void i2cDetach(uint8_t i2cx, uint8_t address);
+    void i2cInjectArbLost(uint8_t i2cx, uint16_t byteIndex);
+    void i2cInjectStretch(uint8_t i2cx, uint16_t byteIndex);
+    void i2cInjectStuckSda(uint8_t i2cx, uint8_t clocks);
+    bool i2cSdaStuck(uint8_t i2cx);
+    uint64_t i2cBusyCycles(uint8_t i2cx);
+
+    bool udmaInjectError(uint8_t channel);
+    bool udmaComplete(uint8_t channel);
+    uint32_t udmaEnabled();
+
+    void spiAttach(uint8_t ssi, SimSPISlave* slave);
+    uint32_t spiFrames(uint8_t ssi);
+    uint64_t spiBusyCycles(uint8_t ssi);
+}
+
+
+#endif /* SIM_SIM_HPP_ */
@@ -0,0 +1,613 @@
+/*
+ * SimBoard.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// TM4C1294NCPDT memory map of the simulator models and interrupt vectors
+
+#include <Sim/SimModels.hpp>
+#include <Peripherals/Board.hpp>
+#include <Peripherals/UDMA.hpp>
+
+#define SIM_UDMA_BASE       0x400FF000U
+#define SIM_GPIO_BASE       0x40058000U //AHB aperture, port A
+#define SIM_UART_BASE       0x4000C000U
+#define SIM_SSI_BASE        0x40008000U
+#define SIM_TIMER_BASE      0x40030000U //Timer 0
+
+#define SIM_SYSCTL_MOSCCTL  0x07C
+#define SIM_SYSCTL_RSCLKCFG 0x0B0
+#define SIM_SYSCTL_MEMTIM0  0x0C0
+#define SIM_SYSCTL_PLLFREQ0 0x160
+#define SIM_SYSCTL_PLLFREQ1 0x164
+#define SIM_SYSCTL_PLLSTAT  0x168
+
+#define SIM_UDMA_ENASET     0x028
+#define SIM_UDMA_ENACLR     0x02C
+#define SIM_UDMA_ERRCLR     0x04C
+
+#define SIM_TIMER_TAMR      0x004
+#define SIM_TIMER_CTL       0x00C
+#define SIM_TIMER_IMR       0x018
+#define SIM_TIMER_RIS       0x01C
+#define SIM_TIMER_MIS       0x020
+#define SIM_TIMER_ICR       0x024
+#define SIM_TIMER_TAILR     0x028
+#define SIM_TIMER_TAMATCHR  0x030
+#define SIM_TIMER_TAR       0x048
+#define SIM_TIMER_TAV       0x050
+#define SIM_TIMER_CC        0xFC8
+#define SIM_TIMER_TATO      0x01    //Timer A time-out interrupt
+#define SIM_TIMER_TAMIM     0x10    //Timer A match interrupt
+#define SIM_TIMER_TACDIR    0x10    //TAMR count up
+#define SIM_TIMER_TAMIE     0x20    //TAMR match interrupt enable
+
+#define SIM_GPIO_DIR        0x400
+#define SIM_GPIO_AFSEL      0x420
+
+static const uint32_t I2C_BASE[] = {0x40020000, 0x40021000, 0x40022000, 0x40023000, 0x400C0000,
+                                    0x400C1000, 0x400C2000, 0x400C3000, 0x400B8000, 0x400B9000};
+static const uint8_t I2C_IRQ_N[] = {8, 37, 61, 62, 70, 71, 102, 103, 109, 110};
+static const uint8_t I2C_PORT[] = {1, 6, 10, 9, 9, 1, 0, 0, 0, 0};     //GPIO port (A = 0)
+static const uint8_t I2C_SCL_PIN[] = {2, 0, 1, 4, 6, 0, 6, 4, 2, 0};
+static const uint8_t I2C_SDA_PIN[] = {3, 1, 0, 5, 7, 1, 7, 5, 3, 1};
+static const uint8_t UART_IRQ_N[] = {5, 6, 33, 56, 57, 58, 59, 60};
+static const uint8_t SSI_IRQ_N[] = {7, 34, 54, 55};
+static const uint8_t SSI_FSS_PORT[] = {0, 1, 3, 14};   //GPIO port (A = 0)
+static const uint8_t SSI_FSS_PIN[] = {3, 4, 2, 1};
+static const uint8_t TIMER_IRQ_N[] = {19, 21, 23, 35};  //Timer A
+
+// Built on first use, drivers may be constructed before main (static objects)
+struct SimBoard{
+    SimSysCtl sysctl;
+    SimUDMA udma;
+    SimTimer timers[4];
+    SimGPIO gpio[15];
+    SimUART uarts[8];
+    SimI2C i2cs[10];
+    SimSSI ssis[4];
+};
+
+static SimBoard& board(){
+    static SimBoard b;
+    return b;
+}
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+void SerialPort_UART0_Interrupt();  void SerialPort_UART1_Interrupt();
+void SerialPort_UART2_Interrupt();  void SerialPort_UART3_Interrupt();
+void SerialPort_UART4_Interrupt();  void SerialPort_UART5_Interrupt();
+void SerialPort_UART6_Interrupt();  void SerialPort_UART7_Interrupt();
+void I2CMaster_I2C0_Interrupt();    void I2CMaster_I2C1_Interrupt();
+void I2CMaster_I2C2_Interrupt();    void I2CMaster_I2C3_Interrupt();
+void I2CMaster_I2C4_Interrupt();    void I2CMaster_I2C5_Interrupt();
+void I2CMaster_I2C6_Interrupt();    void I2CMaster_I2C7_Interrupt();
+void I2CMaster_I2C8_Interrupt();    void I2CMaster_I2C9_Interrupt();
+void SPIMaster_SSI0_Interrupt();    void SPIMaster_SSI1_Interrupt();
+void SPIMaster_SSI2_Interrupt();    void SPIMaster_SSI3_Interrupt();
+void UDMA_Error_Interrupt();
+void EventLoop_Timer0A_Interrupt();
+void Timebase_Timer1A_Interrupt();
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @param irq is the NVIC interrupt number
+ * @return the handler of the startup vector table, 0 if unassigned
+ */
+void (*simVector(uint8_t irq))(){
+    switch(irq){
+        case 5: return SerialPort_UART0_Interrupt;
+        case 6: return SerialPort_UART1_Interrupt;
+        case 7: return SPIMaster_SSI0_Interrupt;
+        case 8: return I2CMaster_I2C0_Interrupt;
+        case 19: return EventLoop_Timer0A_Interrupt;
+        case 21: return Timebase_Timer1A_Interrupt;
+        case 33: return SerialPort_UART2_Interrupt;
+        case 34: return SPIMaster_SSI1_Interrupt;
+        case 37: return I2CMaster_I2C1_Interrupt;
+        case 45: return UDMA_Error_Interrupt;
+        case 54: return SPIMaster_SSI2_Interrupt;
+        case 55: return SPIMaster_SSI3_Interrupt;
+        case 56: return SerialPort_UART3_Interrupt;
+        case 57: return SerialPort_UART4_Interrupt;
+        case 58: return SerialPort_UART5_Interrupt;
+        case 59: return SerialPort_UART6_Interrupt;
+        case 60: return SerialPort_UART7_Interrupt;
+        case 61: return I2CMaster_I2C2_Interrupt;
+        case 62: return I2CMaster_I2C3_Interrupt;
+        case 70: return I2CMaster_I2C4_Interrupt;
+        case 71: return I2CMaster_I2C5_Interrupt;
+        case 102: return I2CMaster_I2C6_Interrupt;
+        case 103: return I2CMaster_I2C7_Interrupt;
+        case 109: return I2CMaster_I2C8_Interrupt;
+        case 110: return I2CMaster_I2C9_Interrupt;
+    }
+    return 0;
+}
+
+/**
+ * Map every model to its register block, RCGCx gate and interrupt
+ */
+void simCreateModels(){
+    SimBoard& b = board();
+    simRegister(&b.sysctl, SIM_SYSCTL_BASE, 0x1000);
+
+    b.udma.gate = SIM_RCGC_DMA;
+    b.udma.irqN = 45;
+    simRegister(&b.udma, SIM_UDMA_BASE, 0x1000);
+
+    for(uint8_t i = 0; i < 4; i++){
+        b.timers[i].gate = SIM_RCGC_TIMER;
+        b.timers[i].gateBit = i;
+        b.timers[i].irqN = TIMER_IRQ_N[i];
+        simRegister(&b.timers[i], SIM_TIMER_BASE + (i << 12), 0x1000);
+    }
+
+    for(uint8_t i = 0; i < 15; i++){
+        b.gpio[i].gate = SIM_RCGC_GPIO;
+        b.gpio[i].gateBit = i;
+        simRegister(&b.gpio[i], SIM_GPIO_BASE + (i << 12), 0x1000);
+    }
+    for(uint8_t i = 0; i < 8; i++){
+        b.uarts[i].gate = SIM_RCGC_UART;
+        b.uarts[i].gateBit = i;
+        b.uarts[i].irqN = UART_IRQ_N[i];
+        simRegister(&b.uarts[i], SIM_UART_BASE + (i << 12), 0x1000);
+    }
+    for(uint8_t i = 0; i < 10; i++){
+        b.i2cs[i].gate = SIM_RCGC_I2C;
+        b.i2cs[i].gateBit = i;
+        b.i2cs[i].irqN = I2C_IRQ_N[i];
+        simRegister(&b.i2cs[i], I2C_BASE[i], 0x1000);
+
+        SimGPIO& port = b.gpio[I2C_PORT[i]];
+        port.i2c[I2C_SCL_PIN[i]] = &b.i2cs[i];
+        port.i2c[I2C_SDA_PIN[i]] = &b.i2cs[i];
+        port.sclPins |= 1 << I2C_SCL_PIN[i];
+    }
+    for(uint8_t i = 0; i < 4; i++){
+        b.ssis[i].gate = SIM_RCGC_SSI;
+        b.ssis[i].gateBit = i;
+        b.ssis[i].irqN = SSI_IRQ_N[i];
+        simRegister(&b.ssis[i], SIM_SSI_BASE + (i << 12), 0x1000);
+        b.gpio[SSI_FSS_PORT[i]].fss[SSI_FSS_PIN[i]] = &b.ssis[i];
+    }
+}
+
+/**
+ * PRx (0xA00 - 0xAFF) reads the matching RCGCx (0x600 - 0x6FF), modules are
+ * ready as soon as their clock is enabled
+ */
+uint32_t SimSysCtl::read(uint32_t offset, SimReg& r){
+    if(offset >= 0xA00 && offset < 0xB00) return regAt(offset - 0x400).value;
+    return r.value;
+}
+
+/**
+ * Power on state: PIOSC system clock, MOSC powered down, PLL off
+ */
+void SimSysCtl::reset(){
+    frequency = CPU_PIOSC_FREQUENCY;
+    waitStates = 0;
+    regAt(SIM_SYSCTL_MOSCCTL).value = 0x0C;         //NOXTAL, PWRDN
+    regAt(SIM_SYSCTL_MEMTIM0).value = 0x00300030;   //16 MHz timing
+}
+
+/**
+ * @param src is an OSCSRC or PLLSRC field
+ * @return the oscillator frequency, 0 if it isn't running
+ */
+uint32_t SimSysCtl::source(uint8_t src){
+    if(src == 0x0) return CPU_PIOSC_FREQUENCY;
+    if(src == 0x3 && (reg(SIM_SYSCTL_MOSCCTL) & 0x08) == 0) return CPU_MOSC_FREQUENCY;
+    return 0;
+}
+
+void SimSysCtl::write(uint32_t offset, uint32_t v, SimReg& r){
+    if(offset == SIM_SYSCTL_MOSCCTL){
+        r.value = v;
+        if((v & 0x08) == 0) regAt(0x050).value |= 0x100;   //PWRDN clear: RIS MOSCPUPRIS
+    }else if(offset == SIM_SYSCTL_RSCLKCFG){
+        r.value = v & 0x3FFFFFFF;   //NEWFREQ and MEMTIMU read as 0
+        uint32_t pll0 = reg(SIM_SYSCTL_PLLFREQ0);
+        uint32_t pll1 = reg(SIM_SYSCTL_PLLFREQ1);
+        if(v & 0x40000000){         //NEWFREQ: PLL locks at once if powered and its input runs
+            bool lock = (pll0 & 0x00800000) != 0 && source((v >> 24) & 0x0F) != 0;
+            regAt(SIM_SYSCTL_PLLSTAT).value = lock ? 0x01 : 0x00;
+        }
+        if(v & 0x80000000) waitStates = reg(SIM_SYSCTL_MEMTIM0) & 0x0F;
+
+        double f;
+        if(v & 0x10000000){         //USEPLL
+            if((reg(SIM_SYSCTL_PLLSTAT) & 0x01) == 0){
+                simFault(base + offset);    //PLL not locked
+                return;
+            }
+            double fin = (double)source((v >> 24) & 0x0F) / (((pll1 & 0x1F) + 1) * (((pll1 >> 8) & 0x1F) + 1));
+            double vco = fin * ((pll0 & 0x3FF) + ((pll0 >> 10) & 0x3FF) / 1024.0);
+            f = vco / ((v & 0x3FF) + 1);                //PSYSDIV
+        }else{
+            f = (double)source((v >> 20) & 0x0F) / (((v >> 10) & 0x3FF) + 1);  //OSCSRC / OSYSDIV
+        }
+        uint32_t needed = 0;        //1 wait state per 20 MHz over 16 MHz
+        while(needed < 5 && f > (needed == 0 ? 16e6 : 20e6 * (needed + 1))) needed++;
+        if(f < 1 || f > 120e6 || waitStates < needed){
+            simFault(base + offset);
+            return;
+        }
+        frequency = (uint32_t)(f + 0.5);
+    }else{
+        r.value = v;
+    }
+}
+
+uint32_t SimUDMA::read(uint32_t offset, SimReg& r){
+    if(offset == SIM_UDMA_ENASET || offset == SIM_UDMA_ENACLR) return enabled;
+    if(offset == SIM_UDMA_ERRCLR) return error ? 0x01 : 0x00;
+    return r.value;
+}
+
+void SimUDMA::write(uint32_t offset, uint32_t v, SimReg& r){
+    if(offset == SIM_UDMA_ENASET){
+        enabled |= v;
+    }else if(offset == SIM_UDMA_ENACLR){
+        enabled &= ~v;
+    }else if(offset == SIM_UDMA_ERRCLR){
+        if(v & 0x01) error = false;     //Write 1 to clear
+    }else{
+        r.value = v;
+    }
+}
+
+/**
+ * Bus error on a channel transfer: the controller disables the channel and
+ * raises the error interrupt
+ * @param channel is the uDMA channel (0 to 31)
+ * @return false if the channel isn't enabled (no transfer to fail)
+ */
+bool SimUDMA::busError(uint8_t channel){
+    if(channel >= 32 || (enabled & (1U << channel)) == 0) return false;
+    enabled &= ~(1U << channel);
+    error = true;
+    return true;
+}
+
+/**
+ * End of a channel transfer: the controller writes the STOP mode and a zero
+ * transfer size back to the control word and disables the channel
+ * @param channel is the uDMA channel (0 to 31)
+ * @return false if the channel isn't enabled (no transfer to complete)
+ */
+bool SimUDMA::complete(uint8_t channel){
+    if(channel >= 32 || (enabled & (1U << channel)) == 0) return false;
+    UDMA_ControlTable[channel].control &= ~0x3FF7U;    //XFERSIZE and XFERMODE
+    enabled &= ~(1U << channel);
+    return true;
+}
+
+/**
+ * @return pin levels: pulled up unless driven low as a GPIO output or held low by an I2C slave
+ */
+uint8_t SimGPIO::pins(){
+    uint8_t level = (uint8_t)(~reg(SIM_GPIO_DIR) | reg(SIM_GPIO_AFSEL) | data);
+    for(uint8_t b = 0; b < 8; b++){
+        if(i2c[b] != 0 && (sclPins & (1 << b)) == 0 && i2c[b]->sdaStuck) level &= ~(1 << b);
+    }
+    return level;
+}
+
+void SimGPIO::reset(){
+    data = 0;
+    levels = 0xFF;
+}
+
+/**
+ * GPIODATA (0x000 - 0x3FC): address bits 9:2 mask the pins read
+ */
+uint32_t SimGPIO::read(uint32_t offset, SimReg& r){
+    if(offset < 0x400) return pins() & (offset >> 2);
+    return r.value;
+}
+
+/**
+ * GPIODATA (0x000 - 0x3FC): address bits 9:2 mask the pins written.
+ * Rising edges of I2C pins in GPIO mode: SCL clocks the bus, SDA with SCL high is a STOP.
+ * SSI FSS pins in GPIO mode select (low) or deselect (high) the SSI slave
+ */
+void SimGPIO::write(uint32_t offset, uint32_t v, SimReg& r){
+    if(offset < 0x400){
+        uint8_t mask = (uint8_t)(offset >> 2);
+        data = (data & ~mask) | (v & mask);
+    }else{
+        r.value = v;
+    }
+
+    uint8_t now = pins();
+    uint8_t rise = now & ~levels & ~reg(SIM_GPIO_AFSEL);
+    uint8_t change = (now ^ levels) & ~reg(SIM_GPIO_AFSEL);
+    levels = now;
+    for(uint8_t b = 0; b < 8; b++){
+        if(fss[b] != 0 && (change & (1 << b))) fss[b]->chipSelect((now & (1 << b)) == 0);
+    }
+    for(uint8_t b = 0; b < 8; b++){
+        if(i2c[b] == 0 || (rise & (1 << b)) == 0) continue;
+        if(sclPins & (1 << b)){
+            i2c[b]->sclPulse();
+            continue;
+        }
+        for(uint8_t c = 0; c < 8; c++){
+            if(i2c[c] == i2c[b] && (sclPins & (1 << c)) && (now & (1 << c))) i2c[b]->busStop();
+        }
+    }
+}
+
+uint32_t SimTimer::read(uint32_t offset, SimReg& r){
+    if(offset == SIM_TIMER_RIS) return ris;
+    if(offset == SIM_TIMER_MIS) return ris & reg(SIM_TIMER_IMR);
+    if(offset == SIM_TIMER_TAV || offset == SIM_TIMER_TAR){
+        return (reg(SIM_TIMER_TAMR) & SIM_TIMER_TACDIR) ? elapsed : reg(SIM_TIMER_TAILR) - elapsed;
+    }
+    return r.value;
+}
+
+void SimTimer::write(uint32_t offset, uint32_t v, SimReg& r){
+    if(offset == SIM_TIMER_ICR){
+        ris &= ~v;
+        return;
+    }
+    advance(Sim::now());    //Count at the old settings up to now
+    uint32_t was = r.value;
+    r.value = v;
+    if(offset == SIM_TIMER_CTL && (v & 0x01) && (was & 0x01) == 0){
+        elapsed = 0;        //TAEN set: count from the start
+        fraction = 0;
+    }else if(offset == SIM_TIMER_TAILR){
+        elapsed = 0;        //TAILD = 0: counter reloads on the next cycle
+    }
+}
+
+void SimTimer::reset(){
+    elapsed = 0;
+    fraction = 0;
+    last = 0;
+    ris = 0;
+}
+
+bool SimTimer::running(){
+    return (reg(SIM_TIMER_CTL) & 0x01) != 0;
+}
+
+/**
+ * @return timer clocks per virtual clock cycle
+ */
+double SimTimer::rate(){
+    return (reg(SIM_TIMER_CC) & 0x01) ? (double)CPU_PIOSC_FREQUENCY / Sim::systemClock() : 1.0;
+}
+
+/**
+ * @return timer clocks to the next match (TAMIE set), SIM_NEVER if disabled
+ */
+uint64_t SimTimer::matchDistance(){
+    uint32_t tamr = reg(SIM_TIMER_TAMR);
+    if((tamr & SIM_TIMER_TAMIE) == 0) return SIM_NEVER;
+    uint64_t period = (uint64_t)reg(SIM_TIMER_TAILR) + 1;
+    uint32_t match = reg(SIM_TIMER_TAMATCHR);
+    uint64_t at = (tamr & SIM_TIMER_TACDIR) ? match : (uint64_t)reg(SIM_TIMER_TAILR) - match;
+    if(at >= period) return SIM_NEVER;
+    return at > elapsed ? at - elapsed : at + period - elapsed;
+}
+
+/**
+ * Count timer clocks, raising the time-out and match interrupts passed
+ * @param n is the quantity of timer clocks
+ */
+void SimTimer::count(uint64_t n){
+    uint64_t period = (uint64_t)reg(SIM_TIMER_TAILR) + 1;
+    if(matchDistance() <= n) ris |= SIM_TIMER_TAMIM;
+    uint64_t e = elapsed + n;
+    if(e >= period){
+        ris |= SIM_TIMER_TATO;
+        if((reg(SIM_TIMER_TAMR) & 0x03) == 0x01){
+            regAt(SIM_TIMER_CTL).value &= ~0x01;    //One shot: TAEN cleared at time-out
+            e = 0;
+        }else{
+            e %= period;
+        }
+    }
+    elapsed = (uint32_t)e;
+}
+
+void SimTimer::advance(uint64_t now){
+    if(now <= last) return;
+    if(running()){
+        double ticks = (now - last) * rate() + fraction;
+        uint64_t whole = (uint64_t)ticks;
+        fraction = ticks - whole;
+        if(whole != 0) count(whole);
+    }
+    last = now;
+}
+
+/**
+ * @return virtual clock of the next time-out or match
+ */
+uint64_t SimTimer::nextEvent(){
+    if(!running()) return SIM_NEVER;
+    uint64_t ticks = (uint64_t)reg(SIM_TIMER_TAILR) + 1 - elapsed;
+    uint64_t match = matchDistance();
+    if(match < ticks) ticks = match;
+    double cycles = (ticks - fraction) / rate();
+    uint64_t c = (uint64_t)cycles;
+    if(c < cycles) c++;
+    return last + (c ? c : 1);
+}
+
+bool SimTimer::irq(){
+    return (ris & reg(SIM_TIMER_IMR)) != 0;
+}
+
+namespace Sim{
+    /**
+     * @return the simulated system clock frequency, in Hz
+     */
+    uint32_t systemClock(){
+        return board().sysctl.frequency;
+    }
+
+    /**
+     * Receive bytes on a UART RX line, one frame time apart
+     * @param uart is the UART module (0 to 7)
+     * @param data are the bytes
+     * @param n is the quantity of bytes (n < 0, until '\0')
+     */
+    void uartInject(uint8_t uart, const char* data, int n){
+        if(uart < 8) board().uarts[uart].inject(data, n);
+    }
+
+    /**
+     * @param uart is the UART module (0 to 7)
+     * @return the bytes sent on the TX line since reset or uartClearOutput
+     */
+    const char* uartOutput(uint8_t uart){
+        return uart < 8 ? board().uarts[uart].output.c_str() : "";
+    }
+
+    /**
+     * @param uart is the UART module (0 to 7)
+     * @return quantity of bytes sent on the TX line since reset or uartClearOutput
+     */
+    uint32_t uartOutputLength(uint8_t uart){
+        return uart < 8 ? (uint32_t)board().uarts[uart].output.size() : 0;
+    }
+
+    void uartClearOutput(uint8_t uart){
+        if(uart < 8) board().uarts[uart].output.clear();
+    }
+
+    /**
+     * @param uart is the UART module (0 to 7)
+     * @return UARTFR reads (status polls) since reset
+     */
+    uint32_t uartStatusReads(uint8_t uart){
+        return uart < 8 ? board().uarts[uart].statusReads : 0;
+    }
+
+    /**
+     * Connect a slave model to an I2C bus
+     * @param i2cx is the I2C module (0 to 9)
+     * @param address is the 7-bit slave address
+     * @param slave is the slave model, must stay valid while attached
+     */
+    void i2cAttach(uint8_t i2cx, uint8_t address, SimI2CSlave* slave){
+        if(i2cx < 10) board().i2cs[i2cx].slaves[address & 0x7F] = slave;
+    }
+
+    void i2cDetach(uint8_t i2cx, uint8_t address){
+        if(i2cx < 10) board().i2cs[i2cx].slaves[address & 0x7F] = 0;
+    }
+
+    /**
+     * Lose the arbitration on a future bus byte
+     * @param i2cx is the I2C module (0 to 9)
+     * @param byteIndex is the byte (address bytes included) counted from the next one, 0 = next
+     */
+    void i2cInjectArbLost(uint8_t i2cx, uint16_t byteIndex){
+        if(i2cx < 10) board().i2cs[i2cx].arbLostAt = (int32_t)(board().i2cs[i2cx].byteCount + byteIndex);
+    }
+
+    /**
+     * Slave holds SCL low before a future bus byte, until the MCLKOCNT clock timeout
+     * @param i2cx is the I2C module (0 to 9)
+     * @param byteIndex is the byte (address bytes included) counted from the next one, 0 = next
+     */
+    void i2cInjectStretch(uint8_t i2cx, uint16_t byteIndex){
+        if(i2cx < 10) board().i2cs[i2cx].stretchAt = (int32_t)(board().i2cs[i2cx].byteCount + byteIndex);
+    }
+
+    /**
+     * A slave holds SDA low (reset in the middle of a byte) until SCL is pulsed
+     * clocks times as a GPIO (bus recovery), STARTs lose the arbitration meanwhile
+     * @param i2cx is the I2C module (0 to 9)
+     * @param clocks is the quantity of SCL pulses that release SDA, over 9 never
+     */
+    void i2cInjectStuckSda(uint8_t i2cx, uint8_t clocks){
+        if(i2cx < 10) board().i2cs[i2cx].sdaStuck = clocks > 9 ? 0xFF : clocks;
+    }
+
+    /**
+     * @param i2cx is the I2C module (0 to 9)
+     * @return true while a slave holds SDA low
+     */
+    bool i2cSdaStuck(uint8_t i2cx){
+        return i2cx < 10 && board().i2cs[i2cx].sdaStuck != 0;
+    }
+
+    /**
+     * @param i2cx is the I2C module (0 to 9)
+     * @return CPU cycles the bus spent transferring since reset
+     */
+    uint64_t i2cBusyCycles(uint8_t i2cx){
+        return i2cx < 10 ? board().i2cs[i2cx].busyCycles : 0;
+    }
+
+    /**
+     * Fail the transfer of a uDMA channel with a bus error, the error
+     * interrupt runs as soon as interrupts allow it
+     * @param channel is the uDMA channel (0 to 31)
+     * @return false if the channel has no transfer enabled
+     */
+    bool udmaInjectError(uint8_t channel){
+        bool failed = board().udma.busError(channel);
+        advance(0);
+        return failed;
+    }
+
+    /**
+     * Complete the transfer of a uDMA channel, as if all its items were moved
+     * (the peripheral done interrupt isn't raised)
+     * @param channel is the uDMA channel (0 to 31)
+     * @return false if the channel has no transfer enabled
+     */
+    bool udmaComplete(uint8_t channel){
+        return board().udma.complete(channel);
+    }
+
+    /**
+     * @return the enabled uDMA channels (ENASET), a bit per channel
+     */
+    uint32_t udmaEnabled(){
+        return board().udma.enabled;
+    }
+
+    /**
+     * Connect a slave model to a SSI bus, selected by the module FSS pin
+     * @param ssi is the SSI module (0 to 3)
+     * @param slave is the slave model, must stay valid while attached (0 to detach)
+     */
+    void spiAttach(uint8_t ssi, SimSPISlave* slave){
+        if(ssi < 4) board().ssis[ssi].slave = slave;
+    }
+
+    /**
+     * @param ssi is the SSI module (0 to 3)
+     * @return frames shifted since reset
+     */
+    uint32_t spiFrames(uint8_t ssi){
+        return ssi < 4 ? board().ssis[ssi].frames : 0;
+    }
+
+    /**
+     * @param ssi is the SSI module (0 to 3)
+     * @return CPU cycles the bus spent transferring since reset
+     */
+    uint64_t spiBusyCycles(uint8_t ssi){
+        return ssi < 4 ? board().ssis[ssi].busyCycles : 0;
+    }
+}
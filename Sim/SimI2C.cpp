@@ -0,0 +1,406 @@
+/*
+ * SimI2C.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Sim/SimModels.hpp>
+
+#define I2C_MCS_RUN         0x01
+#define I2C_MCS_START       0x02
+#define I2C_MCS_STOP        0x04
+#define I2C_MCS_ACK         0x08
+#define I2C_MCS_BURST       0x40
+
+#define I2C_MCS_BUSY        0x01
+#define I2C_MCS_ERROR       0x02
+#define I2C_MCS_ADRACK      0x04
+#define I2C_MCS_DATACK      0x08
+#define I2C_MCS_ARBLST      0x10
+#define I2C_MCS_IDLE        0x20
+#define I2C_MCS_BUSBSY      0x40
+#define I2C_MCS_CLKTO       0x80
+
+#define I2C_RIS_IM          0x001
+#define I2C_RIS_CLK         0x002
+#define I2C_RIS_NACK        0x010
+#define I2C_RIS_TX          0x100
+#define I2C_RIS_RX          0x200
+#define I2C_RIS_TXFE        0x400
+#define I2C_RIS_RXFF        0x800
+
+#define I2C_FIFO_SIZE       8
+
+/**
+ * Power on state: bus idle, FIFOs empty, no slaves injected faults
+ */
+void SimI2C::reset(){
+    ops.clear();
+    txFifo.clear();
+    rxFifo.clear();
+    opEnd = SIM_NEVER;
+    timeout = SIM_NEVER;
+    stretched = false;
+    burst = false;
+    busHeld = false;
+    errorHold = false;
+    reading = false;
+    target = 0;
+    status = 0;
+    ris = 0;
+    byteCount = 0;
+    arbLostAt = -1;
+    stretchAt = -1;
+    sdaStuck = 0;
+    busyCycles = 0;
+    regAt(0x00C).value = 0x01;      //MTPR
+    regAt(0xF04).value = 0x40004;   //FIFOCTL: triggers 4, 4
+}
+
+/**
+ * @return CPU cycles per SCL period, 20 x (TPR + 1), 6 x (TPR + 1) in high speed mode
+ */
+uint64_t SimI2C::period(){
+    return ((reg(0x00C) & 0x80) ? 6 : 20) * (uint64_t)((reg(0x00C) & 0x7F) + 1);
+}
+
+/**
+ * Decode an MCS command into bus operations
+ * @param cmd is the value written to MCS
+ */
+void SimI2C::command(uint8_t cmd){
+    if((reg(0x020) & 0x10) == 0) return;    //Master function disabled
+    if(!ops.empty()){                       //Busy, command ignored
+        if(burst && cmd == I2C_MCS_STOP && reg(0x030) == 0) cutBurst(); //Except a burst cut short
+        return;
+    }
+
+    status = 0;
+    if(errorHold){  //Previous error left the bus held, only a STOP is accepted
+        errorHold = false;
+        if(cmd & I2C_MCS_STOP){
+            ops.push_back(OP_STOP);
+            startOp(Sim::now());
+        }
+        return;
+    }
+
+    burst = (cmd & I2C_MCS_BURST) != 0;
+    if((cmd & I2C_MCS_START) && sdaStuck){ //Can't drive the START, SDA is low
+        status = I2C_MCS_ERROR | I2C_MCS_ARBLST;
+        done();
+        return;
+    }
+    if(cmd & I2C_MCS_START){
+        reading = (reg(0x000) & 0x01) != 0;
+        ops.push_back(OP_START);
+        ops.push_back(OP_ADDR);
+    }else if(!busHeld){
+        return;     //Nothing to continue
+    }
+
+    if(burst){
+        uint32_t n = reg(0x030) & 0xFF;
+        regAt(0x034).value = n;
+        for(uint32_t i = 0; i < n; i++){
+            if(reading){
+                ops.push_back((i + 1 < n || (cmd & I2C_MCS_ACK)) ? OP_RX_ACK : OP_RX);
+            }else{
+                ops.push_back(OP_TX);
+            }
+        }
+    }else if(cmd & I2C_MCS_RUN){
+        if(reading){
+            ops.push_back((cmd & I2C_MCS_ACK) ? OP_RX_ACK : OP_RX);
+        }else{
+            ops.push_back(OP_TX);
+        }
+    }
+    if(cmd & I2C_MCS_STOP) ops.push_back(OP_STOP);
+
+    startOp(Sim::now());
+}
+
+/**
+ * STOP written during a burst after MBLEN was cleared: the byte on the bus
+ * ends, the bytes left are dropped and a STOP is sent
+ */
+void SimI2C::cutBurst(){
+    bool running = opEnd != SIM_NEVER || stretched;
+    uint8_t op = ops.front();
+    ops.clear();
+    if(running) ops.push_back(op);
+    if(!running || op != OP_STOP) ops.push_back(OP_STOP);
+    regAt(0x034).value = 0;
+    if(!running) startOp(Sim::now());
+}
+
+/**
+ * Start the next bus operation, or stall it waiting for the FIFOs or a
+ * stretched SCL
+ * @param t is the start time
+ */
+void SimI2C::startOp(uint64_t t){
+    if(ops.empty()){
+        done();
+        return;
+    }
+
+    uint8_t op = ops.front();
+    bool data = op == OP_ADDR || op == OP_TX || op == OP_RX || op == OP_RX_ACK;
+    if(burst && op == OP_TX && txFifo.empty()){ opEnd = SIM_NEVER; return; }    //Wait for TX FIFO data
+    if(burst && (op == OP_RX || op == OP_RX_ACK) && rxFifo.size() >= I2C_FIFO_SIZE){ opEnd = SIM_NEVER; return; }
+
+    if(data && stretchAt >= 0 && byteCount == (uint32_t)stretchAt){
+        stretchAt = -1;
+        stretched = true;
+        opEnd = SIM_NEVER;
+        uint32_t cnt = reg(0x024) & 0xFF;
+        timeout = cnt ? t + cnt * 16 * period() : SIM_NEVER;   //CNTL x 16 SCL periods, 0 hangs the bus
+        return;
+    }
+
+    uint64_t d = data ? 9 * period() : period();
+    busyCycles += d;
+    opEnd = t + d;
+}
+
+/**
+ * Complete the current bus operation and start the next one
+ */
+void SimI2C::finishOp(){
+    uint64_t t = opEnd;
+    uint8_t op = ops.front();
+    ops.pop_front();
+    opEnd = SIM_NEVER;
+
+    if(op != OP_START && op != OP_STOP){
+        if(arbLostAt >= 0 && byteCount == (uint32_t)arbLostAt){
+            arbLostAt = -1;
+            byteCount++;
+            abort(I2C_MCS_ERROR | I2C_MCS_ARBLST, t);
+            return;
+        }
+        byteCount++;
+    }
+
+    switch(op){
+        case OP_START:{
+            busHeld = true;
+            target = slaves[(reg(0x000) >> 1) & 0x7F];
+        }break;
+        case OP_ADDR:{
+            if(target == 0 || !target->start(reading)){
+                abort(I2C_MCS_ERROR | I2C_MCS_ADRACK, t);
+                return;
+            }
+        }break;
+        case OP_TX:{
+            uint8_t data;
+            if(burst){
+                data = txFifo.front();
+                txFifo.pop_front();
+                regAt(0x034).value--;
+                if(txFifo.size() <= (reg(0xF04) & 0x07)) ris |= I2C_RIS_TX;
+                if(txFifo.empty()) ris |= I2C_RIS_TXFE;
+            }else{
+                data = (uint8_t)reg(0x008);
+            }
+            if(!target->write(data)){
+                abort(I2C_MCS_ERROR | I2C_MCS_DATACK, t);
+                return;
+            }
+        }break;
+        case OP_RX: case OP_RX_ACK:{
+            uint8_t data = target->read(op == OP_RX_ACK);
+            if(burst){
+                rxFifo.push_back(data);
+                regAt(0x034).value--;
+                if(rxFifo.size() >= ((reg(0xF04) >> 16) & 0x07)) ris |= I2C_RIS_RX;
+                if(rxFifo.size() == I2C_FIFO_SIZE) ris |= I2C_RIS_RXFF;
+            }else{
+                regAt(0x008).value = data;
+            }
+        }break;
+        case OP_STOP:{
+            if(target) target->stop();
+            target = 0;
+            busHeld = false;
+        }break;
+    }
+    startOp(t);
+}
+
+/**
+ * End the command with an error
+ * NACK with STOP in the command: STOP is sent. NACK without STOP: the bus stays
+ * held until a STOP command. Arbitration lost: the bus is released
+ * @param bits are the MCS error bits
+ * @param t is the error time
+ */
+void SimI2C::abort(uint32_t bits, uint64_t t){
+    bool stop = false;
+    for(uint8_t op : ops) stop |= op == OP_STOP;
+    ops.clear();
+    status = bits;
+    if(bits & (I2C_MCS_ADRACK | I2C_MCS_DATACK)) ris |= I2C_RIS_NACK;
+
+    if(bits & I2C_MCS_ARBLST){
+        busHeld = false;
+        target = 0;
+        done();
+    }else if(stop){
+        ops.push_back(OP_STOP);
+        startOp(t);
+    }else{
+        errorHold = true;
+        done();
+    }
+}
+
+/**
+ * Rising SCL driven as a GPIO, a slave holding SDA shifts out one more bit
+ */
+void SimI2C::sclPulse(){
+    if(sdaStuck) sdaStuck--;
+}
+
+/**
+ * STOP driven as GPIOs: slaves and the bus go idle
+ */
+void SimI2C::busStop(){
+    if(target) target->stop();
+    target = 0;
+    ops.clear();
+    opEnd = SIM_NEVER;
+    timeout = SIM_NEVER;
+    stretched = false;
+    busHeld = false;
+    errorHold = false;
+}
+
+/**
+ * Command finished: master interrupt
+ */
+void SimI2C::done(){
+    opEnd = SIM_NEVER;
+    ris |= I2C_RIS_IM;
+}
+
+void SimI2C::advance(uint64_t now){
+    while(opEnd <= now){
+        finishOp();
+    }
+    if(timeout <= now){     //Slave held SCL low too long
+        timeout = SIM_NEVER;
+        stretched = false;
+        ops.clear();
+        status = I2C_MCS_ERROR | I2C_MCS_CLKTO;
+        ris |= I2C_RIS_CLK;
+        busHeld = false;
+        target = 0;
+        done();
+    }
+}
+
+uint64_t SimI2C::nextEvent(){
+    return opEnd < timeout ? opEnd : timeout;
+}
+
+bool SimI2C::irq(){
+    return (ris & reg(0x010)) != 0;
+}
+
+uint32_t SimI2C::read(uint32_t offset, SimReg& r){
+    switch(offset){
+        case 0x004:{    //MCS status
+            uint32_t mcs = status;
+            if(!ops.empty()) mcs |= I2C_MCS_BUSY;
+            if(ops.empty() && !busHeld) mcs |= I2C_MCS_IDLE;
+            if(busHeld || !ops.empty() || sdaStuck) mcs |= I2C_MCS_BUSBSY;
+            return mcs;
+        }
+        case 0x014: return ris;                 //MRIS
+        case 0x018: return ris & reg(0x010);    //MMIS
+        case 0x02C:{    //MBMON: SCL, SDA levels
+            uint32_t mbmon = (stretched ? 0x00 : 0x01) | (sdaStuck ? 0x00 : 0x02);
+            if(!ops.empty() && ops.front() == OP_STOP && opEnd != SIM_NEVER){
+                mbmon &= ~0x02;                                     //STOP going out: SDA low until its end
+                if(Sim::now() + period() / 2 < opEnd) mbmon &= ~0x01;   //and SCL low its first half
+            }
+            return mbmon;
+        }
+        case 0xF00:{    //FIFODATA
+            if(rxFifo.empty()) return 0;
+            uint8_t data = rxFifo.front();
+            rxFifo.pop_front();
+            if(rxFifo.size() < ((reg(0xF04) >> 16) & 0x07)) ris &= ~I2C_RIS_RX;
+            if(!ops.empty() && opEnd == SIM_NEVER && !stretched) startOp(Sim::now()); //RX stalled on full FIFO
+            return data;
+        }
+        case 0xF08:{    //FIFOSTATUS
+            uint32_t fs = 0;
+            if(txFifo.empty()) fs |= 0x00001;
+            if(txFifo.size() == I2C_FIFO_SIZE) fs |= 0x00002;
+            if(txFifo.size() <= (reg(0xF04) & 0x07)) fs |= 0x00004;
+            if(rxFifo.empty()) fs |= 0x10000;
+            if(rxFifo.size() == I2C_FIFO_SIZE) fs |= 0x20000;
+            if(rxFifo.size() >= ((reg(0xF04) >> 16) & 0x07)) fs |= 0x40000;
+            return fs;
+        }
+    }
+    return r.value;
+}
+
+void SimI2C::write(uint32_t offset, uint32_t v, SimReg& r){
+    switch(offset){
+        case 0x004: command((uint8_t)v); break;
+        case 0x014: case 0x018: break;          //Read only
+        case 0x01C: ris &= ~v; break;           //MICR
+        case 0xF00:{    //FIFODATA
+            if(txFifo.size() < I2C_FIFO_SIZE) txFifo.push_back((uint8_t)v);
+            if(!ops.empty() && opEnd == SIM_NEVER && !stretched) startOp(Sim::now()); //TX stalled on empty FIFO
+        }break;
+        case 0xF04:{    //FIFOCTL
+            if(v & 0x00004000) txFifo.clear();
+            if(v & 0x40000000) rxFifo.clear();
+            r.value = v & ~0x40004000U;
+        }break;
+        case 0xF08: break;
+        default: r.value = v; break;
+    }
+}
+
+
+SimI2CMemory::SimI2CMemory(){
+    for(uint16_t i = 0; i < 256; i++) mem[i] = 0;
+    pointer = 0;
+    nackAfter = -1;
+    first = false;
+    written = 0;
+}
+
+bool SimI2CMemory::start(bool read){
+    first = !read;
+    written = 0;
+    return true;
+}
+
+bool SimI2CMemory::write(uint8_t data){
+    if(first){
+        pointer = data;
+        first = false;
+        return true;
+    }
+    if(nackAfter >= 0 && written >= nackAfter) return false;
+    mem[pointer++] = data;
+    written++;
+    return true;
+}
+
+uint8_t SimI2CMemory::read(bool ack){
+    (void)ack;
+    return mem[pointer++];
+}
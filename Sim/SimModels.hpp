@@ -0,0 +1,289 @@
+/*
+ * SimModels.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_SIMMODELS_HPP_
+#define SIM_SIMMODELS_HPP_
+
+// Peripheral models of the host simulator (internal to Sim/*.cpp)
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <Sim/Sim.hpp>
+
+#define SIM_NEVER           0xFFFFFFFFFFFFFFFFULL
+
+#define SIM_PERIPH_BASE     0x40000000U
+#define SIM_PERIPH_SIZE     0x00100000U
+#define SIM_SYSCTL_BASE     0x400FE000U
+
+// SYSCTL RCGCx register offsets, clock gating of the models
+#define SIM_RCGC_TIMER      0x604
+#define SIM_RCGC_GPIO       0x608
+#define SIM_RCGC_DMA        0x60C
+#define SIM_RCGC_UART       0x618
+#define SIM_RCGC_SSI        0x61C
+#define SIM_RCGC_I2C        0x620
+
+/**
+ * Base of the peripheral models. Default behavior is a plain register
+ * block, optionally gated by a SYSCTL RCGCx bit
+ */
+class SimPeripheral{
+    public:
+        SimPeripheral(): base(0), gate(0), gateBit(0), irqN(-1){}
+        virtual ~SimPeripheral(){}
+
+        virtual uint32_t read(uint32_t offset, SimReg& r){ (void)offset; return r.value; }
+        virtual void write(uint32_t offset, uint32_t v, SimReg& r){ (void)offset; r.value = v; }
+        virtual void reset(){}
+        /**
+         * Process the model events up to now
+         * @param now is the virtual clock
+         */
+        virtual void advance(uint64_t now){ (void)now; }
+        /**
+         * @return time of the next model event (SIM_NEVER if none)
+         */
+        virtual uint64_t nextEvent(){ return SIM_NEVER; }
+        /**
+         * @return true while the model interrupt line is asserted
+         */
+        virtual bool irq(){ return false; }
+
+        bool clocked();
+
+        uint32_t base;      //Register block address
+        uint16_t gate;      //SYSCTL RCGCx offset, 0 if not gated
+        uint8_t gateBit;
+        int16_t irqN;       //NVIC interrupt number, -1 if none
+
+    protected:
+        SimReg& regAt(uint32_t offset){ return *Sim::reg(base + offset); }
+        uint32_t reg(uint32_t offset){ return regAt(offset).value; }    //Stored value, no model access
+};
+
+/**
+ * SYSCTL: PRx (peripheral ready) registers mirror RCGCx. MOSC power up, PLL
+ * lock and system clock switches (RSCLKCFG), a clock over 120 MHz or with less
+ * flash wait states (MEMTIM0) than it needs is counted as a fault
+ */
+class SimSysCtl:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+
+        uint32_t frequency;     //System clock
+
+    private:
+        uint8_t waitStates;     //Flash wait states in use (MEMTIM0 FWS, loaded by MEMTIMU)
+        uint32_t source(uint8_t);
+};
+
+/**
+ * uDMA: channel enable set/clear registers and bus errors (ERRCLR, error
+ * interrupt). No transfers are made, an enabled channel stays active until
+ * it is disabled, completed or a bus error is injected on it
+ */
+class SimUDMA:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override{ enabled = 0; error = false; }
+        bool irq() override{ return error; }
+
+        bool busError(uint8_t);
+        bool complete(uint8_t);
+
+        uint32_t enabled;       //ENASET channels
+
+    private:
+        bool error;             //Bus error pending (ERRCLR bit 0)
+};
+
+class SimI2C;
+class SimSSI;
+
+/**
+ * GPIO port: GPIODATA address masking and pin levels. Pins are pulled up, an
+ * output (DIR) drives its DATA bit, open-drain or not. I2C pins follow their
+ * module while AFSEL is set, a slave holding SDA low pulls the pin low in any
+ * mode. SCL pulses and STOPs driven as GPIOs (bus recovery) reach the module.
+ * SSI FSS pin edges select and deselect the SSI slave model
+ */
+class SimGPIO:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+
+        SimI2C* i2c[8];         //I2C module of each pin, 0 if none
+        uint8_t sclPins;        //I2C pins that are SCL, the others SDA
+        SimSSI* fss[8];         //SSI module whose slave is selected by the pin, 0 if none
+
+    private:
+        uint8_t data;
+        uint8_t levels;         //Pin levels after the last write
+
+        uint8_t pins();
+};
+
+/**
+ * General purpose timer: timer A as a 32-bit periodic or one shot, up or down
+ * counter, clocked by the system clock or PIOSC (CC ALTCLK), TAV, time-out and
+ * match interrupts (B, PWM, capture and RTC not modeled)
+ */
+class SimTimer:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+        void advance(uint64_t) override;
+        uint64_t nextEvent() override;
+        bool irq() override;
+
+    private:
+        uint32_t elapsed;       //Timer clocks since the period started (0 to TAILR)
+        double fraction;        //Timer clock fraction not counted yet (PIOSC clocked)
+        uint64_t last;          //Virtual clock of the last update
+        uint32_t ris;
+
+        bool running();
+        double rate();
+        uint64_t matchDistance();
+        void count(uint64_t);
+};
+
+/**
+ * UART: 16 byte (or 1 byte, FEN = 0) TX and RX FIFOs, FR flags, interrupt
+ * trigger levels, receive timeout, baud rate timing and loopback
+ */
+class SimUART:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+        void advance(uint64_t) override;
+        uint64_t nextEvent() override;
+        bool irq() override;
+
+        void inject(const char*, int);
+
+        std::string output;     //Bytes shifted out on TX
+        uint32_t statusReads;   //FR reads since reset (polls)
+
+    private:
+        std::deque<uint8_t> tx;
+        std::deque<uint16_t> rx;    //Data and error bits (DR format)
+        std::deque<uint8_t> wire;   //Injected bytes not received yet
+        uint8_t shifting;           //Byte in the TX shift register
+        uint64_t shiftEnd;          //TX shift register done, SIM_NEVER if idle
+        uint64_t arrival;           //Next injected byte received, SIM_NEVER if none
+        uint64_t rxTimeout;         //Receive timeout, SIM_NEVER if not armed
+        uint32_t ris;
+
+        uint8_t depth();
+        uint64_t charCycles();
+        void startShift(uint64_t);
+        void receive(uint16_t, uint64_t);
+};
+
+/**
+ * I2C master: MCS commands (byte and FIFO burst), status bits, interrupts,
+ * bus timing from MTPR and slave models. A burst is cut short by clearing
+ * MBLEN and writing a STOP command. MBMON shows SDA (and SCL in its first
+ * half) low while a STOP goes out
+ */
+class SimI2C:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+        void advance(uint64_t) override;
+        uint64_t nextEvent() override;
+        bool irq() override;
+
+        SimI2CSlave* slaves[128];
+        int32_t arbLostAt;      //Fault injection, byte index (-1 none)
+        int32_t stretchAt;
+        uint8_t sdaStuck;       //SCL pulses a slave needs to release SDA (0 released)
+        uint64_t busyCycles;    //Time the bus spent transferring
+        uint32_t byteCount;     //Address and data bytes since reset
+
+        void sclPulse();
+        void busStop();
+
+    private:
+        enum Op : uint8_t { OP_START, OP_ADDR, OP_TX, OP_RX, OP_RX_ACK, OP_STOP };
+
+        std::deque<uint8_t> ops;    //Pending operations of the current command
+        std::deque<uint8_t> txFifo;
+        std::deque<uint8_t> rxFifo;
+        uint64_t opEnd;             //Current operation done, SIM_NEVER if stalled or idle
+        uint64_t timeout;           //Clock low timeout, SIM_NEVER if none
+        bool stretched;             //Slave holding SCL low
+        bool burst;
+        bool busHeld;
+        bool errorHold;             //Error with bus held, waiting for STOP
+        bool reading;
+        SimI2CSlave* target;
+        uint32_t status;            //MCS error bits
+        uint32_t ris;
+
+        uint64_t period();
+        void command(uint8_t);
+        void startOp(uint64_t);
+        void finishOp();
+        void abort(uint32_t, uint64_t);
+        void done();
+        void cutBurst();
+};
+
+/**
+ * SSI: Freescale SPI master, 8 frame TX and RX FIFOs, SR flags, interrupts
+ * (FIFO levels, overrun, end of transmission), bit rate timing from CPSR and
+ * CR0 SCR, bi and quad modes (CR1 MODE: frame time / lanes, CR1 DIR: send
+ * frames fill no RX FIFO), loopback and a slave model (uDMA requests not modeled)
+ */
+class SimSSI:public SimPeripheral{
+    public:
+        uint32_t read(uint32_t, SimReg&) override;
+        void write(uint32_t, uint32_t, SimReg&) override;
+        void reset() override;
+        void advance(uint64_t) override;
+        uint64_t nextEvent() override;
+        bool irq() override;
+
+        void chipSelect(bool);
+
+        SimSPISlave* slave;
+        bool selected;          //FSS pin low
+        uint32_t frames;        //Frames shifted since reset
+        uint64_t busyCycles;    //Time the bus spent transferring
+
+    private:
+        std::deque<uint16_t> tx;
+        std::deque<uint16_t> rx;
+        uint16_t shifting;      //Frame received by the one in the shift register
+        bool keep;              //shifting goes to the RX FIFO (not a bi or quad send frame)
+        uint64_t shiftEnd;      //Shift register done, SIM_NEVER if idle
+        uint32_t ris;           //ROR and RT bits, FIFO levels are computed
+
+        uint8_t bits();
+        uint8_t lanes();
+        uint64_t frameCycles();
+        void startShift(uint64_t);
+        uint32_t status();
+};
+
+extern void simRegister(SimPeripheral*, uint32_t base, uint32_t size);
+extern void simFault(uint32_t address);
+
+
+#endif /* SIM_SIMMODELS_HPP_ */
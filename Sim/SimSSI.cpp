@@ -0,0 +1,279 @@
+/*
+ * SimSSI.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Sim/SimModels.hpp>
+#include <Peripherals/Board.hpp>
+
+#define SSI_CR1_LBM     0x01
+#define SSI_CR1_SSE     0x02
+#define SSI_CR1_EOT     0x10
+#define SSI_CR1_MODE_M  0xC0    //Legacy, bi, quad, advanced
+#define SSI_CR1_DIR     0x100   //Bi and quad modes: receive
+
+#define SSI_RIS_ROR     0x01    //Receive overrun
+#define SSI_RIS_RX      0x04    //RX FIFO half full or more
+#define SSI_RIS_TX      0x08    //TX FIFO half empty or less (end of transmission with EOT)
+
+#define SSI_FIFO_DEPTH  8
+
+/**
+ * Power on state: FIFOs empty, SSI disabled, chip select deasserted
+ */
+void SimSSI::reset(){
+    tx.clear();
+    rx.clear();
+    shiftEnd = SIM_NEVER;
+    keep = true;
+    ris = 0;
+    selected = false;
+    frames = 0;
+    busyCycles = 0;
+}
+
+/**
+ * @return frame size (CR0 DSS + 1)
+ */
+uint8_t SimSSI::bits(){
+    return (reg(0x000) & 0x0F) + 1;
+}
+
+/**
+ * @return data lanes of CR1 MODE: 2 bi-SSI, 4 quad-SSI, else 1
+ */
+uint8_t SimSSI::lanes(){
+    uint32_t mode = reg(0x004) & SSI_CR1_MODE_M;
+    return mode == 0x40 ? 2 : (mode == 0x80 ? 4 : 1);
+}
+
+/**
+ * @return CPU cycles per frame, CPSDVSR x (1 + SCR) per clock, bits / lanes clocks
+ */
+uint64_t SimSSI::frameCycles(){
+    uint64_t cps = reg(0x010) & 0xFF;
+    uint64_t cycles = bits() * (cps ? cps : 1) * (((reg(0x000) >> 8) & 0xFF) + 1) / lanes();
+    return cycles;
+}
+
+/**
+ * Move the next TX FIFO frame to the shift register, the selected slave (or
+ * the loopback) answers it. Advanced mode send frames (CR1 MODE set, DIR
+ * clear) aren't kept in the RX FIFO
+ * @param t is the start time
+ */
+void SimSSI::startShift(uint64_t t){
+    if(shiftEnd != SIM_NEVER || tx.empty() || (reg(0x004) & SSI_CR1_SSE) == 0) return;
+
+    uint16_t mask = (uint16_t)((1 << bits()) - 1);
+    uint16_t mosi = tx.front();
+    tx.pop_front();
+    uint32_t cr1 = reg(0x004);
+    if(cr1 & SSI_CR1_LBM) shifting = mosi;
+    else if(slave != 0 && selected) shifting = slave->exchange(mosi, bits(), lanes()) & mask;
+    else shifting = mask;   //MISO pulled up
+    keep = (cr1 & SSI_CR1_MODE_M) == 0 || (cr1 & SSI_CR1_DIR) != 0;
+    frames++;
+    uint64_t cycles = frameCycles();
+    busyCycles += cycles;
+    shiftEnd = t + cycles;
+}
+
+/**
+ * FSS pin level change
+ * @param low is true when the pin is driven low (slave selected)
+ */
+void SimSSI::chipSelect(bool low){
+    if(low == selected) return;
+    selected = low;
+    if(slave == 0) return;
+    if(low) slave->select();
+    else slave->deselect();
+}
+
+void SimSSI::advance(uint64_t now){
+    while(shiftEnd <= now){
+        uint64_t t = shiftEnd;
+        shiftEnd = SIM_NEVER;
+        if(keep){
+            if(rx.size() < SSI_FIFO_DEPTH) rx.push_back(shifting);
+            else ris |= SSI_RIS_ROR;
+        }
+        startShift(t);
+    }
+}
+
+uint64_t SimSSI::nextEvent(){
+    return shiftEnd;
+}
+
+/**
+ * @return raw interrupt status, FIFO level bits from the current levels
+ */
+uint32_t SimSSI::status(){
+    uint32_t s = ris;
+    if(rx.size() >= SSI_FIFO_DEPTH / 2) s |= SSI_RIS_RX;
+    if(reg(0x004) & SSI_CR1_EOT){
+        if(tx.empty() && shiftEnd == SIM_NEVER) s |= SSI_RIS_TX;
+    }else if(tx.size() <= SSI_FIFO_DEPTH / 2){
+        s |= SSI_RIS_TX;
+    }
+    return s;
+}
+
+bool SimSSI::irq(){
+    return (status() & reg(0x014)) != 0;
+}
+
+uint32_t SimSSI::read(uint32_t offset, SimReg& r){
+    switch(offset){
+        case 0x008:{    //DR
+            if(rx.empty()) return 0;
+            uint16_t data = rx.front();
+            rx.pop_front();
+            return data;
+        }
+        case 0x00C:{    //SR
+            uint32_t sr = 0;
+            if(tx.empty()) sr |= 0x01;                              //TFE
+            if(tx.size() < SSI_FIFO_DEPTH) sr |= 0x02;              //TNF
+            if(!rx.empty()) sr |= 0x04;                             //RNE
+            if(rx.size() >= SSI_FIFO_DEPTH) sr |= 0x08;             //RFF
+            if(shiftEnd != SIM_NEVER || !tx.empty()) sr |= 0x10;    //BSY
+            return sr;
+        }
+        case 0x018: return status();
+        case 0x01C: return status() & reg(0x014);
+    }
+    return r.value;
+}
+
+void SimSSI::write(uint32_t offset, uint32_t v, SimReg& r){
+    switch(offset){
+        case 0x008:{    //DR
+            if(tx.size() < SSI_FIFO_DEPTH) tx.push_back((uint16_t)(v & ((1 << bits()) - 1)));  //Frame lost if FIFO full
+            startShift(Sim::now());
+        }break;
+        case 0x004:{    //CR1
+            r.value = v;
+            uint32_t cps = reg(0x010);
+            if((v & SSI_CR1_SSE) && (cps < 2 || cps > 254 || (cps & 0x01))){
+                simFault(base + 0x010);     //Invalid prescaler
+            }
+            if((v & SSI_CR1_SSE) && (v & SSI_CR1_MODE_M) && bits() != 8){
+                simFault(base + 0x004);     //Advanced modes move 8-bit frames only
+            }
+            startShift(Sim::now());
+        }break;
+        case 0x00C: break;
+        case 0x018: break;
+        case 0x01C: break;
+        case 0x020: ris &= ~v; break;   //ICR
+        default: r.value = v; break;
+    }
+}
+
+#define FLASH_WREN      0x06
+#define FLASH_WRDI      0x04
+#define FLASH_RDSR      0x05
+#define FLASH_RDID      0x9F
+#define FLASH_READ      0x03
+#define FLASH_FAST_READ 0x0B
+#define FLASH_DUAL_READ 0x3B
+#define FLASH_QUAD_READ 0x6B
+#define FLASH_PP        0x02
+#define FLASH_QPP       0x32
+#define FLASH_SE        0x20
+
+SimSPIFlash::SimSPIFlash(){
+    for(uint32_t i = 0; i < SIM_FLASH_SIZE; i++) mem[i] = 0xFF;
+    jedecId = 0xEF4016;     //Winbond W25Q32 style
+    busyPolls = 2;
+    laneErrors = 0;
+    cmd = 0;
+    count = 0;
+    address = 0;
+    dummyClocks = 0;
+    wel = false;
+    written = false;
+    busy = 0;
+}
+
+void SimSPIFlash::select(){
+    count = 0;
+    address = 0;
+    dummyClocks = 0;
+    written = false;
+}
+
+/**
+ * Command frame, 3 address frames, the dummy clocks of the fast reads, then
+ * data frames. Only status reads are answered while a write is in progress
+ */
+uint16_t SimSPIFlash::exchange(uint16_t mosi, uint8_t bits, uint8_t lanes){
+    (void)bits;
+    uint32_t n = count++;
+    if(n == 0){
+        cmd = (uint8_t)mosi;
+        if(lanes != 1) laneErrors++;
+        if(busy != 0 && cmd != FLASH_RDSR) cmd = 0;    //Ignored
+        else if(cmd == FLASH_WREN) wel = true;
+        else if(cmd == FLASH_WRDI) wel = false;
+        return 0xFF;
+    }
+    switch(cmd){
+        case FLASH_RDSR:{
+            uint8_t sr = (busy != 0 ? 0x01 : 0x00) | (wel ? 0x02 : 0x00);
+            if(busy != 0) busy--;
+            return sr;
+        }
+        case FLASH_RDID:
+            return n <= 3 ? (uint8_t)(jedecId >> (8 * (3 - n))) : 0xFF;
+        case FLASH_READ: case FLASH_FAST_READ: case FLASH_DUAL_READ: case FLASH_QUAD_READ:
+        case FLASH_PP: case FLASH_QPP: case FLASH_SE:
+            break;
+        default:
+            return 0xFF;
+    }
+
+    if(n <= 3){     //Address, most significant byte first
+        if(lanes != 1) laneErrors++;
+        address = (address << 8) | (uint8_t)mosi;
+        return 0xFF;
+    }
+    bool fast = cmd == FLASH_FAST_READ || cmd == FLASH_DUAL_READ || cmd == FLASH_QUAD_READ;
+    if(fast && dummyClocks < 8){
+        dummyClocks += 8 / lanes;
+        return 0xFF;
+    }
+    uint8_t dataLanes = cmd == FLASH_DUAL_READ ? 2 : ((cmd == FLASH_QUAD_READ || cmd == FLASH_QPP) ? 4 : 1);
+    if(lanes != dataLanes) laneErrors++;
+    if(cmd == FLASH_SE) return 0xFF;
+    if(cmd == FLASH_PP || cmd == FLASH_QPP){
+        if(wel){
+            mem[address % SIM_FLASH_SIZE] &= (uint8_t)mosi;    //Programs 1 bits to 0
+            written = true;
+        }
+        address = (address & ~0xFFu) | ((address + 1) & 0xFFu);   //Wraps within the page
+        return 0xFF;
+    }
+    return mem[address++ % SIM_FLASH_SIZE];
+}
+
+/**
+ * A program or erase command ends at deselect: WIP set for busyPolls status reads
+ */
+void SimSPIFlash::deselect(){
+    if(count >= 4 && wel && cmd == FLASH_SE){
+        uint32_t sector = (address & ~0xFFFu) % SIM_FLASH_SIZE;
+        for(uint32_t i = 0; i < 4096; i++) mem[(sector + i) % SIM_FLASH_SIZE] = 0xFF;
+        written = true;
+    }
+    if(written){
+        wel = false;
+        busy = busyPolls;
+    }
+}
@@ -0,0 +1,182 @@
+/*
+ * SimUART.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Sim/SimModels.hpp>
+#include <Peripherals/Board.hpp>
+
+#define UART_RIS_RX     0x010
+#define UART_RIS_TX     0x020
+#define UART_RIS_RT     0x040
+#define UART_RIS_OE     0x400
+
+#define UART_CTL_EN     0x001
+#define UART_CTL_LBE    0x080
+#define UART_CTL_TXE    0x100
+#define UART_CTL_RXE    0x200
+
+static const uint8_t FIFO_LEVEL[] = {2, 4, 8, 12, 14, 14, 14, 14}; //IFLS 1/8 to 7/8 of 16 bytes
+
+/**
+ * Power on state: FIFOs empty, UART disabled
+ */
+void SimUART::reset(){
+    tx.clear();
+    rx.clear();
+    wire.clear();
+    output.clear();
+    statusReads = 0;
+    shiftEnd = SIM_NEVER;
+    arrival = SIM_NEVER;
+    rxTimeout = SIM_NEVER;
+    ris = 0;
+    regAt(0x030).value = 0x300; //CTL: TXE, RXE
+    regAt(0x034).value = 0x012; //IFLS: 1/2, 1/2
+}
+
+/**
+ * @return FIFO depth, 1 if FIFOs disabled (LCRH FEN = 0)
+ */
+uint8_t SimUART::depth(){
+    return (reg(0x02C) & 0x10) ? 16 : 1;
+}
+
+/**
+ * @return CPU cycles per frame (start, data, parity and stop bits)
+ */
+uint64_t SimUART::charCycles(){
+    uint32_t lcrh = reg(0x02C);
+    uint32_t bits = 1 + (5 + ((lcrh >> 5) & 0x03)) + ((lcrh & 0x02) ? 1 : 0) + ((lcrh & 0x08) ? 2 : 1);
+    double divisor = reg(0x024) + reg(0x028) / 64.0;
+    double sysClock = Sim::systemClock();
+    double uartClock = (reg(0xFC8) & 0x0F) == 0x05 ? CPU_PIOSC_FREQUENCY : sysClock;
+    double cycles = bits * ((reg(0x030) & 0x20) ? 8 : 16) * divisor * sysClock / uartClock;
+    return cycles < 1 ? 1 : (uint64_t)(cycles + 0.5);
+}
+
+/**
+ * Move the next TX FIFO byte to the shift register
+ * @param t is the start time
+ */
+void SimUART::startShift(uint64_t t){
+    if(shiftEnd != SIM_NEVER || tx.empty()) return;
+    if((reg(0x030) & (UART_CTL_EN | UART_CTL_TXE)) != (UART_CTL_EN | UART_CTL_TXE)) return;
+
+    shifting = tx.front();
+    output.push_back((char)shifting);
+    tx.pop_front();
+    shiftEnd = t + charCycles();
+
+    uint8_t trigger = depth() == 1 ? 0 : FIFO_LEVEL[reg(0x034) & 0x07];
+    if(tx.size() == trigger) ris |= UART_RIS_TX;    //FIFO level went through the trigger level
+}
+
+/**
+ * Store a received frame in the RX FIFO
+ * @param data is the data and error bits (DR format)
+ * @param t is the reception time
+ */
+void SimUART::receive(uint16_t data, uint64_t t){
+    if(rx.size() < depth()){
+        rx.push_back(data);
+        uint8_t trigger = depth() == 1 ? 1 : FIFO_LEVEL[(reg(0x034) >> 3) & 0x07];
+        if(rx.size() == trigger) ris |= UART_RIS_RX;
+    }else{
+        rx.back() |= 0x800; //Overrun
+        ris |= UART_RIS_OE;
+    }
+    rxTimeout = t + charCycles() * 32 / 10; //32 bit periods without frames
+}
+
+/**
+ * Queue bytes on the RX line, received one frame time apart
+ * @param data are the bytes
+ * @param n is the quantity of bytes (n < 0, until '\0')
+ */
+void SimUART::inject(const char* data, int n){
+    for(int i = 0; n < 0 ? data[i] != '\0' : i < n; i++){
+        wire.push_back((uint8_t)data[i]);
+    }
+    if(arrival == SIM_NEVER && !wire.empty()) arrival = Sim::now() + charCycles();
+}
+
+void SimUART::advance(uint64_t now){
+    while(shiftEnd <= now){
+        uint64_t t = shiftEnd;
+        shiftEnd = SIM_NEVER;
+        if(reg(0x030) & UART_CTL_LBE) receive(shifting, t);
+        startShift(t);
+    }
+    while(arrival <= now){
+        uint64_t t = arrival;
+        uint32_t ctl = reg(0x030);
+        if((ctl & (UART_CTL_EN | UART_CTL_RXE)) == (UART_CTL_EN | UART_CTL_RXE) && (ctl & UART_CTL_LBE) == 0){
+            receive(wire.front(), t);
+        }
+        wire.pop_front();
+        arrival = wire.empty() ? SIM_NEVER : t + charCycles();
+    }
+    if(rxTimeout <= now){
+        if(!rx.empty()) ris |= UART_RIS_RT;
+        rxTimeout = SIM_NEVER;
+    }
+}
+
+uint64_t SimUART::nextEvent(){
+    uint64_t next = shiftEnd;
+    if(arrival < next) next = arrival;
+    if(rxTimeout < next) next = rxTimeout;
+    return next;
+}
+
+bool SimUART::irq(){
+    return (ris & reg(0x038)) != 0;
+}
+
+uint32_t SimUART::read(uint32_t offset, SimReg& r){
+    switch(offset){
+        case 0x000:{    //DR
+            if(rx.empty()) return 0;
+            uint16_t data = rx.front();
+            rx.pop_front();
+            uint8_t trigger = depth() == 1 ? 1 : FIFO_LEVEL[(reg(0x034) >> 3) & 0x07];
+            if(rx.size() < trigger) ris &= ~UART_RIS_RX;
+            if(rx.empty()) ris &= ~UART_RIS_RT;
+            return data;
+        }
+        case 0x004: return 0;   //RSR, errors are reported in DR
+        case 0x018:{    //FR
+            uint32_t fr = 0;
+            statusReads++;
+            if(shiftEnd != SIM_NEVER || !tx.empty()) fr |= 0x08;    //BUSY
+            if(rx.empty()) fr |= 0x10;                              //RXFE
+            if(tx.size() >= depth()) fr |= 0x20;                    //TXFF
+            if(rx.size() >= depth()) fr |= 0x40;                    //RXFF
+            if(tx.empty()) fr |= 0x80;                              //TXFE
+            return fr;
+        }
+        case 0x03C: return ris;
+        case 0x040: return ris & reg(0x038);
+    }
+    return r.value;
+}
+
+void SimUART::write(uint32_t offset, uint32_t v, SimReg& r){
+    switch(offset){
+        case 0x000:{    //DR
+            if(tx.size() < depth()) tx.push_back((uint8_t)v);   //Byte lost if FIFO full
+            startShift(Sim::now());
+        }break;
+        case 0x004: break;
+        case 0x030:{    //CTL
+            r.value = v;
+            startShift(Sim::now());
+        }break;
+        case 0x044: ris &= ~v; break;   //ICR
+        default: r.value = v; break;
+    }
+}
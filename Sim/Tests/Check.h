@@ -0,0 +1,44 @@
+/*
+ * Check.h
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_TESTS_CHECK_H_
+#define SIM_TESTS_CHECK_H_
+
+// Host tests, one program per file, each one exits with 0 when every CHECK passed.
+// C++ tests run the drivers on the register simulator (see Sim/Sim.hpp):
+//
+//   gcc -std=c99 -DTIVA_SIM -I. -c Util/Format.c
+//   g++ -std=c++14 -DTIVA_SIM -I. -ISim -ISim/driverlib -o test Sim/Tests/TestXxx.cpp
+//       Sim/*.cpp Peripherals/*.cpp Util/*.cpp Format.o
+//
+// TestFormat.c is plain C, built alone with Util/Format.c (see the file).
+// A failed CHECK prints its file, line and condition, and the test goes on.
+
+#include <stdio.h>
+
+static int checkFailures = 0;
+
+#define CHECK(cond)     do{ \
+                            if(!(cond)){ \
+                                checkFailures++; \
+                                printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+                            } \
+                        }while(0)
+
+/**
+ * Print the test summary
+ * @param name is the test name
+ * @return the program exit code, 0 if every check passed
+ */
+static inline int checkResult(const char* name){
+    printf("%s: %s (%d failed checks)\n", name, checkFailures == 0 ? "PASS" : "FAIL", checkFailures);
+    return checkFailures == 0 ? 0 : 1;
+}
+
+
+#endif /* SIM_TESTS_CHECK_H_ */
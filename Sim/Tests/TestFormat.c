@@ -0,0 +1,186 @@
+/*
+ * TestFormat.c
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// Util/Format correctness against the C library, and timing against sprintf.
+// Plain C, no simulator:
+//
+//   gcc -std=c99 -O2 -I. -o test_format Sim/Tests/TestFormat.c Util/Format.c
+//
+// - formatUnsigned against "%u", and with a '-' sign (as Print does for %d) against
+//   "%d": every value within 10^6 of 0, of INT32_MIN, INT32_MAX, UINT32_MAX and of
+//   every power of 10, and the whole range with a 7919 stride (about 540000 values)
+// - formatFloat against "%.*f", precisions 0 - 9: random bit patterns of the
+//   floats below 2^32, plus halfway (rounding) cases
+// - ns per call of formatUnsigned and formatFloat against sprintf "%u" and "%.4f"
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <Sim/Tests/Check.h>
+#include <Util/Format.h>
+
+#define NEAR_RANGE      1000000     //Values checked on each side of the edges
+#define RANGE_STRIDE    7919U       //Sampling step over the 32-bit range
+#define FLOAT_SAMPLES   2000000
+#define TIMING_CALLS    2000000
+
+static uint32_t mismatches = 0;
+static uint32_t checked = 0;
+
+static uint32_t seed = 0x12345678;
+static uint32_t random32(void){  //xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/**
+ * Check a value as unsigned ("%u") and as signed ("%d")
+ * @param u is the 32-bit value
+ */
+static void checkInteger(uint32_t u){
+    char out[FORMAT_UINT32_MAX_LEN + 1];
+    char ref[16];
+    uint8_t n = formatUnsigned(u, out);
+    snprintf(ref, sizeof(ref), "%u", (unsigned int)u);
+    if(n != strlen(ref) || strcmp(out, ref) != 0){
+        if(mismatches++ < 10) printf("formatUnsigned(%u) = \"%s\"\n", (unsigned int)u, out);
+    }
+
+    int32_t i = (int32_t)u;
+    char* p = out;
+    if(i < 0) *(p++) = '-';
+    formatUnsigned(i < 0 ? 0U - u : u, p);
+    snprintf(ref, sizeof(ref), "%d", (int)i);
+    if(strcmp(out, ref) != 0){
+        if(mismatches++ < 10) printf("signed %d = \"%s\"\n", (int)i, out);
+    }
+    checked++;
+}
+
+/**
+ * Check the values around a center
+ * @param center is the middle of the range, wraps around the 32-bit range
+ */
+static void checkNear(uint32_t center){
+    for(uint32_t d = 0; d <= NEAR_RANGE; d++){
+        checkInteger(center + d);
+        if(d) checkInteger(center - d);
+    }
+}
+
+static void testIntegers(void){
+    checkNear(0);
+    checkNear(0x80000000U);     //INT32_MIN
+    checkNear(0x7FFFFFFFU);     //INT32_MAX
+    checkNear(0xFFFFFFFFU);     //UINT32_MAX
+    for(uint32_t p = 10; p <= 1000000000U; p *= 10){
+        checkNear(p);
+        if(p == 1000000000U) break;
+    }
+    uint32_t u = 0;
+    do{
+        checkInteger(u);
+        u += RANGE_STRIDE;
+    }while(u >= RANGE_STRIDE);  //Until it wraps
+    CHECK(mismatches == 0);
+    printf("integers: %u values, %u mismatches\n", (unsigned int)checked, (unsigned int)mismatches);
+}
+
+/**
+ * Check a float at every precision
+ * @param f is the value, below 2^32 in magnitude
+ */
+static void checkFloat(float f){
+    char out[FORMAT_FLOAT_MAX_LEN];
+    char ref[64];
+    for(uint8_t precision = 0; precision <= FORMAT_FLOAT_MAX_PRECISION; precision++){
+        uint8_t n = formatFloat(f, precision, out, sizeof(out));
+        snprintf(ref, sizeof(ref), "%.*f", precision, (double)f);
+        if(n != strlen(ref) || strcmp(out, ref) != 0){
+            if(mismatches++ < 10) printf("formatFloat(%.9g, %u) = \"%s\", expected \"%s\"\n", (double)f, precision, out, ref);
+        }
+    }
+    checked++;
+}
+
+static void testFloats(void){
+    union{float f; uint32_t u;} bits;
+    char out[FORMAT_FLOAT_MAX_LEN];
+    mismatches = 0;
+    checked = 0;
+
+    for(uint32_t i = 0; i < FLOAT_SAMPLES; i++){
+        bits.u = random32();
+        if(((bits.u >> 23) & 0xFF) >= 150 + 9) continue; //NaN, inf and >= 2^32, not printf comparable
+        checkFloat(bits.f);
+    }
+    for(int32_t i = -20000; i <= 20000; i++){   //Halfway cases: k / 2^n
+        checkFloat(i / 8.0f);
+        checkFloat(i / 1024.0f);
+    }
+    checkFloat(0.0f);
+    checkFloat(-0.0f);
+    checkFloat(4294967040.0f);  //Largest float below 2^32
+    CHECK(mismatches == 0);
+    printf("floats: %u values x %u precisions, %u mismatches\n", (unsigned int)checked,
+           FORMAT_FLOAT_MAX_PRECISION + 1, (unsigned int)mismatches);
+
+    formatFloat(4294967296.0f, 2, out, sizeof(out));
+    CHECK(strcmp(out, "ovf") == 0);
+    formatFloat(-1e20f, 2, out, sizeof(out));
+    CHECK(strcmp(out, "-ovf") == 0);
+    bits.u = 0x7F800000;
+    formatFloat(bits.f, 2, out, sizeof(out));
+    CHECK(strcmp(out, "inf") == 0);
+    bits.u = 0x7FC00000;
+    formatFloat(bits.f, 2, out, sizeof(out));
+    CHECK(strcmp(out, "nan") == 0);
+    CHECK(formatFloat(123.5f, 2, out, 6) == 0 && out[0] == '\0');   //"123.50" doesn't fit
+    CHECK(formatFloat(123.5f, 2, out, 7) == 6 && strcmp(out, "123.50") == 0);
+}
+
+/**
+ * @param start is the clock() at the start of the run
+ * @return ns per call of a TIMING_CALLS run
+ */
+static double nsPerCall(clock_t start){
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / TIMING_CALLS;
+}
+
+static void timing(void){
+    static char out[FORMAT_FLOAT_MAX_LEN + 16];
+    volatile uint32_t sink = 0;
+    clock_t start;
+
+    start = clock();
+    for(uint32_t i = 0; i < TIMING_CALLS; i++) sink += formatUnsigned(i * 2654435761U, out);
+    double fmtUnsigned = nsPerCall(start);
+    start = clock();
+    for(uint32_t i = 0; i < TIMING_CALLS; i++) sink += sprintf(out, "%u", (unsigned int)(i * 2654435761U));
+    double sprintfUnsigned = nsPerCall(start);
+
+    start = clock();
+    for(uint32_t i = 0; i < TIMING_CALLS; i++) sink += formatFloat((float)i * 0.37f, 4, out, sizeof(out));
+    double fmtFloat = nsPerCall(start);
+    start = clock();
+    for(uint32_t i = 0; i < TIMING_CALLS; i++) sink += sprintf(out, "%.4f", (double)((float)i * 0.37f));
+    double sprintfFloat = nsPerCall(start);
+
+    printf("ns per call (host): formatUnsigned %.1f, sprintf %%u %.1f; formatFloat %.1f, sprintf %%.4f %.1f\n",
+           fmtUnsigned, sprintfUnsigned, fmtFloat, sprintfFloat);
+    (void)sink;
+}
+
+int main(void){
+    testIntegers();
+    testFloats();
+    timing();
+    return checkResult("TestFormat");
+}
@@ -0,0 +1,217 @@
+/*
+ * TestI2C.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// I2CMaster transaction queue on the simulated I2C0 with register memory slaves:
+// address NACKs without bus recovery, held bus continuations (NO_STOP then
+// NO_START), canceling a transaction in the middle of a FIFO burst, starting
+// the next transaction after the STOP of a failed one (and closing the bus
+// meanwhile), and the transactions of the MPU-6050 register map sample
+// (I2CDevice readAll: one burst, against a read per register).
+
+#ifdef TIVA_SIM
+
+#include <string.h>
+#include <Sim/Tests/Check.h>
+#include <Peripherals/I2CMaster.hpp>
+#include <Peripherals/I2CDeviceMaps.hpp>
+
+#define TEST_ADDRESS    0x50    //Memory slave
+#define TEST_MISSING    0x51    //Nobody answers
+#define TEST_SPEED      100000
+
+static SimI2CMemory memory;
+static SimI2CMemory imu;
+
+/**
+ * @param address is the 7-bit slave address
+ * @param flags are the I2C_TRXN_xx flags
+ * @param tx is the data, the first byte selects the memory register
+ * @param len is the quantity of bytes
+ * @return a NORMAL priority write descriptor
+ */
+static I2CTransaction writeTrxn(uint8_t address, uint8_t flags, const uint8_t* tx, uint16_t len){
+    I2CTransaction t = {address, flags, 0, I2C_PRIORITY_NORMAL, tx, len, 0, 0, 0, 0, I2C_BUSY, 0};
+    return t;
+}
+
+static void waitEnd(I2CTransaction& t){
+    while(t.status == I2C_BUSY) Sim::idle();
+}
+
+/**
+ * A NO_START transaction is refused when no NO_STOP one holds (or will hold) the bus
+ */
+static void testNoStartRejected(I2CMaster& bus){
+    static const uint8_t data[] = {0x10, 0xAA, 0xBB};
+    I2CTransaction t = writeTrxn(TEST_ADDRESS, I2C_TRXN_NO_START, data, sizeof(data));
+    uint64_t busy = Sim::i2cBusyCycles(I2C_I2C0);
+    CHECK(bus.submit(&t) == I2C_WRITE_ERROR);
+    CHECK(bus.transfer(&t) == I2C_WRITE_ERROR);
+    CHECK(Sim::i2cBusyCycles(I2C_I2C0) == busy);    //Nothing sent
+    CHECK(memory.mem[0x10] == 0);
+}
+
+/**
+ * A plain address NACK (EEPROM ACK polling) isn't a stuck bus: the lines are
+ * low only while its STOP goes out, no recovery is made
+ */
+static void testNackNoRecovery(I2CMaster& bus){
+    static const uint8_t data[] = {0x50, 0x01};
+    I2CTransaction t = writeTrxn(TEST_MISSING, I2C_TRXN_NO_BURST, data, sizeof(data));
+    CHECK(bus.transfer(&t) == I2C_ADDR_NACK);      //STOP written by the interrupt
+    t = writeTrxn(TEST_MISSING, 0, data, sizeof(data));
+    CHECK(bus.transfer(&t) == I2C_ADDR_NACK);      //STOP of the burst command
+    CHECK(bus.queueStats().recoveries == 0);
+}
+
+/**
+ * A NO_START transaction queued behind its NO_STOP one continues it, and
+ * fails without touching the bus when the NO_STOP one failed
+ */
+static void testHeldBus(I2CMaster& bus){
+    static const uint8_t head[] = {0x20, 0x01, 0x02};
+    static const uint8_t tail[] = {0x03, 0x04};
+    I2CTransaction t1 = writeTrxn(TEST_ADDRESS, I2C_TRXN_NO_STOP, head, sizeof(head));
+    I2CTransaction t2 = writeTrxn(TEST_ADDRESS, I2C_TRXN_NO_START, tail, sizeof(tail));
+    CHECK(bus.submit(&t1) == I2C_WRITE_OK);
+    CHECK(bus.submit(&t2) == I2C_WRITE_OK);
+    waitEnd(t2);
+    CHECK(t1.status == I2C_WRITE_OK && t2.status == I2C_WRITE_OK);
+    CHECK(memcmp(&memory.mem[0x20], "\x01\x02\x03\x04", 4) == 0);
+
+    t1 = writeTrxn(TEST_MISSING, I2C_TRXN_NO_STOP, head, sizeof(head));
+    t2 = writeTrxn(TEST_ADDRESS, I2C_TRXN_NO_START, tail, sizeof(tail));
+    memory.mem[0x20] = 0;
+    CHECK(bus.submit(&t1) == I2C_WRITE_OK);
+    CHECK(bus.submit(&t2) == I2C_WRITE_OK);
+    waitEnd(t2);
+    CHECK(t1.status == I2C_ADDR_NACK);
+    CHECK(t2.status == I2C_WRITE_ERROR);
+    CHECK(memory.mem[0x20] == 0);
+
+    I2CTransaction t3 = writeTrxn(TEST_ADDRESS, 0, head, sizeof(head));
+    CHECK(bus.transfer(&t3) == I2C_WRITE_OK);       //Bus free again
+    CHECK(memory.mem[0x20] == 0x01);
+}
+
+/**
+ * A transaction canceled during a TX burst stops the burst, the next one
+ * starts with its own START and writes its bytes only
+ */
+static void testCancelBurst(I2CMaster& bus){
+    static uint8_t data[65];
+    data[0] = 0x40;
+    for(uint8_t i = 1; i < sizeof(data); i++) data[i] = i;
+    memset(&memory.mem[0x40], 0, 64);
+
+    I2CTransaction t1 = writeTrxn(TEST_ADDRESS, 0, data, sizeof(data));
+    CHECK(bus.submit(&t1) == I2C_WRITE_OK);
+    Sim::advance(Sim::systemClock() / TEST_SPEED * 9 * 20);     //About 20 bytes
+    CHECK(t1.status == I2C_BUSY);
+    CHECK(bus.cancel(&t1));
+    CHECK(t1.status == I2C_DEADLINE);
+
+    static const uint8_t next[] = {0x90, 0x5A, 0xA5};
+    I2CTransaction t2 = writeTrxn(TEST_ADDRESS, 0, next, sizeof(next));
+    CHECK(bus.transfer(&t2) == I2C_WRITE_OK);
+    CHECK(memory.mem[0x90] == 0x5A && memory.mem[0x91] == 0xA5);
+
+    uint8_t written = 0;
+    while(written < 64 && memory.mem[0x40 + written] == written + 1) written++;
+    CHECK(written > 0 && written < 64);             //Cut short
+    CHECK(memory.mem[0x40 + written] == 0);         //No byte of the next transaction in the burst
+}
+
+/**
+ * A transaction queued behind a failed one starts after the STOP of the error
+ */
+static void testAfterError(I2CMaster& bus){
+    static const uint8_t head[] = {0x30, 0x11};
+    static const uint8_t next[] = {0x31, 0x22, 0x33};
+    I2CTransaction t1 = writeTrxn(TEST_MISSING, 0, head, sizeof(head));
+    I2CTransaction t2 = writeTrxn(TEST_ADDRESS, 0, next, sizeof(next));
+    CHECK(bus.submit(&t1) == I2C_WRITE_OK);
+    CHECK(bus.submit(&t2) == I2C_WRITE_OK);
+    waitEnd(t2);
+    CHECK(t1.status == I2C_ADDR_NACK);
+    CHECK(t2.status == I2C_WRITE_OK);
+    CHECK(memory.mem[0x31] == 0x22 && memory.mem[0x32] == 0x33);
+}
+
+/**
+ * Closing the bus while the next transaction waits for the STOP of an error
+ * leaves it idle: after open, transfers run again
+ */
+static void testCloseAfterError(I2CMaster& bus){
+    static const uint8_t head[] = {0x38, 0x11};
+    static const uint8_t next[] = {0x39, 0x44, 0x55};
+    I2CTransaction t1 = writeTrxn(TEST_MISSING, I2C_TRXN_NO_BURST, head, sizeof(head));
+    I2CTransaction t2 = writeTrxn(TEST_ADDRESS, 0, next, sizeof(next));
+    CHECK(bus.submit(&t1) == I2C_WRITE_OK);
+    CHECK(bus.submit(&t2) == I2C_WRITE_OK);
+    waitEnd(t1);                                    //Its STOP is still going out
+    CHECK(t1.status == I2C_ADDR_NACK);
+    bus.close();
+    CHECK(t2.status == I2C_BUSY && memory.mem[0x39] == 0);
+
+    bus.open();
+    I2CTransaction t3 = writeTrxn(TEST_ADDRESS, 0, next, sizeof(next));
+    CHECK(bus.transfer(&t3) == I2C_WRITE_OK);      //Hung in the STOP wait before
+    CHECK(memory.mem[0x39] == 0x44 && memory.mem[0x3A] == 0x55);
+}
+
+/**
+ * MPU-6050 sample, 7 words: readAll makes one 14 byte transaction, a read per
+ * register makes 7. Both give the same big endian words
+ */
+static void testRegisterMap(I2CMaster& bus){
+    using namespace Mpu6050;
+    for(uint8_t i = 0; i < 14; i++) imu.mem[AccelX::address + i] = 0x10 * i + 1;
+    I2CDevice<> device(bus, ADDRESS);
+    uint32_t burst[7];
+    uint32_t single[7];
+
+    static_assert(I2CDevice<>::bursts<AccelX, AccelY, AccelZ, Temp, GyroX, GyroY, GyroZ>() == 1, "MPU-6050 sample in one burst");
+    uint32_t started = bus.queueStats().started;
+    PrintStatus status = device.readAll<AccelX, AccelY, AccelZ, Temp, GyroX, GyroY, GyroZ>(burst);
+    CHECK(status == I2C_READ_OK);
+    CHECK(bus.queueStats().started - started == 1);
+
+    started = bus.queueStats().started;
+    CHECK(device.read<AccelX>(single[0]) == I2C_READ_OK);
+    CHECK(device.read<AccelY>(single[1]) == I2C_READ_OK);
+    CHECK(device.read<AccelZ>(single[2]) == I2C_READ_OK);
+    CHECK(device.read<Temp>(single[3]) == I2C_READ_OK);
+    CHECK(device.read<GyroX>(single[4]) == I2C_READ_OK);
+    CHECK(device.read<GyroY>(single[5]) == I2C_READ_OK);
+    CHECK(device.read<GyroZ>(single[6]) == I2C_READ_OK);
+    CHECK(bus.queueStats().started - started == 7);
+
+    for(uint8_t i = 0; i < 7; i++){
+        uint32_t word = ((uint32_t)imu.mem[AccelX::address + 2 * i] << 8) | imu.mem[AccelX::address + 2 * i + 1];
+        CHECK(burst[i] == word && single[i] == word);
+    }
+}
+
+int main(){
+    Sim::reset();
+    Sim::i2cAttach(I2C_I2C0, TEST_ADDRESS, &memory);
+    Sim::i2cAttach(I2C_I2C0, Mpu6050::ADDRESS, &imu);
+    I2CMaster bus(TEST_SPEED, I2C_I2C0);
+    testNoStartRejected(bus);
+    testNackNoRecovery(bus);
+    testHeldBus(bus);
+    testCancelBurst(bus);
+    testAfterError(bus);
+    testCloseAfterError(bus);
+    testRegisterMap(bus);
+    CHECK(Sim::faults() == 0);
+    return checkResult("TestI2C");
+}
+
+#endif
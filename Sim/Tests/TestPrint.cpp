@@ -0,0 +1,186 @@
+/*
+ * TestPrint.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// Golden output of the shared printf engine: every row of the format table runs
+// through printf and print(PRINT_FMT) on Print, PrintT and PrintAdapter over PrintT.
+// All of them must give the golden text, with the same write calls and PRINT_WR
+// flags (PRINT_STAGE_SIZE chunks, first one starts and last one stops the transaction).
+// Only Util/ is needed, the simulator is linked for the common build line.
+
+#include <stdint.h>
+#include <string>
+#include <Sim/Tests/Check.h>
+#include <Util/Print.hpp>
+#include <Util/PrintT.hpp>
+
+/**
+ * Print that records the text and the flags of every write
+ */
+class RecordPrint:public Print{
+    public:
+        std::string text;
+        std::string writes;     //Length and flags of each write
+
+    protected:
+        PrintStatus write(const char* txt, int n, uint8_t flags) override{
+            std::string s = n < 0 ? std::string(txt) : std::string(txt, n);
+            text += s;
+            writes += std::to_string(s.size()) + ":" + std::to_string(flags) + " ";
+            return _PRINT_STATUS_OK;
+        }
+        PrintStatus write(uint8_t c, uint8_t flags) override{
+            text += (char)c;
+            writes += "c:" + std::to_string(flags) + " ";
+            return _PRINT_STATUS_OK;
+        }
+};
+
+/**
+ * RecordPrint with static dispatch
+ */
+class RecordPrintT:public PrintT<RecordPrintT>{
+    friend class PrintT<RecordPrintT>;
+    public:
+        std::string text;
+        std::string writes;
+
+    private:
+        PrintStatus write(const char* txt, int n, uint8_t flags){
+            std::string s = n < 0 ? std::string(txt) : std::string(txt, n);
+            text += s;
+            writes += std::to_string(s.size()) + ":" + std::to_string(flags) + " ";
+            return _PRINT_STATUS_OK;
+        }
+        PrintStatus write(uint8_t c, uint8_t flags){
+            text += (char)c;
+            writes += "c:" + std::to_string(flags) + " ";
+            return _PRINT_STATUS_OK;
+        }
+};
+
+/**
+ * Run a table row on every printer and check it against the golden text
+ * @param line is the row source line, printed on failure
+ * @param expected is the golden text
+ * @param run prints the row on the printer given
+ */
+template<typename F>
+static void golden(int line, const char* expected, F run){
+    RecordPrint p;
+    RecordPrintT t;
+    RecordPrintT adapted;
+    PrintAdapter<RecordPrintT> adapter(adapted);
+
+    PrintStatus ps = run(p);
+    PrintStatus ts = run(t);
+    PrintStatus as = run(adapter);
+    bool ok = ps == _PRINT_STATUS_OK && ts == _PRINT_STATUS_OK && as == _PRINT_STATUS_OK &&
+              p.text == expected && t.text == expected && adapted.text == expected &&
+              t.writes == p.writes && adapted.writes == p.writes;
+    if(!ok){
+        printf("line %d: expected \"%s\"\n  Print   \"%s\" %s(%d)\n  PrintT  \"%s\" %s(%d)\n  Adapter \"%s\" %s(%d)\n",
+               line, expected, p.text.c_str(), p.writes.c_str(), ps, t.text.c_str(), t.writes.c_str(), ts,
+               adapted.text.c_str(), adapted.writes.c_str(), as);
+    }
+    CHECK(ok);
+}
+
+// Row: golden text, format and arguments, through printf and print(PRINT_FMT)
+#define GOLDEN(expected, fmt, ...)  do{ \
+                                        golden(__LINE__, expected, [](auto& p){ return p.printf(fmt, ##__VA_ARGS__); }); \
+                                        golden(__LINE__, expected, [](auto& p){ return p.print(PRINT_FMT(fmt), ##__VA_ARGS__); }); \
+                                    }while(0)
+
+static void testSpecifiers(){
+    GOLDEN("plain text", "plain text");
+    GOLDEN("0", "%d", 0);
+    GOLDEN("123", "%d", 123);
+    GOLDEN("-1234567", "%d", -1234567);
+    GOLDEN("-2147483648", "%d", INT32_MIN);
+    GOLDEN("2147483647", "%d", INT32_MAX);
+    GOLDEN("42", "%5d", 42);                            //Width is ignored by integers
+    GOLDEN("0x1A", "%x", 26);
+    GOLDEN("0x0100", "%x", 256);
+    GOLDEN("0x00", "%x", 0);
+    GOLDEN("-0x1A", "%x", -26);
+    GOLDEN("0x1A2B3C", "%x", 0x1A2B3C);
+    GOLDEN("0b1001", "%b", 9);
+    GOLDEN("0b00011100", "%b", 28);
+    GOLDEN("0b0000", "%b", 0);
+    GOLDEN("-0b1001", "%b", -9);
+    GOLDEN("0b10100101", "%b", 0xA5);
+    GOLDEN("0", "%u", 0u);
+    GOLDEN("4294967295", "%u", 4294967295u);
+    GOLDEN("0xFFFFFFFF", "%ux", 0xFFFFFFFFu);
+    GOLDEN("0xBEEF", "%ux", 0xBEEFu);
+    GOLDEN("0b10000000000000000000000000000000", "%ub", 0x80000000u);
+    GOLDEN("abc", "%s", "abc");
+    GOLDEN("ab", "%2s", "abc");                         //Width is the max chars of strings
+    GOLDEN("", "%0s", "abc");
+    GOLDEN("Z", "%c", 'Z');
+    GOLDEN("%", "%%");
+    GOLDEN("100%", "100%%");
+    GOLDEN("100%", "100%");                             //Single % at the end
+}
+
+static void testFloats(){
+    GOLDEN("3.1416", "%f", 3.14159f);                   //Default precision
+    GOLDEN("21.50", "%2f", 21.5f);                      //Width is the decimals of floats
+    GOLDEN("2", "%0f", 2.5f);                           //Half to even
+    GOLDEN("4", "%0f", 3.5f);
+    GOLDEN("-1.12", "%2f", -1.125f);
+    GOLDEN("1.500000000", "%9f", 1.5f);
+    GOLDEN("0.000", "%3f", 0.0f);
+    GOLDEN("-0.0", "%1f", -0.0f);
+    GOLDEN("4294967040.0", "%1f", 4294967040.0f);
+    GOLDEN("ovf", "%1f", 4294967296.0f);
+}
+
+static void testMixed(){
+    GOLDEN("T=21.50 id=0xBEEF n=-42 ok\r\n", "T=%2f id=%ux n=%d %s\r\n", 21.5f, 0xBEEFu, -42, "ok");
+    GOLDEN("[a][0x0F][-7][0b0011][1.0]", "[%c][%x][%d][%b][%1f]", 'a', 15, -7, 3, 1.0f);
+    //Over PRINT_STAGE_SIZE: several chunks in one transaction
+    GOLDEN("0123456789abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ=12345",
+           "0123456789abcdefghijklmnopqrstuvwxyz%sABCDEFGHIJKLMNOPQRSTUVWXYZ=%d", "0123456789", 12345);
+}
+
+/**
+ * setPrecision changes the default decimals, a bad runtime specifier fails
+ */
+static void testPrecisionAndErrors(){
+    RecordPrint p;
+    RecordPrintT t;
+    p.setPrecision(2);
+    t.setPrecision(2);
+    CHECK(p.printf("%f", 1.0f) == _PRINT_STATUS_OK && p.text == "1.00");
+    CHECK(t.printf("%f", 1.0f) == _PRINT_STATUS_OK && t.text == "1.00");
+    p.text.clear();
+    t.text.clear();
+    CHECK(p.print(PRINT_FMT("%f"), 1.0f) == _PRINT_STATUS_OK && p.text == "1.00");
+    CHECK(t.print(PRINT_FMT("%f"), 1.0f) == _PRINT_STATUS_OK && t.text == "1.00");
+
+    p.text.clear();
+    t.text.clear();
+    CHECK(p.printf("a%qb", 1) == _PRINT_STATUS_ERROR && p.text == "a%");
+    CHECK(t.printf("a%qb", 1) == _PRINT_STATUS_ERROR && t.text == "a%");
+
+    p.text.clear();
+    p.writes.clear();
+    CHECK(p.println("line") == _PRINT_STATUS_OK && p.text == "line\r\n");
+    t.text.clear();
+    t.writes.clear();
+    CHECK(t.println("line") == _PRINT_STATUS_OK && t.text == "line\r\n" && t.writes == p.writes);
+}
+
+int main(){
+    testSpecifiers();
+    testFloats();
+    testMixed();
+    testPrecisionAndErrors();
+    return checkResult("TestPrint");
+}
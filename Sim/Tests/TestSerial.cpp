@@ -0,0 +1,99 @@
+/*
+ * TestSerial.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// SerialPort buffered TX overflow policies (SERIAL_TX_OVF_*), on the simulated UART0.
+// Bytes are queued much faster than the UART sends them, so the TX ring buffer
+// overflows; the bytes on the wire and the drop count must follow the policy.
+
+#ifdef TIVA_SIM
+
+#include <string.h>
+#include <Sim/Tests/Check.h>
+#include <Peripherals/SerialPort.hpp>
+
+#define TEST_BAUD   115200
+#define TEST_LEN    400     //Bytes written per case, over SERIAL_TX_BUFFER_SIZE
+
+static char script[TEST_LEN];
+
+/**
+ * Write the script one byte at a time with a policy, then wait for the wire
+ * @param policy is the SERIAL_TX_OVF_* policy
+ * @param errors receives the quantity of writes that returned an error
+ * @return the quantity of bytes dropped by the policy
+ */
+static uint32_t writeScript(uint8_t policy, uint32_t& errors){
+    Sim::reset();
+    SerialPort port(TEST_BAUD, SERIALPORT_UART0);
+    port.setTxMode(SERIAL_TX_BUFFERED, policy);
+    errors = 0;
+    for(uint16_t i = 0; i < TEST_LEN; i++){
+        if(port.print(script[i]) != _PRINT_STATUS_OK) errors++;
+    }
+    CHECK(port.flush());
+    CHECK(port.txPending() == 0);
+    uint32_t dropped = port.txDropped();
+    port.close();
+    return dropped;
+}
+
+/**
+ * BLOCK: every byte goes out in order, nothing is dropped
+ */
+static void testBlock(){
+    uint32_t errors;
+    uint32_t dropped = writeScript(SERIAL_TX_OVF_BLOCK, errors);
+    CHECK(dropped == 0);
+    CHECK(errors == 0);
+    CHECK(Sim::uartOutputLength(0) == TEST_LEN);
+    CHECK(memcmp(Sim::uartOutput(0), script, TEST_LEN) == 0);
+    CHECK(Sim::faults() == 0);
+}
+
+/**
+ * DROP_NEWEST: the bytes written while the ring is full are refused, the wire
+ * gets the first bytes of the script, in order
+ */
+static void testDropNewest(){
+    uint32_t errors;
+    uint32_t dropped = writeScript(SERIAL_TX_OVF_DROP_NEWEST, errors);
+    uint32_t sent = Sim::uartOutputLength(0);
+    CHECK(dropped > 0);
+    CHECK(errors == dropped);
+    CHECK(sent + dropped == TEST_LEN);
+    CHECK(sent >= SERIAL_TX_BUFFER_SIZE);
+    CHECK(memcmp(Sim::uartOutput(0), script, SERIAL_TX_BUFFER_SIZE) == 0);
+    CHECK(Sim::faults() == 0);
+}
+
+/**
+ * DROP_OLDEST: writes never fail, the oldest queued bytes make room, so the
+ * wire ends with the last SERIAL_TX_BUFFER_SIZE bytes of the script
+ */
+static void testDropOldest(){
+    uint32_t errors;
+    uint32_t dropped = writeScript(SERIAL_TX_OVF_DROP_OLDEST, errors);
+    uint32_t sent = Sim::uartOutputLength(0);
+    const char* out = Sim::uartOutput(0);
+    CHECK(dropped > 0);
+    CHECK(errors == 0);
+    CHECK(sent + dropped == TEST_LEN);
+    CHECK(sent >= SERIAL_TX_BUFFER_SIZE);
+    CHECK(memcmp(out + sent - SERIAL_TX_BUFFER_SIZE, script + TEST_LEN - SERIAL_TX_BUFFER_SIZE, SERIAL_TX_BUFFER_SIZE) == 0);
+    CHECK(Sim::faults() == 0);
+}
+
+int main(){
+    for(uint16_t i = 0; i < TEST_LEN; i++) script[i] = (char)(' ' + i % 95);
+    testBlock();
+    testDropNewest();
+    testDropOldest();
+    return checkResult("TestSerial");
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * TestTask.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// Tasks on the event loop: 40 device tasks on four simulated I2C buses (ten
+// register memories per bus, one of them missing) and a console task awaiting
+// a line on UART0, all interleaved. Every task must finish with its data written
+// and read back, or with the error of its missing device.
+// One resume event and one timer per task, build with the common line plus:
+//
+//   -DEVENT_QUEUE_SIZE=64 -DEVENT_MAX_TIMERS=48
+//
+// Ten tasks per bus overflow the I2C_QUEUE_SIZE queue: submits refused with
+// BUSY are retried after a sleep.
+
+#ifdef TIVA_SIM
+
+#include <string.h>
+#include <Sim/Tests/Check.h>
+#include <Peripherals/Task.hpp>
+
+//The library must be built with the same sizes, defining them here isn't enough
+#if EVENT_QUEUE_SIZE < 64 || EVENT_MAX_TIMERS < 48
+#error "TestTask needs -DEVENT_QUEUE_SIZE=64 -DEVENT_MAX_TIMERS=48 (one event and one timer per task)"
+#endif
+
+#define TEST_BUSES      4
+#define TEST_PER_BUS    10
+#define TEST_TASKS      (TEST_BUSES * TEST_PER_BUS)
+#define TEST_ADDRESS    0x50    //First device of each bus
+#define TEST_MISSING    9       //Device index without slave on every bus
+#define TEST_ROUNDS     3
+#define TEST_LEN        8       //Bytes per round
+#define TEST_SPEED      400000
+#define TEST_LINE       "status all\r\n"
+#define TEST_LIMIT_MS   1000    //Simulated time limit
+
+static SimI2CMemory memories[TEST_TASKS];
+
+/**
+ * Write TEST_ROUNDS blocks of TEST_LEN bytes to a device, reading each one back
+ */
+class DeviceTask:public Task{
+    public:
+        I2CMaster* bus;
+        uint8_t address;
+        uint8_t id;
+        PrintStatus result;     //OK, the transaction error or ERROR if the data read differs
+        uint32_t retries;       //Submits refused, queue full
+
+        DeviceTask(): bus(0), address(0), id(0), result(I2C_BUSY), retries(0), round(0){}
+
+        /**
+         * @param r is the round
+         * @param i is the byte index
+         * @return the byte written by the task
+         */
+        uint8_t pattern(uint8_t r, uint8_t i){
+            return (uint8_t)(id * 29 + r * 7 + i);
+        }
+
+    protected:
+        void run() override{
+            TASK_BEGIN();
+            for(round = 0; round < TEST_ROUNDS; round++){
+                for(uint8_t i = 0; i < TEST_LEN; i++) out[i] = pattern(round, i);
+                while(1){
+                    TASK_AWAIT(writeTo(*bus, address, round * TEST_LEN, out, TEST_LEN));
+                    if(status != I2C_BUSY) break;
+                    retries++;
+                    TASK_AWAIT(sleep(1));
+                }
+                if(status != I2C_WRITE_OK){
+                    result = status;
+                    TASK_EXIT();
+                }
+                TASK_AWAIT(sleep(1 + id % 3));
+
+                while(1){
+                    TASK_AWAIT(readFrom(*bus, address, round * TEST_LEN, in, TEST_LEN));
+                    if(status != I2C_BUSY) break;
+                    retries++;
+                    TASK_AWAIT(sleep(1));
+                }
+                if(status != I2C_READ_OK || memcmp(in, out, TEST_LEN) != 0){
+                    result = status != I2C_READ_OK ? status : _PRINT_STATUS_ERROR;
+                    TASK_EXIT();
+                }
+            }
+            result = _PRINT_STATUS_OK;
+            TASK_END();
+        }
+
+    private:
+        uint8_t round;
+        uint8_t out[TEST_LEN];
+        uint8_t in[TEST_LEN];
+};
+
+/**
+ * Wait for a console line
+ */
+class ConsoleTask:public Task{
+    public:
+        SerialPort* port;
+        char line[24];
+
+    protected:
+        void run() override{
+            TASK_BEGIN();
+            TASK_AWAIT(readline(*port, line, sizeof(line), false));
+            TASK_END();
+        }
+};
+
+static DeviceTask tasks[TEST_TASKS];
+
+static bool allDone(ConsoleTask& console){
+    for(uint8_t i = 0; i < TEST_TASKS; i++){
+        if(!tasks[i].done()) return false;
+    }
+    return console.done();
+}
+
+int main(){
+    Sim::reset();
+    EventLoop::init();
+    I2CMaster bus0(TEST_SPEED, I2C_I2C0), bus1(TEST_SPEED, I2C_I2C1);
+    I2CMaster bus2(TEST_SPEED, I2C_I2C2), bus3(TEST_SPEED, I2C_I2C3);
+    I2CMaster* buses[TEST_BUSES] = {&bus0, &bus1, &bus2, &bus3};
+    SerialPort serial(115200, SERIALPORT_UART0);
+    serial.setRxMode(SERIAL_RX_BUFFERED);
+
+    for(uint8_t i = 0; i < TEST_TASKS; i++){
+        uint8_t b = i / TEST_PER_BUS;
+        uint8_t d = i % TEST_PER_BUS;
+        tasks[i].bus = buses[b];
+        tasks[i].address = TEST_ADDRESS + d;
+        tasks[i].id = i;
+        if(d != TEST_MISSING) Sim::i2cAttach(b, TEST_ADDRESS + d, &memories[i]);
+    }
+    ConsoleTask console;
+    console.port = &serial;
+
+    for(uint8_t i = 0; i < TEST_TASKS; i++) CHECK(tasks[i].start());
+    CHECK(console.start());
+    Sim::uartInject(0, TEST_LINE);
+
+    uint32_t start = EventLoop::ticks();
+    while(!allDone(console) && EventLoop::ticks() - start < TEST_LIMIT_MS){
+        if(!EventLoop::runOnce()) BOARD_SLEEP();
+    }
+
+    uint32_t retries = 0;
+    for(uint8_t i = 0; i < TEST_TASKS; i++){
+        DeviceTask& t = tasks[i];
+        retries += t.retries;
+        CHECK(t.done());
+        if(i % TEST_PER_BUS == TEST_MISSING){
+            CHECK(t.result == I2C_ADDR_NACK);
+            continue;
+        }
+        CHECK(t.result == _PRINT_STATUS_OK);
+        for(uint8_t r = 0; r < TEST_ROUNDS; r++){
+            for(uint8_t k = 0; k < TEST_LEN; k++){
+                CHECK(memories[i].mem[r * TEST_LEN + k] == t.pattern(r, k));
+            }
+        }
+    }
+    CHECK(console.done());
+    CHECK(strcmp(console.line, "status all") == 0);
+    CHECK(EventLoop::latency().dropped == 0);
+    CHECK(Sim::faults() == 0);
+    printf("%u tasks done in %u ms, %u submits retried\n", TEST_TASKS + 1,
+           (unsigned int)(EventLoop::ticks() - start), (unsigned int)retries);
+    return checkResult("TestTask");
+}
+
+#endif
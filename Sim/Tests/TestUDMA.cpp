@@ -0,0 +1,154 @@
+/*
+ * TestUDMA.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+// uDMA channel manager: channel contention between owners and bus errors,
+// through SerialPort writeAsync/readAsync on the simulated UART0.
+// The simulator makes no transfers, so async transfers stay active until
+// a bus error is injected, they are completed or cancelled.
+
+#ifdef TIVA_SIM
+
+#include <Sim/Tests/Check.h>
+#include <../inc/tm4c1294ncpdt.h>
+#include <Peripherals/SerialPort.hpp>
+#include <Peripherals/UDMA.hpp>
+
+#define TEST_RX_CH      8       //UART0 RX, TX = RX + 1
+#define TEST_TX_CH      9
+#define TEST_ENC        0       //UART0 channel encoding
+
+struct Completion{
+    uint8_t calls;
+    PrintStatus status;
+};
+
+static void onDone(PrintStatus status, void* arg){
+    Completion* c = (Completion*)arg;
+    c->calls++;
+    c->status = status;
+}
+
+static uint8_t errorCalls = 0;
+static void onError(void* owner){
+    (void)owner;
+    errorCalls++;
+}
+
+/**
+ * A claimed channel is refused to other owners, until released by its owner
+ */
+static void testContention(SerialPort& port){
+    static uint8_t other;
+    uint8_t buf[32] = {0};
+    Completion done = {0, _PRINT_STATUS_OK};
+
+    CHECK(UDMA::claim(TEST_TX_CH, TEST_ENC, &other, onError));
+    CHECK(UDMA::claim(TEST_TX_CH, TEST_ENC, &other, onError));          //Same owner again
+    CHECK(port.writeAsync(buf, sizeof(buf), onDone, &done) == _PRINT_STATUS_BUSY);
+    CHECK(!port.writeBusy());
+    CHECK(done.calls == 0);
+
+    UDMA::release(TEST_TX_CH, &port);                                   //Not the owner, ignored
+    CHECK(!UDMA::claim(TEST_TX_CH, TEST_ENC, &port));
+    UDMA::release(TEST_TX_CH, &other);
+
+    CHECK(port.writeAsync(buf, sizeof(buf), onDone, &done) == _PRINT_STATUS_OK);
+    CHECK(port.writeBusy());
+    CHECK(UDMA::isActive(TEST_TX_CH));
+    CHECK(!UDMA::claim(TEST_TX_CH, TEST_ENC, &other, onError));
+    CHECK(port.writeAsync(buf, sizeof(buf), onDone, &done) == _PRINT_STATUS_BUSY);
+
+    port.close();                                                       //Cancels and releases
+    CHECK(done.calls == 1 && done.status == _PRINT_STATUS_ERROR);
+    CHECK(!UDMA::isActive(TEST_TX_CH));
+    CHECK(UDMA::claim(TEST_TX_CH, TEST_ENC, &other, onError));
+    UDMA::release(TEST_TX_CH, &other);
+    port.open();
+}
+
+/**
+ * A bus error stops the failing channel: its owner aborts that transfer with
+ * ERROR and releases the channel, transfers on channels still running go on
+ */
+static void testBusError(SerialPort& port){
+    static uint8_t other;
+    uint8_t txBuf[32] = {0};
+    uint8_t rxBuf[32];
+    Completion tx = {0, _PRINT_STATUS_OK};
+    Completion rx = {0, _PRINT_STATUS_OK};
+    uint32_t errors = UDMA::errorCount();
+    errorCalls = 0;
+
+    CHECK(port.writeAsync(txBuf, sizeof(txBuf), onDone, &tx) == _PRINT_STATUS_OK);
+    CHECK(port.readAsync(rxBuf, sizeof(rxBuf), onDone, &rx) == _PRINT_STATUS_OK);
+    CHECK(UDMA::claim(TEST_RX_CH + 2, 0, &other, onError));            //Idle channel of another owner
+
+    CHECK(Sim::udmaInjectError(TEST_TX_CH));
+    CHECK(UDMA::errorCount() == errors + 1);
+    CHECK(tx.calls == 1 && tx.status == _PRINT_STATUS_ERROR);
+    CHECK(!port.writeBusy());
+    CHECK(rx.calls == 0);
+    CHECK(port.readBusy());
+    CHECK(UDMA::isActive(TEST_RX_CH));
+    CHECK(errorCalls == 0);                                             //Not told, it had no transfer to fail
+    CHECK((UDMA_ERRCLR_R & 0x01) == 0);                                 //Error cleared by the handler
+
+    CHECK(UDMA::claim(TEST_TX_CH, TEST_ENC, &other, onError));          //Released by the port
+    UDMA::release(TEST_TX_CH, &other);
+    UDMA::release(TEST_RX_CH + 2, &other);
+
+    CHECK(Sim::udmaInjectError(TEST_RX_CH));
+    CHECK(UDMA::errorCount() == errors + 2);
+    CHECK(rx.calls == 1 && rx.status == _PRINT_STATUS_ERROR);
+    CHECK(!port.readBusy());
+    CHECK(tx.calls == 1);
+    CHECK(Sim::udmaEnabled() == 0);
+    CHECK(!Sim::udmaInjectError(TEST_RX_CH));                           //Nothing left to fail
+}
+
+/**
+ * A channel that completed while another one failed isn't told of the error,
+ * only the owner of the failing channel aborts its transfer
+ */
+static void testCompletedAndFailed(SerialPort& port){
+    static uint8_t other;
+    uint8_t txBuf[32] = {0};
+    uint8_t src[4] = {1, 2, 3, 4};
+    uint8_t dst = 0;
+    Completion tx = {0, _PRINT_STATUS_OK};
+    errorCalls = 0;
+
+    CHECK(port.writeAsync(txBuf, sizeof(txBuf), onDone, &tx) == _PRINT_STATUS_OK);
+    CHECK(UDMA::claim(TEST_RX_CH + 2, 0, &other, onError));
+    UDMA::transfer(TEST_RX_CH + 2, src, &dst, sizeof(src), UDMA_CTL_MEM_TO_PERIPH);
+    CHECK(UDMA::isActive(TEST_RX_CH + 2));
+
+    CHECK(Sim::udmaComplete(TEST_RX_CH + 2));                           //Both before the error interrupt
+    CHECK(Sim::udmaInjectError(TEST_TX_CH));
+    CHECK(tx.calls == 1 && tx.status == _PRINT_STATUS_ERROR);
+    CHECK(!port.writeBusy());
+    CHECK(errorCalls == 0);                                             //Completed, not failed
+
+    UDMA::transfer(TEST_RX_CH + 2, src, &dst, sizeof(src), UDMA_CTL_MEM_TO_PERIPH);
+    CHECK(Sim::udmaInjectError(TEST_RX_CH + 2));
+    CHECK(errorCalls == 1);                                             //Its own transfer failed
+    UDMA::release(TEST_RX_CH + 2, &other);
+    CHECK(Sim::udmaEnabled() == 0);
+}
+
+int main(){
+    Sim::reset();
+    SerialPort port(115200, SERIALPORT_UART0);
+    testContention(port);
+    testBusError(port);
+    testCompletedAndFailed(port);
+    CHECK(Sim::faults() == 0);
+    return checkResult("TestUDMA");
+}
+
+#endif
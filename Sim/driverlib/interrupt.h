@@ -0,0 +1,24 @@
+/*
+ * interrupt.h
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_DRIVERLIB_INTERRUPT_H_
+#define SIM_DRIVERLIB_INTERRUPT_H_
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+extern bool IntMasterEnable(void);      //Simulated PRIMASK, pending interrupts run on enable
+extern bool IntMasterDisable(void);
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* SIM_DRIVERLIB_INTERRUPT_H_ */
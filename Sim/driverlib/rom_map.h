@@ -0,0 +1,19 @@
+/*
+ * rom_map.h
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_DRIVERLIB_ROM_MAP_H_
+#define SIM_DRIVERLIB_ROM_MAP_H_
+
+// No ROM in the simulator, MAP_ calls go to the simulator functions
+
+#define MAP_SysCtlDelay         SysCtlDelay
+#define MAP_IntMasterEnable     IntMasterEnable
+#define MAP_IntMasterDisable    IntMasterDisable
+
+
+#endif /* SIM_DRIVERLIB_ROM_MAP_H_ */
@@ -0,0 +1,26 @@
+/*
+ * sysctl.h
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_DRIVERLIB_SYSCTL_H_
+#define SIM_DRIVERLIB_SYSCTL_H_
+
+// Simulator replacement of the driverlib functions used by the library
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+extern void SysCtlDelay(uint32_t ui32Count);    //Advances the virtual clock 3 cycles per count
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* SIM_DRIVERLIB_SYSCTL_H_ */
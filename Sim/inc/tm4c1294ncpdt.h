@@ -0,0 +1,133 @@
+/*
+ * tm4c1294ncpdt.h
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef SIM_INC_TM4C1294NCPDT_H_
+#define SIM_INC_TM4C1294NCPDT_H_
+
+// Simulator replacement of the TivaWare register header: the registers used by
+// the library, mapped to the simulator register file
+
+#include <stdint.h>
+#include <Sim/Sim.hpp>
+
+#define SIM_R(x)    (*Sim::reg(x))
+
+//*****************************************************************************
+//
+// System control registers
+//
+//*****************************************************************************
+#define SYSCTL_RIS_R                SIM_R(0x400FE050)
+#define SYSCTL_MOSCCTL_R            SIM_R(0x400FE07C)
+#define SYSCTL_RSCLKCFG_R           SIM_R(0x400FE0B0)
+#define SYSCTL_MEMTIM0_R            SIM_R(0x400FE0C0)
+#define SYSCTL_ALTCLKCFG_R          SIM_R(0x400FE138)
+#define SYSCTL_PLLFREQ0_R           SIM_R(0x400FE160)
+#define SYSCTL_PLLFREQ1_R           SIM_R(0x400FE164)
+#define SYSCTL_PLLSTAT_R            SIM_R(0x400FE168)
+#define SYSCTL_SRI2C_R              SIM_R(0x400FE520)
+#define SYSCTL_RCGCTIMER_R          SIM_R(0x400FE604)
+#define SYSCTL_RCGCGPIO_R           SIM_R(0x400FE608)
+#define SYSCTL_RCGCDMA_R            SIM_R(0x400FE60C)
+#define SYSCTL_RCGCUART_R           SIM_R(0x400FE618)
+#define SYSCTL_RCGCSSI_R            SIM_R(0x400FE61C)
+#define SYSCTL_RCGCI2C_R            SIM_R(0x400FE620)
+#define SYSCTL_PRTIMER_R            SIM_R(0x400FEA04)
+#define SYSCTL_PRGPIO_R             SIM_R(0x400FEA08)
+#define SYSCTL_PRDMA_R              SIM_R(0x400FEA0C)
+#define SYSCTL_PRUART_R             SIM_R(0x400FEA18)
+#define SYSCTL_PRSSI_R              SIM_R(0x400FEA1C)
+#define SYSCTL_PRI2C_R              SIM_R(0x400FEA20)
+
+//*****************************************************************************
+//
+// NVIC and SysTick registers
+//
+//*****************************************************************************
+#define NVIC_ST_CTRL_R              SIM_R(0xE000E010)
+#define NVIC_ST_RELOAD_R            SIM_R(0xE000E014)
+#define NVIC_ST_CURRENT_R           SIM_R(0xE000E018)
+#define NVIC_EN0_R                  SIM_R(0xE000E100)
+#define NVIC_EN1_R                  SIM_R(0xE000E104)
+#define NVIC_EN2_R                  SIM_R(0xE000E108)
+#define NVIC_EN3_R                  SIM_R(0xE000E10C)
+#define NVIC_DIS0_R                 SIM_R(0xE000E180)
+#define NVIC_DIS1_R                 SIM_R(0xE000E184)
+#define NVIC_DIS2_R                 SIM_R(0xE000E188)
+#define NVIC_DIS3_R                 SIM_R(0xE000E18C)
+#define NVIC_INT_CTRL_R             SIM_R(0xE000ED04)
+
+//*****************************************************************************
+//
+// GPIO port N (AHB) registers
+//
+//*****************************************************************************
+#define GPIO_PORTN_DATA_R           SIM_R(0x400643FC)
+#define GPIO_PORTN_DIR_R            SIM_R(0x40064400)
+#define GPIO_PORTN_AFSEL_R          SIM_R(0x40064420)
+#define GPIO_PORTN_DEN_R            SIM_R(0x4006451C)
+#define GPIO_PORTN_PC_R             SIM_R(0x40064FC4)
+
+//*****************************************************************************
+//
+// Timer 0 registers
+//
+//*****************************************************************************
+#define TIMER0_CFG_R                SIM_R(0x40030000)
+#define TIMER0_TAMR_R               SIM_R(0x40030004)
+#define TIMER0_CTL_R                SIM_R(0x4003000C)
+#define TIMER0_IMR_R                SIM_R(0x40030018)
+#define TIMER0_RIS_R                SIM_R(0x4003001C)
+#define TIMER0_MIS_R                SIM_R(0x40030020)
+#define TIMER0_ICR_R                SIM_R(0x40030024)
+#define TIMER0_TAILR_R              SIM_R(0x40030028)
+#define TIMER0_TAV_R                SIM_R(0x40030050)
+#define TIMER1_CFG_R                SIM_R(0x40031000)
+#define TIMER1_TAMR_R               SIM_R(0x40031004)
+#define TIMER1_CTL_R                SIM_R(0x4003100C)
+#define TIMER1_IMR_R                SIM_R(0x40031018)
+#define TIMER1_RIS_R                SIM_R(0x4003101C)
+#define TIMER1_MIS_R                SIM_R(0x40031020)
+#define TIMER1_ICR_R                SIM_R(0x40031024)
+#define TIMER1_TAILR_R              SIM_R(0x40031028)
+#define TIMER1_TAMATCHR_R           SIM_R(0x40031030)
+#define TIMER1_TAV_R                SIM_R(0x40031050)
+#define TIMER1_CC_R                 SIM_R(0x40031FC8)
+
+//*****************************************************************************
+//
+// uDMA registers
+//
+//*****************************************************************************
+#define UDMA_STAT_R                 SIM_R(0x400FF000)
+#define UDMA_CFG_R                  SIM_R(0x400FF004)
+#define UDMA_CTLBASE_R              SIM_R(0x400FF008)
+#define UDMA_ALTBASE_R              SIM_R(0x400FF00C)
+#define UDMA_WAITSTAT_R             SIM_R(0x400FF010)
+#define UDMA_SWREQ_R                SIM_R(0x400FF014)
+#define UDMA_USEBURSTSET_R          SIM_R(0x400FF018)
+#define UDMA_USEBURSTCLR_R          SIM_R(0x400FF01C)
+#define UDMA_REQMASKSET_R           SIM_R(0x400FF020)
+#define UDMA_REQMASKCLR_R           SIM_R(0x400FF024)
+#define UDMA_ENASET_R               SIM_R(0x400FF028)
+#define UDMA_ENACLR_R               SIM_R(0x400FF02C)
+#define UDMA_ALTSET_R               SIM_R(0x400FF030)
+#define UDMA_ALTCLR_R               SIM_R(0x400FF034)
+#define UDMA_PRIOSET_R              SIM_R(0x400FF038)
+#define UDMA_PRIOCLR_R              SIM_R(0x400FF03C)
+#define UDMA_ERRCLR_R               SIM_R(0x400FF04C)
+#define UDMA_CHASGN_R               SIM_R(0x400FF500)
+#define UDMA_CHMAP0_R               SIM_R(0x400FF510)
+#define UDMA_CHMAP1_R               SIM_R(0x400FF514)
+#define UDMA_CHMAP2_R               SIM_R(0x400FF518)
+#define UDMA_CHMAP3_R               SIM_R(0x400FF51C)
+
+#define NVIC_INT_CTRL_VEC_ACT_M     0x000000FF  // Interrupt Pending Vector Number
+
+
+#endif /* SIM_INC_TM4C1294NCPDT_H_ */
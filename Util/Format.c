@@ -29,3 +29,154 @@ uint8_t isDigit(char c){
 uint8_t getNumber(char c){
     return c - '0';
 }
+
+//Two ASCII digits for every value 00 - 99
+static const char DIGIT_PAIRS[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+static const uint32_t POWERS_OF_10[] = {1, 10, 100, 1000, 10000, 100000, 1000000,
+                                        10000000, 100000000, 1000000000};
+
+/**
+ * Quantity of decimal digits of a value
+ *
+ * @param value is the number to measure
+ * @return the number of digits (1 - 10)
+ */
+static uint8_t countDigits(uint32_t value){
+    uint8_t n = 1;
+    while(n < 10 && value >= POWERS_OF_10[n]) n++;
+    return n;
+}
+
+/**
+ * Write exactly n digits of value (zero padded) at out, two digits per step
+ *
+ * @param value is the number to write, must be lower than 10^n
+ * @param n is the quantity of digits to write
+ * @param out is the destination, at least n chars
+ */
+static void writeDigits(uint32_t value, uint8_t n, char* out){
+    char* p = out + n;
+    while(n >= 2){
+        uint32_t pair = (value % 100) << 1;
+        value /= 100;
+        *(--p) = DIGIT_PAIRS[pair + 1];
+        *(--p) = DIGIT_PAIRS[pair];
+        n -= 2;
+    }
+    if(n) *(--p) = (char)('0' + value);
+}
+
+/**
+ * Convert an unsigned integer to its decimal representation
+ *
+ * @param value is the number to convert
+ * @param out is the destination string, at least FORMAT_UINT32_MAX_LEN chars
+ * @return the quantity of digits written (without '\0')
+ */
+uint8_t formatUnsigned(uint32_t value, char* out){
+    uint8_t n = countDigits(value);
+    writeDigits(value, n, out);
+    out[n] = '\0';
+    return n;
+}
+
+/**
+ * Convert a float to its fixed-point decimal representation ([-]int.decimals),
+ * working on the exact binary value with integer arithmetic. Last decimal is
+ * rounded half to even (same as printf). NaN and infinities are written as "nan", "inf", "-inf", and
+ * values out of the 32-bit integer range as "ovf" / "-ovf"
+ *
+ * @param value is the number to convert
+ * @param precision is the quantity of decimals (0 - FORMAT_FLOAT_MAX_PRECISION)
+ * @param out is the destination string
+ * @param size is the capacity of out, FORMAT_FLOAT_MAX_LEN always fits
+ * @return the quantity of chars written (without '\0'), 0 if out is too small
+ */
+uint8_t formatFloat(float value, uint8_t precision, char* out, uint8_t size){
+    union{float f; uint32_t u;} bits;
+    bits.f = value;
+
+    uint8_t negative = (bits.u >> 31) != 0;
+    int16_t exponent = (int16_t)((bits.u >> 23) & 0xFF);
+    uint32_t mantissa = bits.u & 0x7FFFFF;
+    const char* special = 0;
+    uint32_t ipart = 0, fpart = 0;
+
+    if(precision > FORMAT_FLOAT_MAX_PRECISION) precision = FORMAT_FLOAT_MAX_PRECISION;
+
+    if(exponent == 0xFF){
+        special = mantissa ? "nan" : "inf";
+        if(mantissa) negative = 0;
+    }else{
+        //value = mantissa * 2^exponent
+        if(exponent != 0) mantissa |= 0x800000;
+        exponent = exponent == 0 ? -149 : exponent - 150;
+
+        if(exponent >= 9){             //>= 2^32
+            special = "ovf";
+        }else{
+            if(exponent >= 0){
+                ipart = mantissa << exponent;
+            }else{
+                //fraction = fbits / 2^shift, scaled = fraction * 10^precision (exact, < 2^61)
+                uint16_t shift = (uint16_t)(-exponent);
+                uint32_t fbits = mantissa;
+                if(shift < 32){
+                    ipart = mantissa >> shift;
+                    fbits = mantissa & ((1UL << shift) - 1);
+                }
+                uint64_t scaled = (uint64_t)fbits * POWERS_OF_10[precision];
+                if(shift < 64){
+                    uint64_t rest = scaled & ((1ULL << shift) - 1);
+                    uint64_t half = 1ULL << (shift - 1);
+                    fpart = (uint32_t)(scaled >> shift);
+                    uint32_t last = precision ? fpart : ipart; //Last printed digit
+                    if(rest > half || (rest == half && (last & 0x01))) fpart++; //Round half to even
+                }
+                if(fpart >= POWERS_OF_10[precision]){ //Rounding carry to integer part
+                    fpart -= POWERS_OF_10[precision];
+                    if(ipart == 0xFFFFFFFF) special = "ovf";
+                    else ipart++;
+                }
+            }
+        }
+    }
+
+    uint8_t len = negative;
+    if(special){
+        len += 3;
+    }else{
+        len += countDigits(ipart) + (precision ? precision + 1 : 0);
+    }
+    if(len + 1 > size){
+        if(size) out[0] = '\0';
+        return 0;
+    }
+
+    char* p = out;
+    if(negative) *(p++) = '-';
+    if(special){
+        *(p++) = special[0];    *(p++) = special[1];    *(p++) = special[2];
+    }else{
+        p += formatUnsigned(ipart, p);
+        if(precision){
+            *(p++) = '.';
+            writeDigits(fpart, precision, p);
+            p += precision;
+        }
+    }
+    *p = '\0';
+    return len;
+}
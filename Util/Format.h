@@ -13,6 +13,10 @@
 
 #include <stdint.h>
 
+#define FORMAT_UINT32_MAX_LEN       11  //"4294967295" + '\0'
+#define FORMAT_FLOAT_MAX_PRECISION  9
+#define FORMAT_FLOAT_MAX_LEN        22  //'-' + 10 integer digits + '.' + 9 decimals + '\0'
+
 #ifdef __cplusplus
 extern "C"{
 #endif
@@ -21,6 +25,10 @@ extern uint8_t isDigit(char c);
 
 extern uint8_t getNumber(char c);
 
+extern uint8_t formatUnsigned(uint32_t value, char* out);
+
+extern uint8_t formatFloat(float value, uint8_t precision, char* out, uint8_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 #include <stdarg.h>
+#include <Util/PrintFormat.hpp>
+#include <Util/Probe.hpp>
 
 
 // PRINT FLAG DESCRIPTION (8 bits)
@@ -39,24 +41,44 @@
 
 #define _PRINT_STATUS_OK        0x00
 #define _PRINT_STATUS_ERROR     0x01
+#define _PRINT_STATUS_BUSY      0x03    //Resource in use by another transfer (ERROR bit set)
+#define _PRINT_STATUS_TIMEOUT   0x41    //Deadline passed before the transfer completed (ERROR bit set)
 
 typedef uint8_t PrintStatus;
 
+#define PRINT_FLOAT_PRECISION   4   //Default float decimals
+
+#ifndef PRINT_STAGE_SIZE
+#define PRINT_STAGE_SIZE        32  //printf staging buffer (bytes per write call)
+#endif
+
 class Print{
     public:
-        Print(){}
+        Print(): precision(PRINT_FLOAT_PRECISION){}
 
         PrintStatus print(char c);
         PrintStatus print(const char*, int=-1);
         PrintStatus println(const char*, int=-1);
         PrintStatus printf(const char* format, ...);
 
+        template<uint16_t LEN, char... Cs, typename... Args>
+        PrintStatus print(PrintFormat::Literal<LEN, Cs...>, const Args&... args);
+
+        void setPrecision(uint8_t);
+
+#ifdef PRINT_STATS
+        static uint32_t writeCalls; //Virtual write calls made by Print methods
+#endif
+
     private:
-        char buffer[15];
-        PrintStatus printFloat(float, uint8_t);
-        PrintStatus printDecimal(unsigned int, uint8_t);
-        PrintStatus printBinOrHex(unsigned int, uint8_t, uint8_t);
-        PrintStatus printNumber(unsigned int, uint8_t, bool, uint8_t);
+        // Write callable of the printf stage (PrintEngine::Stage)
+        struct Sink{
+            Sink(Print* printer): out(printer){}
+            PrintStatus operator()(const char*, int, uint8_t);
+            Print* out;
+        };
+
+        uint8_t precision;
 
     protected:
         virtual PrintStatus write(const char* byt, int n, uint8_t flags) = 0;
@@ -64,5 +86,7 @@ class Print{
 };
 
 
+// Stage, formatters and print(PRINT_FMT(...)) definition
+#include <Util/PrintEngine.hpp>
 
 #endif /* UTIL_PRINT_HPP_ */
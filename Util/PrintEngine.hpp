@@ -0,0 +1,333 @@
+/*
+ * PrintEngine.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef UTIL_PRINTENGINE_HPP_
+#define UTIL_PRINTENGINE_HPP_
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <Util/Format.h>
+#include <Util/Print.hpp>
+
+// printf formatting shared by Print and PrintT: the staging buffer, the
+// runtime format parser and the typed argument formatters of print(PRINT_FMT(...)).
+// The output goes to a staging buffer type with the Stage interface:
+//      void put(char);
+//      void put(const char*, int);
+//      PrintStatus status;     //Formatting stops when it isn't OK
+// Stage is a template over the write callable of the printer (its Sink), so
+// each Print flavor gets its own stage and the stage calls are direct (and
+// inlined for PrintT).
+
+#define _PRINT_NUMBER_FLOAT     'f'
+#define _PRINT_NUMBER_BIN_BASE  'b'
+#define _PRINT_NUMBER_DEC_BASE  'd'
+#define _PRINT_NUMBER_HEX_BASE  'x'
+
+namespace PrintEngine{
+
+    // Collects printf output, sending it in chunks of one transaction
+    // Sink is the write callable: PrintStatus operator()(const char*, int, uint8_t flags)
+    template<typename Sink>
+    class Stage{
+        public:
+            Stage(Sink sink): status(_PRINT_STATUS_OK), out(sink), len(0), first(true){}
+            inline void put(char);
+            inline void put(const char*, int);
+            inline PrintStatus finish();
+            PrintStatus status;
+
+        private:
+            Sink out;
+            char buf[PRINT_STAGE_SIZE];
+            uint8_t len;
+            bool first;
+            void flush(bool);
+    };
+
+    /**
+     * Append a char, the buffer is sent first if it is full
+     * @param c is the char to append
+     */
+    template<typename Sink>
+    inline void Stage<Sink>::put(char c){
+        if(len == PRINT_STAGE_SIZE) flush(false);
+        buf[len++] = c;
+    }
+
+    /**
+     * Append up to n chars of a string
+     *
+     * @param txt is the string to append
+     * @param n is the maximum number of chars
+     *      if n < 0, append until '\0'
+     */
+    template<typename Sink>
+    inline void Stage<Sink>::put(const char* txt, int n){
+        while((n < 0 || n-- > 0) && *txt){
+            put(*(txt++));
+        }
+    }
+
+    /**
+     * Send the staged chars as a chunk of the transaction
+     * First chunk starts the transaction, last one stops it
+     *
+     * @param last indicates the final chunk
+     */
+    template<typename Sink>
+    void Stage<Sink>::flush(bool last){
+        if(status == _PRINT_STATUS_OK){
+            uint8_t flags = (first ? PRINT_WR_CTL_INIT_TRXN : PRINT_WR_CTL_CONT_TRXN) | (last ? PRINT_WR_STOP : 0);
+            status = out(buf, len, flags);
+        }
+        first = false;
+        len = 0;
+    }
+
+    /**
+     * Send the remaining chars, ending the transaction
+     * @return print attempt result of the whole transaction (ERROR or OK)
+     */
+    template<typename Sink>
+    inline PrintStatus Stage<Sink>::finish(){
+        if(len != 0) flush(true);
+        return status;
+    }
+
+    /**
+     * Print binary or hexadecimal unsigned integers
+     *
+     * @param i is the integer value to print
+     * @param iType specifies the format
+     *      - _PRINT_NUMBER_HEX_BASE hexadecimal format (8 bits packet), Example: i=26 -> 0x1A; i=256 -> 0x0100
+     *      - _PRINT_NUMBER_BIN_BASE binary format (4 bits packet), Example: i=9 -> 0b1001; i=28 -> 0b00011100
+     * @param stage is the output staging buffer
+     */
+    template<typename Stage>
+    void binOrHex(unsigned int i, uint8_t iType, Stage& stage){
+        stage.put('0');
+
+        int groupSize, binCount, iShift, mask, bitShift, tMask, tShift, rShift;
+
+        if(iType == _PRINT_NUMBER_HEX_BASE){
+            groupSize = 2; binCount =  2*sizeof(unsigned int);
+            iShift = (sizeof(unsigned int) - 1) << 3; mask = 0xFF << iShift;
+            bitShift = 8; tMask = 0xF0 << iShift; tShift = 4; rShift = 4;
+        }else{
+            groupSize = 4; binCount = 8*sizeof(unsigned int);
+            iShift = 4 + ((sizeof(unsigned int) - 1) << 3); mask = 0xF << iShift;
+            bitShift = 4; tMask = 0x8 << iShift; tShift = 3; rShift = 1;
+        }
+
+        stage.put(iType);
+
+        //If i value equals zero, print as many zeros as the format groupsize
+        if(i == 0) {
+            while(groupSize-- > 0){
+                stage.put('0');
+            }
+            return;
+        }
+
+        //Find group containing the MSB
+        while((i & mask) == 0x00){
+            i <<= bitShift;
+            binCount -= groupSize;
+        }
+
+        for(; binCount > 0; binCount--){
+            char toWrite = (char)((i & tMask) >> (iShift+tShift)); // Get number
+            toWrite += toWrite <= 9 ? '0' : 'A' - 10; //Get hex char
+            i <<= rShift;
+            stage.put(toWrite);
+        }
+    }
+
+    /**
+     * Print unsigned base 10 integer
+     * @param i is the number to print
+     * @param stage is the output staging buffer
+     */
+    template<typename Stage>
+    inline void decimal(unsigned int i, Stage& stage){
+        char digits[FORMAT_UINT32_MAX_LEN];
+        uint8_t n = formatUnsigned(i, digits);
+        stage.put(digits, n);
+    }
+
+    /**
+     * Print float number
+     * @param f is the number to print
+     * @param decimals is the quantity of decimals
+     * @param stage is the output staging buffer
+     */
+    template<typename Stage>
+    inline void floating(float f, uint8_t decimals, Stage& stage){
+        char digits[FORMAT_FLOAT_MAX_LEN];
+        uint8_t n = formatFloat(f, decimals, digits, sizeof(digits));
+        stage.put(digits, n);
+    }
+
+    /**
+     * Print a number
+     * @param i contains a 32-bit number
+     * @param iType specify the number type:
+     *      - _PRINT_NUMBER_DEC_BASE decimal integer type
+     *      - _PRINT_NUMBER_HEX_BASE hexadecimal integer type
+     *      - _PRINT_NUMBER_BIN_BASE binary integer type
+     *      - _PRINT_NUMBER_FLOAT float type
+     * @param iSigned indicates if print the number as a signed type
+     * @param precision is the quantity of decimals of float numbers
+     * @param stage is the output staging buffer
+     */
+    template<typename Stage>
+    void number(unsigned int i, uint8_t iType, bool iSigned, uint8_t precision, Stage& stage){
+        union {unsigned int ui; int i; float f;} n; //32-bit number
+        n.ui = i;
+
+        if(iType == _PRINT_NUMBER_FLOAT){
+            floating(n.f, precision, stage);
+            return;
+        }
+
+        //If signed integer is less than 0 then print '-' character
+        if(iSigned && (n.i < 0)){
+            stage.put('-');
+            n.ui = 0U - n.ui; //Since '-' printed, print the magnitude (INT32_MIN too, no signed overflow)
+        }
+
+        //Map integer to print method
+        if(iType == _PRINT_NUMBER_BIN_BASE){
+            binOrHex(n.ui, _PRINT_NUMBER_BIN_BASE, stage);
+        }else if(iType == _PRINT_NUMBER_HEX_BASE){
+            binOrHex(n.ui, _PRINT_NUMBER_HEX_BASE, stage);
+        }else{
+            decimal(n.ui, stage);
+        }
+    }
+
+    /**
+     * Render a printf format (see Print::printf for the specifiers)
+     *
+     * @param stage is the output staging buffer
+     * @param format is the format string
+     * @param args are the variable arguments to print
+     * @param precision is the default quantity of decimals of %f
+     * @return false if the format is bad (output stops at the bad specifier)
+     */
+    template<typename Stage>
+    bool format(Stage& stage, const char* format, va_list args, uint8_t precision){
+        bool badFormat = false;
+
+        while(*format && stage.status == _PRINT_STATUS_OK){ //While current char != '\0' (End of string)
+            if(*format == '%' ){ //Possible format specifier
+                format++;
+
+                int argFlag = isDigit(*format) ? 0 : -1;
+                union{int i; unsigned int ui; float f;} n;
+
+                //Argument flag found
+                while(isDigit(*format)){
+                    argFlag = 10*argFlag + getNumber(*(format++));
+                }
+
+                switch(*format){
+                    case '\0':{
+                        stage.put('%'); //Print single %
+                        if(argFlag >= 0) badFormat = true;
+                        format--;       //Stay on string end
+                    }break;
+                    case 'd': case 'x': case 'b':{      //Print signed integer
+                        n.i = va_arg(args, int);
+                        number(n.ui, *format, true, precision, stage);
+                    }break;
+                    case 'f':{                          //Print float
+                        n.f = (float)va_arg(args, double); //float arguments are promoted to double
+                        floating(n.f, argFlag >= 0 ? (uint8_t)argFlag : precision, stage);
+                    }break;
+                    case '%':  case 'c': {              //Print single char
+                        char car = *format != 'c' ? *format : (char)va_arg(args, int);
+                        stage.put(car);
+                    }break;
+                    case 's':{                          //Print string
+                        stage.put((const char*)va_arg(args, const char*), argFlag);
+                    }break;
+                    case 'u':{                          //Print unsigned integer
+                        n.ui = va_arg(args, unsigned int);
+                        if(*(format+1)=='x'){           //Print unsigned hexadecimal
+                            number(n.ui, _PRINT_NUMBER_HEX_BASE, false, precision, stage);
+                            format++;   //'x' read, increment pointer
+                        }else if(*(format+1) == 'b'){   //Print unsigned binary
+                            number(n.ui, _PRINT_NUMBER_BIN_BASE, false, precision, stage);
+                            format++;   //'b' read, increment pointer
+                        }else{                          //Print unsigned decimal
+                            number(n.ui, _PRINT_NUMBER_DEC_BASE, false, precision, stage);
+                        }
+                    }break;
+                    default:{                           //Bad formatted string
+                        stage.put('%');
+                        badFormat = true;
+                    }break;
+                }
+                if(badFormat) break;
+            }else{
+                stage.put(*format);
+            }
+            format++;
+        }
+        return !badFormat;
+    }
+
+    // Typed argument formatters for print(PRINT_FMT(...), ...), see PrintFormat::Emit
+    struct Formatter{
+        uint8_t precision;      //Decimals of %f without flag
+
+        template<typename Stage>
+        inline void printArg(Stage& stage, PrintFormat::Tag<PrintFormat::SIGNED>, char base, int, int i){
+            number((unsigned int)i, base, true, precision, stage);
+        }
+        template<typename Stage>
+        inline void printArg(Stage& stage, PrintFormat::Tag<PrintFormat::UNSIGNED>, char base, int, unsigned int i){
+            number(i, base, false, precision, stage);
+        }
+        template<typename Stage>
+        inline void printArg(Stage& stage, PrintFormat::Tag<PrintFormat::FLOAT>, char, int flag, float f){
+            floating(f, flag >= 0 ? (uint8_t)flag : precision, stage);
+        }
+        template<typename Stage>
+        inline void printArg(Stage& stage, PrintFormat::Tag<PrintFormat::STRING>, char, int flag, const char* txt){
+            stage.put(txt, flag);
+        }
+        template<typename Stage>
+        inline void printArg(Stage& stage, PrintFormat::Tag<PrintFormat::CHAR>, char, int, char c){
+            stage.put(c);
+        }
+    };
+}
+
+/**
+ * Print formatted string, format parsed at compile time
+ * Same output as printf(format, args...), but argument types are checked
+ * against the specifiers when compiling and no format is parsed at runtime
+ *
+ * @param format is the format string, given as PRINT_FMT("...")
+ * @param args are the arguments to print
+ * @return print attempt result (ERROR or OK)
+ */
+template<uint16_t LEN, char... Cs, typename... Args>
+inline PrintStatus Print::print(PrintFormat::Literal<LEN, Cs...>, const Args&... args){
+    PROBE_SCOPE(PROBE_PRINT_FMT);
+    PrintEngine::Stage<Sink> stage(Sink(this));
+    PrintEngine::Formatter formatter = {precision};
+    PrintFormat::Emit<PrintFormat::Literal<LEN, Cs...>, 0>::run(formatter, stage, args...);
+    return stage.finish();
+}
+
+
+#endif /* UTIL_PRINTENGINE_HPP_ */
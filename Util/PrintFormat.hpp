@@ -0,0 +1,214 @@
+/*
+ * PrintFormat.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef UTIL_PRINTFORMAT_HPP_
+#define UTIL_PRINTFORMAT_HPP_
+
+#include <stdint.h>
+#include <type_traits>
+
+// Compile time parser for Print::print(PRINT_FMT("..."), args...) and PrintT::print
+// Same specifiers as Print::printf: %[flags]specifier, specifier in d x b u ux ub f s c %
+
+#define PRINT_FMT_MAX_LEN   128 //Max format string length (chars, without '\0')
+
+#define _PRINT_FMT_AT(s, i)     ((i) < sizeof(s) ? (s)[(i) < sizeof(s) ? (i) : 0] : '\0')
+#define _PRINT_FMT_8(s, i)      _PRINT_FMT_AT(s, (i)+0), _PRINT_FMT_AT(s, (i)+1), _PRINT_FMT_AT(s, (i)+2), _PRINT_FMT_AT(s, (i)+3), \
+                                _PRINT_FMT_AT(s, (i)+4), _PRINT_FMT_AT(s, (i)+5), _PRINT_FMT_AT(s, (i)+6), _PRINT_FMT_AT(s, (i)+7)
+#define _PRINT_FMT_32(s, i)     _PRINT_FMT_8(s, (i)+0), _PRINT_FMT_8(s, (i)+8), _PRINT_FMT_8(s, (i)+16), _PRINT_FMT_8(s, (i)+24)
+
+/**
+ * Wrap a format string literal so Print::print parses it at compile time
+ * Example: Serial.print(PRINT_FMT("%d chars\r\n"), n);
+ */
+#define PRINT_FMT(s)    ::PrintFormat::Literal<sizeof(s) - 1, _PRINT_FMT_32(s, 0), _PRINT_FMT_32(s, 32), \
+                                                               _PRINT_FMT_32(s, 64), _PRINT_FMT_32(s, 96)>()
+
+namespace PrintFormat{
+
+    // Segment found at a format position
+    enum Kind : uint8_t{
+        TEXT,       //Plain chars up to the next '%' or end
+        END,        //End of format
+        PERCENT,    //%% or a single % at the end, prints '%'
+        SIGNED,     //%d %x %b
+        UNSIGNED,   //%u %ux %ub
+        FLOAT,      //%f
+        STRING,     //%s
+        CHAR,       //%c
+        BAD         //Unknown specifier
+    };
+
+    template<uint8_t K> struct Tag{};
+
+    template<typename T> struct Never{ static constexpr bool value = false; };
+
+    /**
+     * Format string as a type, chars after LEN are '\0'
+     * @tparam LEN is the string length
+     * @tparam Cs are the string chars
+     */
+    template<uint16_t LEN, char... Cs>
+    struct Literal{
+        static_assert(LEN <= PRINT_FMT_MAX_LEN, "PRINT_FMT string longer than PRINT_FMT_MAX_LEN");
+        static constexpr char str[sizeof...(Cs) + 1] = {Cs..., '\0'};
+    };
+
+    template<uint16_t LEN, char... Cs>
+    constexpr char Literal<LEN, Cs...>::str[sizeof...(Cs) + 1];
+
+    constexpr bool isDigit(char c){ return c >= '0' && c <= '9'; }
+
+    /**
+     * @param fmt is the format string
+     * @param pos is the position of a '%'
+     * @return position of the specifier char (after the flag digits)
+     */
+    constexpr uint16_t specAt(const char* fmt, uint16_t pos){
+        pos++;
+        while(isDigit(fmt[pos])) pos++;
+        return pos;
+    }
+
+    /**
+     * @param fmt is the format string
+     * @param pos is the position of a '%'
+     * @return flag value, -1 if not given
+     */
+    constexpr int flagAt(const char* fmt, uint16_t pos){
+        int flag = isDigit(fmt[pos + 1]) ? 0 : -1;
+        for(pos++; isDigit(fmt[pos]); pos++){
+            flag = 10*flag + (fmt[pos] - '0');
+        }
+        return flag;
+    }
+
+    /**
+     * @param fmt is the format string
+     * @param pos is a format position
+     * @return kind of the segment starting at pos
+     */
+    constexpr uint8_t kindAt(const char* fmt, uint16_t pos){
+        if(fmt[pos] == '\0') return END;
+        if(fmt[pos] != '%') return TEXT;
+
+        char c = fmt[specAt(fmt, pos)];
+        switch(c){
+            case '\0': return flagAt(fmt, pos) < 0 ? PERCENT : BAD;
+            case '%': return PERCENT;
+            case 'd': case 'x': case 'b': return SIGNED;
+            case 'u': return UNSIGNED;
+            case 'f': return FLOAT;
+            case 's': return STRING;
+            case 'c': return CHAR;
+            default: return BAD;
+        }
+    }
+
+    /**
+     * @param fmt is the format string
+     * @param pos is the position of a '%'
+     * @return number base char of an integer specifier ('d', 'x' or 'b')
+     */
+    constexpr char baseAt(const char* fmt, uint16_t pos){
+        uint16_t spec = specAt(fmt, pos);
+        if(fmt[spec] != 'u') return fmt[spec];
+        return (fmt[spec + 1] == 'x' || fmt[spec + 1] == 'b') ? fmt[spec + 1] : 'd';
+    }
+
+    /**
+     * @param fmt is the format string
+     * @param pos is a format position
+     * @return position after the segment starting at pos
+     */
+    constexpr uint16_t nextAt(const char* fmt, uint16_t pos){
+        if(fmt[pos] != '%'){
+            while(fmt[pos] != '\0' && fmt[pos] != '%') pos++;
+            return pos;
+        }
+        uint16_t spec = specAt(fmt, pos);
+        if(fmt[spec] == '\0') return spec;  //Stay on string end
+        if(fmt[spec] == 'u' && (fmt[spec + 1] == 'x' || fmt[spec + 1] == 'b')) return spec + 2;
+        return spec + 1;
+    }
+
+    // Argument types accepted by each specifier
+    template<typename T>
+    struct IsInteger{
+        static constexpr bool value = sizeof(T) <= 4 && !std::is_same<T, bool>::value &&
+            (std::is_integral<T>::value || (std::is_enum<T>::value && std::is_convertible<T, int>::value));
+    };
+
+    template<uint8_t K, typename T> struct Accepts{ static constexpr bool value = false; };
+    template<typename T> struct Accepts<SIGNED, T>{ static constexpr bool value = IsInteger<T>::value; };
+    template<typename T> struct Accepts<UNSIGNED, T>{ static constexpr bool value = IsInteger<T>::value; };
+    template<typename T> struct Accepts<CHAR, T>{ static constexpr bool value = IsInteger<T>::value; };
+    template<typename T> struct Accepts<FLOAT, T>{ static constexpr bool value = std::is_floating_point<T>::value; };
+    template<typename T> struct Accepts<STRING, T>{
+        static constexpr bool value = std::is_same<typename std::decay<T>::type, const char*>::value ||
+                                      std::is_same<typename std::decay<T>::type, char*>::value;
+    };
+
+    // Compile time printf, one specialization per format segment
+    // Out gives the typed argument formatters (PrintEngine::Formatter):
+    //      void printArg(Stage&, Tag<Kind>, char base, int flag, T arg);
+    // Stage is the staging buffer of the printer (see PrintEngine)
+    template<typename Fmt, uint16_t Pos, uint8_t Kind = kindAt(Fmt::str, Pos)>
+    struct Emit{
+        template<typename Out, typename Stage, typename T, typename... Args>
+        static inline void run(Out& out, Stage& stage, const T& arg, const Args&... args){
+            static_assert(Accepts<Kind, T>::value, "print: argument type does not match format specifier");
+            out.printArg(stage, Tag<Kind>(), baseAt(Fmt::str, Pos), flagAt(Fmt::str, Pos), arg);
+            Emit<Fmt, nextAt(Fmt::str, Pos)>::run(out, stage, args...);
+        }
+        template<typename Out, typename Stage>
+        static inline void run(Out&, Stage&){
+            static_assert(Never<Fmt>::value, "print: fewer arguments than format specifiers");
+        }
+    };
+
+    // Plain text
+    template<typename Fmt, uint16_t Pos>
+    struct Emit<Fmt, Pos, TEXT>{
+        template<typename Out, typename Stage, typename... Args>
+        static inline void run(Out& out, Stage& stage, const Args&... args){
+            stage.put(Fmt::str + Pos, nextAt(Fmt::str, Pos) - Pos);
+            Emit<Fmt, nextAt(Fmt::str, Pos)>::run(out, stage, args...);
+        }
+    };
+
+    // Single %
+    template<typename Fmt, uint16_t Pos>
+    struct Emit<Fmt, Pos, PERCENT>{
+        template<typename Out, typename Stage, typename... Args>
+        static inline void run(Out& out, Stage& stage, const Args&... args){
+            stage.put('%');
+            Emit<Fmt, nextAt(Fmt::str, Pos)>::run(out, stage, args...);
+        }
+    };
+
+    // End of format
+    template<typename Fmt, uint16_t Pos>
+    struct Emit<Fmt, Pos, END>{
+        template<typename Out, typename Stage, typename... Args>
+        static inline void run(Out&, Stage&, const Args&...){
+            static_assert(sizeof...(Args) == 0, "print: more arguments than format specifiers");
+        }
+    };
+
+    // Unknown specifier
+    template<typename Fmt, uint16_t Pos>
+    struct Emit<Fmt, Pos, BAD>{
+        static_assert(Never<Fmt>::value, "print: bad format specifier");
+        template<typename Out, typename Stage, typename... Args>
+        static inline void run(Out&, Stage&, const Args&...){}
+    };
+}
+
+
+#endif /* UTIL_PRINTFORMAT_HPP_ */
@@ -0,0 +1,190 @@
+/*
+ * PrintT.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef UTIL_PRINTT_HPP_
+#define UTIL_PRINTT_HPP_
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <Util/Print.hpp>
+#include <Util/PrintEngine.hpp>
+
+// Static dispatch Print (CRTP): same print, println and printf output and
+// PRINT_WR flags as Print, but the writer is called directly, so it can be
+// inlined into the formatting code. The writer class derives from PrintT
+// with itself as argument and provides the two Print write methods, not virtual:
+//
+//   class Out:public PrintT<Out>{
+//       friend class PrintT<Out>;     //If the writes aren't public
+//       PrintStatus write(const char* txt, int n, uint8_t flags);
+//       PrintStatus write(uint8_t c, uint8_t flags);
+//   };
+//
+// Used by the compile-time drivers (SerialPortT, I2CMasterT).
+//
+// Code taking a Print& (Benchmark, I2CDevice, ...) gets a PrintT writer through
+// PrintAdapter, a Print whose virtual writes forward to the writer:
+//
+//   SerialPortT<SERIALPORT_UART0> console(115200);
+//   PrintAdapter<SerialPortT<SERIALPORT_UART0>> consolePrint(console);
+//   Benchmark bench(consolePrint, &i2c, &spi);
+
+template<typename Derived> class PrintAdapter;
+
+template<typename Derived>
+class PrintT{
+    public:
+        PrintT(): precision(PRINT_FLOAT_PRECISION){}
+
+        inline PrintStatus print(char c);
+        inline PrintStatus print(const char*, int=-1);
+        PrintStatus println(const char*, int=-1);
+        PrintStatus printf(const char* format, ...);
+
+        template<uint16_t LEN, char... Cs, typename... Args>
+        PrintStatus print(PrintFormat::Literal<LEN, Cs...>, const Args&... args);
+
+        void setPrecision(uint8_t);
+
+    protected:
+        // Write callable of the printf stage (PrintEngine::Stage)
+        struct Sink{
+            Sink(Derived& writer): out(writer){}
+            inline PrintStatus operator()(const char* txt, int n, uint8_t flags){
+                return forward(out, txt, n, flags);
+            }
+            Derived& out;
+        };
+        typedef PrintEngine::Stage<Sink> Stage;
+
+        uint8_t precision;
+
+    private:
+        friend class PrintAdapter<Derived>;
+
+        inline Derived& writer(){ return *static_cast<Derived*>(this); }
+
+        // Writer calls for PrintAdapter (the writes may be visible to PrintT only)
+        static inline PrintStatus forward(Derived& out, const char* txt, int n, uint8_t flags){
+            return out.write(txt, n, flags);
+        }
+        static inline PrintStatus forward(Derived& out, uint8_t c, uint8_t flags){
+            return out.write(c, flags);
+        }
+
+};
+
+// Print interface over a PrintT writer, for code taking a Print&
+// Only the two writes are virtual, the formatting runs in Print with its own precision
+template<typename Derived>
+class PrintAdapter:public Print{
+    public:
+        PrintAdapter(Derived& writer): out(writer){}
+
+    protected:
+        PrintStatus write(const char* txt, int n, uint8_t flags){
+            return PrintT<Derived>::forward(out, txt, n, flags);
+        }
+        PrintStatus write(uint8_t c, uint8_t flags){
+            return PrintT<Derived>::forward(out, c, flags);
+        }
+
+    private:
+        Derived& out;
+};
+
+/**
+ * Print single character
+ *
+ * @param c is the character to print
+ * @return print attempt result (ERROR or OK)
+ */
+template<typename Derived>
+inline PrintStatus PrintT<Derived>::print(char c){
+    return writer().write((uint8_t)c, PRINT_WR_MOD_SINGLE);
+}
+
+/**
+ * Print n characters of a string
+ *
+ * @param txt is the string to print
+ * @param n indicates the number of characters to print
+ *      if n <0 then print all characters of the string
+ * @return print attempt result (ERROR or OK)
+ */
+template<typename Derived>
+inline PrintStatus PrintT<Derived>::print(const char* txt, int n){
+    return writer().write(txt, n, PRINT_WR_CTL_SNGL_TRXN);
+}
+
+/**
+ * Print n characters of a string, followed by end of line ("\r\n")
+ *
+ * @param txt is the string to print
+ * @param n indicates the number of characters to print
+ *      if n <0 then print all characters of the string
+ * @return print attempt result (ERROR or OK)
+ */
+template<typename Derived>
+PrintStatus PrintT<Derived>::println(const char* txt, int n){
+    if(writer().write(txt, n, PRINT_WR_CTL_INIT_TRXN) != _PRINT_STATUS_OK){
+        return _PRINT_STATUS_ERROR;
+    }
+    return writer().write("\r\n", -1, PRINT_WR_CTL_END_TRXN);
+}
+
+/**
+ * Print formatted string, same specifiers as Print::printf
+ *
+ * @param format C string containing the text and format specifiers
+ * @param ... are the variable arguments to print
+ * @return print attempt result (ERROR or OK)
+ */
+template<typename Derived>
+PrintStatus PrintT<Derived>::printf(const char* format, ...){
+    PROBE_SCOPE(PROBE_PRINTF);
+    va_list args;
+    va_start(args, format);
+
+    Stage stage(writer());
+    bool badFormat = !PrintEngine::format(stage, format, args, precision);
+
+    va_end(args);
+    PrintStatus status = stage.finish();
+    return badFormat ? _PRINT_STATUS_ERROR : status;
+}
+
+/**
+ * Print formatted string, format parsed at compile time (see Print::print)
+ *
+ * @param format is the format string, given as PRINT_FMT("...")
+ * @param args are the arguments to print
+ * @return print attempt result (ERROR or OK)
+ */
+template<typename Derived>
+template<uint16_t LEN, char... Cs, typename... Args>
+inline PrintStatus PrintT<Derived>::print(PrintFormat::Literal<LEN, Cs...>, const Args&... args){
+    PROBE_SCOPE(PROBE_PRINT_FMT);
+    Stage stage(writer());
+    PrintEngine::Formatter formatter = {precision};
+    PrintFormat::Emit<PrintFormat::Literal<LEN, Cs...>, 0>::run(formatter, stage, args...);
+    return stage.finish();
+}
+
+/**
+ * Set the default quantity of decimals for float values
+ *
+ * @param decimals is the quantity of decimals (0 to 9)
+ */
+template<typename Derived>
+void PrintT<Derived>::setPrecision(uint8_t decimals){
+    precision = decimals > FORMAT_FLOAT_MAX_PRECISION ? FORMAT_FLOAT_MAX_PRECISION : decimals;
+}
+
+
+#endif /* UTIL_PRINTT_HPP_ */
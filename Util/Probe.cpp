@@ -0,0 +1,65 @@
+/*
+ * Probe.cpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#include <Util/Probe.hpp>
+#include <Util/Print.hpp>
+
+#ifdef PROBE_STATS
+ProbeStats Probe::table[PROBE_COUNT];
+
+static const char* const PROBE_NAMES[PROBE_COUNT] = {"printf", "print_fmt", "serial_write", "serial_isr",
+                                                     "i2c_trxn", "i2c_isr", "user0", "user1", "user2", "user3"};
+#endif
+
+/**
+ * Clear the accumulators of all probe points
+ * On the target the DWT cycle counter is enabled too
+ */
+void Probe::reset(){
+#ifdef PROBE_STATS
+#ifndef TIVA_SIM
+    enableCycleCounter();
+#endif
+    for(uint8_t i = 0; i < PROBE_COUNT; i++){
+        table[i].count = 0;
+        table[i].min = 0xFFFFFFFF;
+        table[i].max = 0;
+        table[i].total = 0;
+    }
+#endif
+}
+
+/**
+ * Print the table, a CSV line per probe point that was hit, preceded by a header line:
+ *  probe,count,min,max,avg
+ * Call it outside the probed code (e.g. not while SerialPort writes are measured)
+ *
+ * @param out is the output, usually a SerialPort
+ */
+void Probe::dump(Print& out){
+#ifdef PROBE_STATS
+    out.println("probe,count,min,max,avg");
+    for(uint8_t i = 0; i < PROBE_COUNT; i++){
+        ProbeStats s = table[i];    //Copy, ISR probes may update it meanwhile
+        if(s.count == 0) continue;
+        out.printf("%s,%u,%u,%u,%u\r\n", PROBE_NAMES[i], s.count, s.min, s.max, (uint32_t)(s.total / s.count));
+    }
+#else
+    out.println("probes disabled (PROBE_STATS)");
+#endif
+}
+
+#ifdef PROBE_STATS
+/**
+ * @param id is the probe point
+ * @return accumulators of the probe point (min is 0xFFFFFFFF if count is 0)
+ */
+const ProbeStats& Probe::stats(uint8_t id){
+    return table[id];
+}
+#endif
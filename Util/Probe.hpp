@@ -0,0 +1,104 @@
+/*
+ * Probe.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef UTIL_PROBE_HPP_
+#define UTIL_PROBE_HPP_
+
+#include <stdint.h>
+#include <Peripherals/Board.hpp>
+
+// Hot path instrumentation, cycles between the begin and the end of a probe point
+// accumulated per probe (count, min, max, total) in a static table.
+// Build with PROBE_STATS defined to enable it, otherwise the probe macros expand
+// to nothing and the table isn't allocated.
+// Call Probe::reset() before the first measure: it clears the table and, on the
+// target, enables the DWT cycle counter (CYCLE_COUNT) used as time base. Host
+// builds (TIVA_SIM) read the simulator clock directly, so probing doesn't
+// add register accesses to the simulated time.
+//
+//  PROBE_SCOPE(id)             - measure until the end of the enclosing block
+//  PROBE_BEGIN(id) ... PROBE_END(id)   - measure a section of a block
+//
+// A probe that is entered again before finishing (e.g. from an interrupt) is
+// measured twice, including the time of the inner one in the outer one.
+
+#ifdef TIVA_SIM
+#define PROBE_NOW()         ((uint32_t)Sim::now())
+#else
+#define PROBE_NOW()         (CYCLE_COUNT())
+#endif
+
+// Probe points
+#define PROBE_PRINTF            0   //Print::printf
+#define PROBE_PRINT_FMT         1   //Print::print(PRINT_FMT)
+#define PROBE_SERIAL_WRITE      2   //SerialPort::write(const char*, int, uint8_t)
+#define PROBE_SERIAL_ISR        3   //SerialPort UART interrupt
+#define PROBE_I2C_TRXN          4   //I2CMaster blocking transaction (execute)
+#define PROBE_I2C_ISR           5   //I2CMaster I2C interrupt
+#define PROBE_USER0             6   //Free for application code
+#define PROBE_USER1             7
+#define PROBE_USER2             8
+#define PROBE_USER3             9
+#define PROBE_COUNT             10
+
+typedef struct{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} ProbeStats;
+
+class Print;
+
+class Probe{
+    public:
+        static void reset();
+        static void dump(Print&);
+
+#ifdef PROBE_STATS
+        static const ProbeStats& stats(uint8_t);
+
+        /**
+         * Accumulate a measure
+         * @param id is the probe point
+         * @param cycles is the measured time
+         */
+        static inline void record(uint8_t id, uint32_t cycles){
+            ProbeStats& s = table[id];
+            s.count++;
+            s.total += cycles;
+            if(cycles < s.min) s.min = cycles;
+            if(cycles > s.max) s.max = cycles;
+        }
+
+        // Measures from its construction to its destruction
+        class Scope{
+            public:
+                inline Scope(uint8_t probe): id(probe), start(PROBE_NOW()){}
+                inline ~Scope(){ record(id, PROBE_NOW() - start); }
+            private:
+                uint8_t id;
+                uint32_t start;
+        };
+
+    private:
+        static ProbeStats table[PROBE_COUNT];
+#endif
+};
+
+#ifdef PROBE_STATS
+#define PROBE_SCOPE(id)     Probe::Scope _probeScope##id(id)
+#define PROBE_BEGIN(id)     uint32_t _probeStart##id = PROBE_NOW()
+#define PROBE_END(id)       Probe::record(id, PROBE_NOW() - _probeStart##id)
+#else
+#define PROBE_SCOPE(id)
+#define PROBE_BEGIN(id)
+#define PROBE_END(id)
+#endif
+
+#endif /* UTIL_PROBE_HPP_ */
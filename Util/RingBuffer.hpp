@@ -0,0 +1,86 @@
+/*
+ * RingBuffer.hpp
+ *
+ *  Created on: 17 oct. 2026
+ *  Author: Manuel Andres Herrera Jurez
+ *  Ciudad de Mxico, Mxico
+ */
+
+#ifndef UTIL_RINGBUFFER_HPP_
+#define UTIL_RINGBUFFER_HPP_
+
+#include <stdint.h>
+
+/**
+ * Fixed-size, lock-free single producer / single consumer ring buffer.
+ *
+ * One context (e.g. main thread) may only call the producer methods (push, isFull)
+ * and the other context (e.g. an ISR) may only call the consumer methods (pop, peek,
+ * discard). Head and tail are free-running indexes, so the whole SIZE is usable.
+ *
+ * @tparam T is the stored element type
+ * @tparam SIZE is the buffer capacity, must be a power of 2 (2 - 32768)
+ */
+template<typename T, uint16_t SIZE>
+class RingBuffer{
+    static_assert(SIZE >= 2 && SIZE <= 32768 && (SIZE & (SIZE - 1)) == 0,
+                  "RingBuffer SIZE must be a power of 2 between 2 and 32768");
+    public:
+        RingBuffer(): head(0), tail(0){}
+
+        /**
+         * Producer: store a value at the end of the buffer
+         * @param v is the value to store
+         * @return false if buffer is full (value not stored)
+         */
+        inline bool push(T v){
+            uint16_t h = head;
+            if((uint16_t)(h - tail) >= SIZE) return false;
+            data[h & (SIZE - 1)] = v;
+            head = h + 1;   //Publish value after it is stored
+            return true;
+        }
+
+        /**
+         * Consumer: take the oldest value of the buffer
+         * @param v receives the value
+         * @return false if buffer is empty
+         */
+        inline bool pop(T& v){
+            uint16_t t = tail;
+            if(t == head) return false;
+            v = data[t & (SIZE - 1)];
+            tail = t + 1;   //Release slot after it is read
+            return true;
+        }
+
+        /**
+         * Consumer: drop the oldest value without reading it
+         * @return false if buffer is empty
+         */
+        inline bool discard(){
+            uint16_t t = tail;
+            if(t == head) return false;
+            tail = t + 1;
+            return true;
+        }
+
+        /**
+         * Empty the buffer. Only safe when neither producer nor consumer is running
+         */
+        inline void clear(){ tail = head; }
+
+        inline uint16_t count() const { return (uint16_t)(head - tail); }
+        inline uint16_t free() const { return SIZE - count(); }
+        inline bool isEmpty() const { return head == tail; }
+        inline bool isFull() const { return count() >= SIZE; }
+        static inline uint16_t capacity(){ return SIZE; }
+
+    private:
+        volatile T data[SIZE];
+        volatile uint16_t head; //Written only by the producer
+        volatile uint16_t tail; //Written only by the consumer
+};
+
+
+#endif /* UTIL_RINGBUFFER_HPP_ */
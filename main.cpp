@@ -3,6 +3,15 @@
 #include <Peripherals/SerialPort.hpp>
 
 #include <Peripherals/Board.hpp>
+#include <Peripherals/Pin.hpp>
+#include <Peripherals/Clock.hpp>
+#include <Peripherals/EventLoop.hpp>
+#include <Peripherals/Timebase.hpp>
+#ifdef BENCHMARK
+#include <Bench/Benchmark.hpp>
+#endif
+
+typedef Pin<GPIO_PORTN_OFF, 1> Led;     //User LED D1
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,90 +19,153 @@ extern "C" {
 
 /**
  * Init Tiva EK-TM4C1294XL Launchpad for this example
- * Clock source = Precision Internal Oscillator (PIOSC = 16MHz)
+ * System clock = CPU_FREQUENCY (PLL 120 MHz, see USE_PLL), peripherals using
+ * the alternate clock run from the Precision Internal Oscillator (PIOSC = 16MHz)
  *
  * Enable GPIO PORTN clock, and configure user led PN1 as output
- * Configure Timer0 for blocking main process
+ * Start the timebase (Timer1) and the event loop tick (Timer0)
  */
 void init(){
+    initSystemClock();                      //Core and bus clock, before any peripheral timing
     SYSCTL_ALTCLKCFG_R &= ~0x0F;            //Set Clock for GPT, SSI and UART = PIOSC (16 MHz)
-    SYSCTL_RCGCGPIO_R |= 1 << 12;           //Init GPIO_N Clock
-    while(SYSCTL_RCGCGPIO_R & (1<<12) == 0);//Wait until clock propagation
-    GPIO_PORTN_DIR_R = 0x02;                //Set PN1 as output
-    GPIO_PORTN_AFSEL_R &= 0xFFFFFFFD;       //Set PN1 Controlled by GPIO
-    GPIO_PORTN_PC_R &= 0xFFFFFFFE;          // Drive values of 2,4,8 mA
-    GPIO_PORTN_DEN_R |= 0x02;               //Enable PN1
-    GPIO_PORTN_DATA_R = 0x00;               //Clear Output
-
-    SYSCTL_RCGCTIMER_R |= 0x01;                 //Enable Timer 0S
-    while((SYSCTL_RCGCTIMER_R & 0x01) == 0x00); //Wait for timer0 clock enable
-    TIMER0_CTL_R = 0x00;                        //Disable Timer A and B
-    TIMER0_CFG_R = 0x00;                        //Configure as 32 bit timer
-    TIMER0_TAMR_R = 0x02;                       //Periodic Mode
-    TIMER0_TAILR_R = (uint32_t)(((float)CPU_PIOSC_FREQUENCY)*0.5f); //0.5 second count
-    TIMER0_IMR_R = 0x01;                        //Timer A TimeOut Interrupt Mask
-    NVIC_EN0_R |= 1 << 19;                      //Enable NVIC Timer0 Interrupt
-    TIMER0_CTL_R |= 0x01;                       //Enable Timer0
+    Led::enable();                          //GPIO_N Clock
+    Led::clear();                           //Off before driving it
+    Led::output();                          //PN1 GPIO output, 2 mA
+
+    Timebase::init();                       //Timer1 microsecond timebase (driver deadlines)
+    EventLoop::init();                      //Timer0 1 ms tick, after the system clock
+}
+
+#ifdef __cplusplus
 }
+#endif
+
 
 
 
 /**
- * Timer interrupt for free main process, using the request variable
+ * Example with I2CMaster and SerialPort classes for the Tiva TM4C1294NCPDT, driven
+ * by the event loop: the CPU sleeps at 16 MHz until a line is received, runs at
+ * CPU_FREQUENCY while serving it, prompts again 0.5 s later
  */
-volatile int request = 0;
-void Timer0A_INTERRUPT(){
-    if((TIMER0_RIS_R & 0x01) != 0x00){  //Timeout Event Interrupt
-        GPIO_PORTN_DATA_R ^= 0x02;      //Show interrupt by toggling User LED PN1
-        TIMER0_ICR_R |= 0x01;           //Clear Interrupt
-        request = 1;                    //Change request value
-    }
+
+#define I2C_TEST_ADDRESS    0x08
+#define I2C_TEST_REG        0x2A
+
+static SerialPort* serial;
+static I2CMaster* i2c;
+
+//Different buffers for demonstrate not garbage collected
+//Can be implemented with a single buffer
+static char UARTBuffer[30]; //R/W buffer for UART0
+static char I2CBuffer[10]; // R/W buffer for I2C0
+static I2CTransaction i2cWrite;
+static I2CTransaction i2cRead;
+
+/**
+ * Show the program is alive by toggling User LED PN1
+ */
+static void ledToggle(uint32_t data, void* arg){
+    Led::toggle();
 }
 
-#ifdef __cplusplus
+static void prompt(uint32_t data, void* arg){
+    serial->print("Enter a string and pulse intro: ");
+    Clock::set(CPU_PIOSC_FREQUENCY);    //Nothing to do until a line arrives, run at 16 MHz meanwhile
 }
-#endif
 
+/**
+ * I2C read done: show the device response, prompt again in 0.5 s
+ * @param data is the transaction status
+ */
+static void readDone(uint32_t data, void* arg){
+    if((PrintStatus)data == I2C_READ_OK){
+        serial->print(PRINT_FMT("I2C: %d chars received\r\n\trxMsg: %6s\r\n\n"), 6, I2CBuffer); //Show msg
+    }else{
+        serial->println("I2C: Error Reading");
+    }
+    EventLoop::after(500, prompt);
+}
 
+/**
+ * I2C write done: read the device response (6 bytes)
+ * @param data is the transaction status
+ */
+static void writeDone(uint32_t data, void* arg){
+    if((PrintStatus)data != I2C_READ_OK){
+        serial->println("I2C: Error Writing");
+        EventLoop::after(500, prompt);
+        return;
+    }
+    i2cRead.rx = (uint8_t*)I2CBuffer;
+    i2cRead.rxLen = 6;
+    if(i2c->submit(&i2cRead) != I2C_READ_OK) readDone(_PRINT_STATUS_ERROR, 0);
+}
 
+/**
+ * Transaction callbacks, called from the I2C0 interrupt: finish in the event loop
+ */
+static void postStatus(PrintStatus status, void* arg){
+    EventLoop::post((EventHandler)arg, 0, (uint32_t)status);
+}
 
 /**
- * Main process executing an example with I2CMaster and SerialPort classes
- * for the Tiva TM4C1294NCPDT
- * @return none
+ * Line received: write its first 5 characters (right aligned) to the 0x2A mem. loc.
  */
+static void lineReady(uint32_t data, void* arg){
+    if(!serial->tryReadline(UARTBuffer, 30, false)) return;
+    Clock::set(CPU_FREQUENCY);
+    serial->println("\r\nAttempt to write first 5 characters to 0x2A mem. loc. at extern I2C device");
+
+    uint8_t n = 0;
+    while(n < 5 && UARTBuffer[n] != '\0') n++;
+    for(uint8_t i = 0; i < 5; i++){ //Same bytes as printf("%5s")
+        I2CBuffer[i] = i < 5 - n ? ' ' : UARTBuffer[i - (5 - n)];
+    }
+    i2cWrite.reg = I2C_TEST_REG;
+    i2cWrite.tx = (const uint8_t*)I2CBuffer;
+    i2cWrite.txLen = 5;
+    if(i2c->submit(&i2cWrite) != I2C_READ_OK) writeDone(_PRINT_STATUS_ERROR, 0);
+}
 
-#define I2C_TEST_ADDRESS    0x08
+/**
+ * SerialPort line callback, called from the UART0 interrupt
+ */
+static void onLine(PrintStatus status, void* arg){
+    EventLoop::post(lineReady);
+}
 
 int main(void){
     init();
 
     SerialPort Serial(115200);        //UART0 115200 bauds, GPIO's: PA0(RX), PA1(TX)
-    I2CMaster I2C0(100000, I2C_I2C0); //I2C0 100000 Hz, GPIO's: PB2 (SCL), PB3(SDA)
+    Serial.setFifo(true, SERIAL_FIFO_1_8, SERIAL_FIFO_1_2); //16 byte hardware FIFOs
+    Serial.setTxMode(SERIAL_TX_BUFFERED, SERIAL_TX_OVF_BLOCK); //Non-blocking prints, drained by UART0 interrupt
+    Serial.setRxMode(SERIAL_RX_BUFFERED);   //Received bytes collected by UART0 interrupt
+
+#ifdef BENCHMARK
+    //CSV results on UART0, needs an I2C memory device at BENCH_I2C_ADDRESS on I2C0
+    Benchmark bench(Serial, Serial, 115200, I2C_I2C0);
+    bench.run();
+    while(1);
+#endif
 
-    //Different buffers for demonstrate not garbage collected
-    //Can be implemented with a single buffer
-    char UARTBuffer[30]; //R/W buffer for UART0
-    char I2CBuffer[10]; // R/W buffer for I2C0
-    I2C0.setAddress(I2C_TEST_ADDRESS);
-
-    //Test Serial and I2C0
-    while(1){
-        Serial.print("Enter a string and pulse intro: ");
-        Serial.readline(UARTBuffer, 30, false);
-        Serial.println("\r\nAttempt to write first 5 characters to 0x2A mem. loc. at extern I2C device");
-
-        if(I2C0.printf("%c%5s", 0x2A, UARTBuffer) == I2C_READ_OK){ //Write 6 bytes to I2C Line Control
-            if(I2C0.read(I2CBuffer, 6, true) == I2C_READ_OK){ //Read device response (6 bytes)
-                Serial.printf("I2C: %d chars received\r\n\trxMsg: %6s\r\n\n", 6, I2CBuffer); //Show msg
-            }else{
-                Serial.println("I2C: Error Reading");
-            }
-        }else{
-            Serial.println("I2C: Error Writing");
-        }
-
-        request = 0;
-        while(request == 0); //Delay 0.5s
-    }
+    I2CMaster I2C0(100000, I2C_I2C0); //I2C0 100000 Hz, GPIO's: PB2 (SCL), PB3(SDA)
+    serial = &Serial;
+    i2c = &I2C0;
+
+    i2cWrite.address = I2C_TEST_ADDRESS;
+    i2cWrite.flags = I2C_TRXN_REG;
+    i2cWrite.priority = I2C_PRIORITY_NORMAL;
+    i2cWrite.callback = postStatus;
+    i2cWrite.arg = (void*)writeDone;
+    i2cRead.address = I2C_TEST_ADDRESS;
+    i2cRead.priority = I2C_PRIORITY_NORMAL;
+    i2cRead.callback = postStatus;
+    i2cRead.arg = (void*)readDone;
+
+    Serial.setLineCallback(onLine);
+    EventLoop::every(500, ledToggle);
+    EventLoop::post(prompt);
+    EventLoop::run();   //Dispatch events, sleep (WFI) between them
 }
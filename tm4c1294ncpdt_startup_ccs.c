@@ -56,7 +56,31 @@ extern uint32_t __STACK_TOP;
 //
 //*****************************************************************************
 // To be added by user
-extern void Timer0A_INTERRUPT(void);
+extern void EventLoop_Timer0A_Interrupt(void);
+extern void Timebase_Timer1A_Interrupt(void);
+extern void SerialPort_UART0_Interrupt(void);
+extern void SerialPort_UART1_Interrupt(void);
+extern void SerialPort_UART2_Interrupt(void);
+extern void SerialPort_UART3_Interrupt(void);
+extern void SerialPort_UART4_Interrupt(void);
+extern void SerialPort_UART5_Interrupt(void);
+extern void SerialPort_UART6_Interrupt(void);
+extern void SerialPort_UART7_Interrupt(void);
+extern void I2CMaster_I2C0_Interrupt(void);
+extern void I2CMaster_I2C1_Interrupt(void);
+extern void I2CMaster_I2C2_Interrupt(void);
+extern void I2CMaster_I2C3_Interrupt(void);
+extern void I2CMaster_I2C4_Interrupt(void);
+extern void I2CMaster_I2C5_Interrupt(void);
+extern void I2CMaster_I2C6_Interrupt(void);
+extern void I2CMaster_I2C7_Interrupt(void);
+extern void I2CMaster_I2C8_Interrupt(void);
+extern void I2CMaster_I2C9_Interrupt(void);
+extern void SPIMaster_SSI0_Interrupt(void);
+extern void SPIMaster_SSI1_Interrupt(void);
+extern void SPIMaster_SSI2_Interrupt(void);
+extern void SPIMaster_SSI3_Interrupt(void);
+extern void UDMA_Error_Interrupt(void);
 //*****************************************************************************
 //
 // The vector table.  Note that the proper constructs must be placed on this to
@@ -92,10 +116,10 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // GPIO Port C
     IntDefaultHandler,                      // GPIO Port D
     IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx //5
-    IntDefaultHandler,                      // UART1 Rx and Tx
-    IntDefaultHandler,                      // SSI0 Rx and Tx
-    IntDefaultHandler,                      // I2C0 Master and Slave
+    SerialPort_UART0_Interrupt,             // UART0 Rx and Tx //5
+    SerialPort_UART1_Interrupt,             // UART1 Rx and Tx
+    SPIMaster_SSI0_Interrupt,               // SSI0 Rx and Tx
+    I2CMaster_I2C0_Interrupt,               // I2C0 Master and Slave
     IntDefaultHandler,                      // PWM Fault
     IntDefaultHandler,                      // PWM Generator 0 //10
     IntDefaultHandler,                      // PWM Generator 1
@@ -106,9 +130,9 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // ADC Sequence 2
     IntDefaultHandler,                      // ADC Sequence 3
     IntDefaultHandler,                      // Watchdog timer
-    Timer0A_INTERRUPT,                      // Timer 0 subtimer A //19-0
+    EventLoop_Timer0A_Interrupt,            // Timer 0 subtimer A //19-0
     IntDefaultHandler,                      // Timer 0 subtimer B
-    IntDefaultHandler,                      // Timer 1 subtimer A
+    Timebase_Timer1A_Interrupt,             // Timer 1 subtimer A
     IntDefaultHandler,                      // Timer 1 subtimer B
     IntDefaultHandler,                      // Timer 2 subtimer A
     IntDefaultHandler,                      // Timer 2 subtimer B
@@ -120,11 +144,11 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // GPIO Port F
     IntDefaultHandler,                      // GPIO Port G
     IntDefaultHandler,                      // GPIO Port H
-    IntDefaultHandler,                      // UART2 Rx and Tx
-    IntDefaultHandler,                      // SSI1 Rx and Tx
+    SerialPort_UART2_Interrupt,             // UART2 Rx and Tx
+    SPIMaster_SSI1_Interrupt,               // SSI1 Rx and Tx
     IntDefaultHandler,                      // Timer 3 subtimer A//35-32
     IntDefaultHandler,                      // Timer 3 subtimer B
-    IntDefaultHandler,                      // I2C1 Master and Slave
+    I2CMaster_I2C1_Interrupt,               // I2C1 Master and Slave
     IntDefaultHandler,                      // CAN0
     IntDefaultHandler,                      // CAN1
     IntDefaultHandler,                      // Ethernet
@@ -132,7 +156,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // USB0
     IntDefaultHandler,                      // PWM Generator 3
     IntDefaultHandler,                      // uDMA Software Transfer
-    IntDefaultHandler,                      // uDMA Error
+    UDMA_Error_Interrupt,                   // uDMA Error
     IntDefaultHandler,                      // ADC1 Sequence 0
     IntDefaultHandler,                      // ADC1 Sequence 1
     IntDefaultHandler,                      // ADC1 Sequence 2
@@ -141,15 +165,15 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // GPIO Port J
     IntDefaultHandler,                      // GPIO Port K
     IntDefaultHandler,                      // GPIO Port L
-    IntDefaultHandler,                      // SSI2 Rx and Tx
-    IntDefaultHandler,                      // SSI3 Rx and Tx
-    IntDefaultHandler,                      // UART3 Rx and Tx
-    IntDefaultHandler,                      // UART4 Rx and Tx
-    IntDefaultHandler,                      // UART5 Rx and Tx
-    IntDefaultHandler,                      // UART6 Rx and Tx
-    IntDefaultHandler,                      // UART7 Rx and Tx
-    IntDefaultHandler,                      // I2C2 Master and Slave
-    IntDefaultHandler,                      // I2C3 Master and Slave
+    SPIMaster_SSI2_Interrupt,               // SSI2 Rx and Tx
+    SPIMaster_SSI3_Interrupt,               // SSI3 Rx and Tx
+    SerialPort_UART3_Interrupt,             // UART3 Rx and Tx
+    SerialPort_UART4_Interrupt,             // UART4 Rx and Tx
+    SerialPort_UART5_Interrupt,             // UART5 Rx and Tx
+    SerialPort_UART6_Interrupt,             // UART6 Rx and Tx
+    SerialPort_UART7_Interrupt,             // UART7 Rx and Tx
+    I2CMaster_I2C2_Interrupt,               // I2C2 Master and Slave
+    I2CMaster_I2C3_Interrupt,               // I2C3 Master and Slave
     IntDefaultHandler,                      // Timer 4 subtimer A
     IntDefaultHandler,                      // Timer 4 subtimer B
     IntDefaultHandler,                      // Timer 5 subtimer A
@@ -157,8 +181,8 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // FPU
     0,                                      // Reserved
     0,                                      // Reserved
-    IntDefaultHandler,                      // I2C4 Master and Slave
-    IntDefaultHandler,                      // I2C5 Master and Slave
+    I2CMaster_I2C4_Interrupt,               // I2C4 Master and Slave
+    I2CMaster_I2C5_Interrupt,               // I2C5 Master and Slave
     IntDefaultHandler,                      // GPIO Port M
     IntDefaultHandler,                      // GPIO Port N
     0,                                      // Reserved
@@ -189,15 +213,15 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Timer 6 subtimer B
     IntDefaultHandler,                      // Timer 7 subtimer A
     IntDefaultHandler,                      // Timer 7 subtimer B
-    IntDefaultHandler,                      // I2C6 Master and Slave
-    IntDefaultHandler,                      // I2C7 Master and Slave
+    I2CMaster_I2C6_Interrupt,               // I2C6 Master and Slave
+    I2CMaster_I2C7_Interrupt,               // I2C7 Master and Slave
     IntDefaultHandler,                      // HIM Scan Matrix Keyboard 0
     IntDefaultHandler,                      // One Wire 0
     IntDefaultHandler,                      // HIM PS/2 0
     IntDefaultHandler,                      // HIM LED Sequencer 0
     IntDefaultHandler,                      // HIM Consumer IR 0
-    IntDefaultHandler,                      // I2C8 Master and Slave
-    IntDefaultHandler,                      // I2C9 Master and Slave
+    I2CMaster_I2C8_Interrupt,               // I2C8 Master and Slave
+    I2CMaster_I2C9_Interrupt,               // I2C9 Master and Slave
     IntDefaultHandler,                      // GPIO Port T
     IntDefaultHandler,                      // Fan 1
     0,                                      // Reserved